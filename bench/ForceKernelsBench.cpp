@@ -0,0 +1,199 @@
+/**
+*  ForceKernelsBench.cpp
+*  Projekt 3DVisual
+*
+*  Microbenchmark of scalar and vectorized layout force kernels on synthetic graphs.
+*
+*  Pouzitie: ForceKernelsBench [pocet uzlov ...]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <ctime>
+#include <climits>
+#include <vector>
+
+#include "Layout/ForceKernels.h"
+
+using Layout::ForceKernels;
+
+namespace
+{
+	/* pocet odpudzovanych uzlov, pri velkych grafoch sa meria len cast riadkov */
+	const int ROWS = 2000;
+
+	/* pocet hran na uzol */
+	const int EDGES_PER_NODE = 3;
+
+	/* minimalny cas merania jedneho kernelu v sekundach */
+	const double MIN_TIME = 0.3;
+
+	unsigned int state = 1;
+
+	float nextRandom()
+	{
+		state = state * 1103515245u + 12345u;
+		return (float) ((state >> 8) & 0xffff) / 65535.0f;
+	}
+
+	struct Graph
+	{
+		std::vector<float> x, y, z;
+		std::vector<int> src, dst;
+	};
+
+	/* nahodne rozmiestnene uzly v gule s polomerom 300 a nahodne hrany */
+	void generate(int count, Graph &graph)
+	{
+		state = 1;
+		graph.x.resize(count);
+		graph.y.resize(count);
+		graph.z.resize(count);
+		for (int i = 0; i < count; i++)
+		{
+			float x, y, z;
+			do
+			{
+				x = nextRandom() * 2 - 1;
+				y = nextRandom() * 2 - 1;
+				z = nextRandom() * 2 - 1;
+			} while (x * x + y * y + z * z > 1);
+			graph.x[i] = x * 300;
+			graph.y[i] = y * 300;
+			graph.z[i] = z * 300;
+		}
+		graph.src.resize(count * EDGES_PER_NODE);
+		graph.dst.resize(count * EDGES_PER_NODE);
+		for (int i = 0; i < count * EDGES_PER_NODE; i++)
+		{
+			graph.src[i] = i / EDGES_PER_NODE;
+			graph.dst[i] = (int) (nextRandom() * (count - 1));
+		}
+	}
+
+	void usage()
+	{
+		fprintf(stderr, "Pouzitie: ForceKernelsBench [pocet uzlov ...]\n");
+		fprintf(stderr, "  pocet uzlov  kladne cele cislo, predvolene 1000 10000 100000\n");
+	}
+
+	/* precita kladny pocet uzlov, pri ktorom sa pocet hran zmesti do int */
+	bool parseCount(const char *text, int &count)
+	{
+		char *end;
+		long value = strtol(text, &end, 10);
+		if (end == text || *end != '\0' || value <= 0 || value > INT_MAX / EDGES_PER_NODE)
+			return false;
+		count = (int) value;
+		return true;
+	}
+
+	double seconds(clock_t begin, clock_t end)
+	{
+		return (double) (end - begin) / CLOCKS_PER_SEC;
+	}
+
+	/* vrati cas jednej dvojice v nanosekundach a sucet sil pre porovnanie urovni */
+	double repulsive(const Graph &graph, double &checksum)
+	{
+		int count = (int) graph.x.size();
+		int rows = count < ROWS ? count : ROWS;
+		long long pairs = 0;
+		clock_t begin = clock();
+		clock_t end;
+		do
+		{
+			checksum = 0;
+			for (int i = 0; i < rows; i++)
+			{
+				float fx = 0, fy = 0, fz = 0;
+				ForceKernels::repulsive(graph.x[i], graph.y[i], graph.z[i], &graph.x[0], &graph.y[0], &graph.z[0],
+					0, count, 100.0f, 1e30f, fx, fy, fz);
+				checksum += fabs(fx) + fabs(fy) + fabs(fz);
+			}
+			pairs += (long long) rows * count;
+			end = clock();
+		} while (seconds(begin, end) < MIN_TIME);
+		return seconds(begin, end) * 1e9 / pairs;
+	}
+
+	/* vrati cas jednej hrany v nanosekundach a sucet sil pre porovnanie urovni */
+	double attractive(const Graph &graph, double &checksum)
+	{
+		int count = (int) graph.src.size();
+		std::vector<float> fx(count), fy(count), fz(count);
+		long long edges = 0;
+		clock_t begin = clock();
+		clock_t end;
+		do
+		{
+			ForceKernels::attractive(&graph.src[0], &graph.dst[0], count, &graph.x[0], &graph.y[0], &graph.z[0],
+				0.1f, &fx[0], &fy[0], &fz[0]);
+			edges += count;
+			end = clock();
+		} while (seconds(begin, end) < MIN_TIME);
+
+		checksum = 0;
+		for (int i = 0; i < count; i++)
+		{
+			checksum += fabs(fx[i]) + fabs(fy[i]) + fabs(fz[i]);
+		}
+		return seconds(begin, end) * 1e9 / edges;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	std::vector<int> sizes;
+	for (int i = 1; i < argc; i++)
+	{
+		int count;
+		if (!parseCount(argv[i], count))
+		{
+			usage();
+			return 2;
+		}
+		sizes.push_back(count);
+	}
+	if (sizes.empty())
+	{
+		sizes.push_back(1000);
+		sizes.push_back(10000);
+		sizes.push_back(100000);
+	}
+
+	ForceKernels::Level supported = ForceKernels::getSupportedLevel();
+	printf("supported level: %s\n", ForceKernels::getLevelName(supported));
+	printf("%8s %8s %16s %10s %16s %10s %12s\n", "nodes", "level", "repulsive ns/pair", "speedup", "attractive ns/edge", "speedup", "rel. error");
+
+	for (size_t s = 0; s < sizes.size(); s++)
+	{
+		Graph graph;
+		generate(sizes[s], graph);
+
+		double repulsiveBase = 0, attractiveBase = 0;
+		double repulsiveSum = 0, attractiveSum = 0;
+		for (int level = ForceKernels::SCALAR; level <= supported; level++)
+		{
+			ForceKernels::setLevel((ForceKernels::Level) level);
+			double repulsiveCheck, attractiveCheck;
+			double repulsiveTime = repulsive(graph, repulsiveCheck);
+			double attractiveTime = attractive(graph, attractiveCheck);
+			if (level == ForceKernels::SCALAR)
+			{
+				repulsiveBase = repulsiveTime;
+				attractiveBase = attractiveTime;
+				repulsiveSum = repulsiveCheck;
+				attractiveSum = attractiveCheck;
+			}
+			double error = fabs(repulsiveCheck - repulsiveSum) / repulsiveSum;
+			double attractiveError = fabs(attractiveCheck - attractiveSum) / attractiveSum;
+			if (attractiveError > error)
+				error = attractiveError;
+
+			printf("%8d %8s %16.3f %9.2fx %16.3f %9.2fx %12.2e\n", sizes[s], ForceKernels::getLevelName((ForceKernels::Level) level),
+				repulsiveTime, repulsiveBase / repulsiveTime, attractiveTime, attractiveBase / attractiveTime, error);
+		}
+	}
+	return 0;
+}
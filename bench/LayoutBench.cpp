@@ -0,0 +1,334 @@
+/**
+*  LayoutBench.cpp
+*  Projekt 3DVisual
+*
+*  Benchmark of layout engines on generated graph families. For every family, size and engine it measures time of
+*  iteration, count of iterations to convergence and normalized stress of the final layout, results are written as JSON.
+*  Engines fr, multilevel and spectral differ only in initial placement, so their iterations compare convergence
+*  from random, multilevel and spectral placement.
+*
+*  Pouzitie: LayoutBench [--families cylinder,grid,tree,erdos-renyi,barabasi-albert] [--sizes 100,1000,...]
+*                        [--engines fr,multilevel,spectral,pivotmds-fr,pivotmds,cone,auto,igraph] [--max-iterations N] [--max-time S] [--output subor.json]
+*
+*  Predvolene velkosti siahaju po milion uzlov, enginy s kvadratickou iteraciou (FR s presnym odpudzovanim, igraph)
+*  vsak dostanu len grafy do QUADRATIC_MAX_COUNT uzlov, FR s oktalovym stromom alebo mriezkou do APPROXIMATE_MAX_COUNT.
+*  Velkosti zadane cez --sizes sa pouziju pre vsetky enginy.
+*
+*  Nastavenia sa citaju z config/config v aktualnom adresari.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <vector>
+#include <algorithm>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QHash>
+#include <QStringList>
+
+#include "Data/Graph.h"
+#include "Layout/LayoutEngine.h"
+#include "Layout/ForceKernels.h"
+#include "Layout/WorkerPool.h"
+#include "Viewer/DataHelper.h"
+#include "Util/ApplicationConfig.h"
+
+namespace
+{
+	/* parametre layoutu, rovnake ako v AppCore::Core::restartLayout */
+	const float SIZE_FACTOR = 10;
+	const float FLEXIBILITY = 0.7f;
+
+	/* pocet zdrojov prehladavania do sirky pri vypocte stresu */
+	const int STRESS_PIVOTS = 16;
+
+	/* parametre rodin grafov */
+	const int TREE_BRANCHING = 3;
+	const float RANDOM_DEGREE = 4;
+	const int SCALE_FREE_EDGES = 2;
+	const unsigned int SEED = 1;
+
+	/* najvacsie grafy predvolenych velkosti, iteracia exaktneho FR na milione uzlov trva minuty a limit casu
+	   sa kontroluje az po nej */
+	const int QUADRATIC_MAX_COUNT = 10000;
+	const int APPROXIMATE_MAX_COUNT = 100000;
+
+	struct Result
+	{
+		QString family;
+		QString engine;
+		int nodes;
+		int edges;
+		double buildMs;
+		int iterations;
+		bool converged;
+		double nsPerIteration;
+		double totalMs;
+		double stress;
+	};
+
+	QStringList split(const char *list)
+	{
+		return QString(list).split(",", QString::SkipEmptyParts);
+	}
+
+	const QStringList FAMILIES = split("cylinder,grid,tree,erdos-renyi,barabasi-albert");
+
+	/* najvacsi pocet uzlov predvolenych velkosti pre engine */
+	int defaultMaxCount(const QString &engine)
+	{
+		if (engine == "pivotmds" || engine == "cone")
+			return INT_MAX;
+		if (engine == "igraph")
+			return QUADRATIC_MAX_COUNT;
+		QString mode = Util::ApplicationConfig::get()->getValue("Layout.FR.RepulsionMode");
+		return mode == "barneshut" || mode == "grid" ? APPROXIMATE_MAX_COUNT : QUADRATIC_MAX_COUNT;
+	}
+
+	/* vygeneruje graf z rodiny s priblizne count uzlami */
+	bool generate(const QString &family, int count, Data::Graph *graph)
+	{
+		int side = std::max(1, (int) ceil(sqrt((double) count)));
+		if (family == "cylinder")
+			Vwr::DataHelper::generateCylinder(graph, side, std::max(1, count / side));
+		else if (family == "grid")
+			Vwr::DataHelper::generateGrid(graph, side, std::max(1, count / side));
+		else if (family == "tree")
+			Vwr::DataHelper::generateTree(graph, count, TREE_BRANCHING);
+		else if (family == "erdos-renyi")
+			Vwr::DataHelper::generateErdosRenyi(graph, count, RANDOM_DEGREE, SEED);
+		else if (family == "barabasi-albert")
+			Vwr::DataHelper::generateBarabasiAlbert(graph, count, SCALE_FREE_EDGES, SEED);
+		else
+			return false;
+		return true;
+	}
+
+	/*
+	*	Normalizovany stres: pre dvojice (pivot, uzol) porovna vzdialenost v rozmiestneni so vzdialenostou v grafe.
+	*	Pri optimalnej mierke s = priemer(|xi - xj| / dij) je stres = priemer((|xi - xj| / dij - s)^2) / s^2,
+	*	0 znamena, ze vzdialenosti v priestore su umerne vzdialenostiam v grafe.
+	*/
+	double stress(Data::Graph *graph)
+	{
+		QHash<qlonglong, int> index;
+		std::vector<osg::Vec3f> positions;
+		const Data::Graph::NodeStore &nodes = graph->getNodeStore();
+		for (int n = 0; n < nodes.size(); n++)
+		{
+			index.insert(nodes.at(n)->getId(), (int) positions.size());
+			positions.push_back(nodes.at(n)->getTargetPosition());
+		}
+		int count = (int) positions.size();
+		std::vector<std::vector<int> > neighbours(count);
+		const Data::Graph::EdgeStore &edges = graph->getEdgeStore();
+		for (int e = 0; e < edges.size(); e++)
+		{
+			int u = index.value(edges.at(e)->getSrcNode()->getId(), -1);
+			int v = index.value(edges.at(e)->getDstNode()->getId(), -1);
+			if (u == -1 || v == -1 || u == v)
+				continue;
+			neighbours[u].push_back(v);
+			neighbours[v].push_back(u);
+		}
+		if (count < 2)
+			return 0;
+
+		std::vector<double> ratios;
+		std::vector<int> distance(count);
+		std::vector<int> queue(count);
+		int pivots = std::min(count, STRESS_PIVOTS);
+		for (int p = 0; p < pivots; p++)
+		{
+			int source = (int) ((long long) p * count / pivots);
+			distance.assign(count, -1);
+			distance[source] = 0;
+			int head = 0, tail = 0;
+			queue[tail++] = source;
+			while (head < tail)
+			{
+				int u = queue[head++];
+				for (size_t k = 0; k < neighbours[u].size(); k++)
+				{
+					int v = neighbours[u][k];
+					if (distance[v] == -1)
+					{
+						distance[v] = distance[u] + 1;
+						queue[tail++] = v;
+						ratios.push_back((positions[v] - positions[source]).length() / distance[v]);
+					}
+				}
+			}
+		}
+		if (ratios.empty())
+			return 0;
+		double mean = 0;
+		for (size_t k = 0; k < ratios.size(); k++)
+			mean += ratios[k];
+		mean /= ratios.size();
+		if (mean <= 0)
+			return 0;
+		double sum = 0;
+		for (size_t k = 0; k < ratios.size(); k++)
+			sum += (ratios[k] - mean) * (ratios[k] - mean);
+		return sum / ratios.size() / (mean * mean);
+	}
+
+	Result run(const QString &family, int count, const QString &engine, int maxIterations, double maxSeconds)
+	{
+		Result result;
+		result.family = family;
+		result.engine = engine;
+
+		QElapsedTimer timer;
+		timer.start();
+		Data::Graph *graph = new Data::Graph(1, family, 0, 0, NULL);
+		generate(family, count, graph);
+		result.buildMs = timer.nsecsElapsed() / 1e6;
+		result.nodes = graph->getNodeStore().size();
+		result.edges = graph->getEdgeStore().size();
+
+		{
+			Layout::LayoutEngine *alg = Layout::LayoutEngine::create(Layout::LayoutEngine::resolve(engine, graph));
+			alg->SetGraph(graph);
+			alg->SetParameters(SIZE_FACTOR, FLEXIBILITY, 1, true);
+
+			result.iterations = 0;
+			result.converged = false;
+			timer.restart();
+			while (maxIterations <= 0 || result.iterations < maxIterations)
+			{
+				result.iterations++;
+				if (!alg->Step())
+				{
+					result.converged = true;
+					break;
+				}
+				if (timer.nsecsElapsed() / 1e9 >= maxSeconds)
+					break;
+			}
+			qint64 elapsed = timer.nsecsElapsed();
+			result.totalMs = elapsed / 1e6;
+			result.nsPerIteration = result.iterations > 0 ? (double) elapsed / result.iterations : 0;
+			alg->ApplyPositions();
+			result.stress = stress(graph);
+			delete alg;
+		}
+		delete graph;
+		return result;
+	}
+
+	void writeJson(FILE *out, const std::vector<Result> &results, int maxIterations, double maxSeconds)
+	{
+		fprintf(out, "{\n");
+		fprintf(out, "  \"benchmark\": \"layout\",\n");
+		fprintf(out, "  \"date\": \"%s\",\n", qPrintable(QDateTime::currentDateTime().toString(Qt::ISODate)));
+		fprintf(out, "  \"kernels\": \"%s\",\n", Layout::ForceKernels::getLevelName(Layout::ForceKernels::getLevel()));
+		fprintf(out, "  \"threads\": %d,\n", Layout::WorkerPool(Util::ApplicationConfig::get()->getValue("Layout.FR.ThreadCount").toInt()).getThreadCount());
+		fprintf(out, "  \"repulsion\": \"%s\",\n", qPrintable(Util::ApplicationConfig::get()->getValue("Layout.FR.RepulsionMode")));
+		fprintf(out, "  \"max_iterations\": %d,\n", maxIterations);
+		fprintf(out, "  \"max_seconds\": %g,\n", maxSeconds);
+		fprintf(out, "  \"results\": [\n");
+		for (size_t k = 0; k < results.size(); k++)
+		{
+			const Result &r = results[k];
+			fprintf(out, "    {\"family\": \"%s\", \"engine\": \"%s\", \"nodes\": %d, \"edges\": %d, \"build_ms\": %.3f, "
+				"\"iterations\": %d, \"converged\": %s, \"ns_per_iteration\": %.0f, \"total_ms\": %.3f, \"stress\": %.6f}%s\n",
+				qPrintable(r.family), qPrintable(r.engine), r.nodes, r.edges, r.buildMs, r.iterations, r.converged ? "true" : "false",
+				r.nsPerIteration, r.totalMs, r.stress, k + 1 < results.size() ? "," : "");
+		}
+		fprintf(out, "  ]\n");
+		fprintf(out, "}\n");
+	}
+}
+
+int main(int argc, char **argv)
+{
+	QCoreApplication app(argc, argv);
+
+	QStringList families = FAMILIES;
+	QStringList sizes = split("100,1000,10000,100000,1000000");
+	bool defaultSizes = true;
+	QStringList engines = split("fr,multilevel,spectral,pivotmds,cone");
+	int maxIterations = 2000;
+	double maxSeconds = 60;
+	const char *output = NULL;
+	for (int i = 1; i < argc; i++)
+	{
+		if (i + 1 >= argc)
+		{
+			fprintf(stderr, "chyba hodnota parametra %s\n", argv[i]);
+			return 2;
+		}
+		if (strcmp(argv[i], "--families") == 0)
+			families = split(argv[++i]);
+		else if (strcmp(argv[i], "--sizes") == 0)
+		{
+			sizes = split(argv[++i]);
+			defaultSizes = false;
+		}
+		else if (strcmp(argv[i], "--engines") == 0)
+			engines = split(argv[++i]);
+		else if (strcmp(argv[i], "--max-iterations") == 0)
+			maxIterations = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--max-time") == 0)
+			maxSeconds = atof(argv[++i]);
+		else if (strcmp(argv[i], "--output") == 0)
+			output = argv[++i];
+		else
+		{
+			fprintf(stderr, "neznamy parameter %s\n", argv[i]);
+			return 2;
+		}
+	}
+
+	for (int f = 0; f < families.count(); f++)
+	{
+		if (!FAMILIES.contains(families[f]))
+		{
+			fprintf(stderr, "neznama rodina grafov %s\n", qPrintable(families[f]));
+			return 2;
+		}
+	}
+	for (int e = 0; e < engines.count(); e++)
+	{
+		if (!Layout::LayoutEngine::getNames().contains(engines[e]))
+		{
+			fprintf(stderr, "neznamy engine %s\n", qPrintable(engines[e]));
+			return 2;
+		}
+	}
+
+	std::vector<Result> results;
+	for (int f = 0; f < families.count(); f++)
+	{
+		for (int s = 0; s < sizes.count(); s++)
+		{
+			for (int e = 0; e < engines.count(); e++)
+			{
+				if (defaultSizes && sizes[s].toInt() > defaultMaxCount(engines[e]))
+					continue;
+				Result r = run(families[f], sizes[s].toInt(), engines[e], maxIterations, maxSeconds);
+				// priebeh na chybovy vystup, JSON moze ist na standardny vystup
+				fprintf(stderr, "%-16s %-10s %8d uzlov %8d hran %6d iteracii %12.0f ns/iteracia stres %.4f\n", qPrintable(r.family),
+					qPrintable(r.engine), r.nodes, r.edges, r.iterations, r.nsPerIteration, r.stress);
+				results.push_back(r);
+			}
+		}
+	}
+
+	FILE *out = output != NULL ? fopen(output, "w") : stdout;
+	if (out == NULL)
+	{
+		fprintf(stderr, "nepodarilo sa otvorit %s\n", output);
+		return 1;
+	}
+	writeJson(out, results, maxIterations, maxSeconds);
+	if (out != stdout)
+		fclose(out);
+	return 0;
+}
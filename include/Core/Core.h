@@ -11,7 +11,7 @@
 
 #include "Model/DB.h"
 #include "Data/Graph.h"
-#include "Layout/FRAlgorithm.h"
+#include "Layout/LayoutEngine.h"
 #include "Layout/LayoutThread.h"
 #include "QOSG/CoreWindow.h"
 #include "Viewer/CoreGraph.h"
@@ -83,10 +83,10 @@ namespace AppCore
        Core(QApplication * app);
 
         /**
-        *  Layout::FRAlgorithm * alg
-        *  \brief instance of layout algorithm.
+        *  Layout::LayoutEngine * alg
+        *  \brief instance of layout engine chosen by Layout.Engine
         */
-        Layout::FRAlgorithm * alg;
+        Layout::LayoutEngine * alg;
 
 
         /**
@@ -0,0 +1,210 @@
+/*!
+ * Adjacency.h
+ * Projekt 3DVisual
+ */
+#ifndef DATA_ADJACENCY_DEF
+#define DATA_ADJACENCY_DEF 1
+
+#include <vector>
+#include <QHash>
+
+namespace Data
+{
+	class Graph;
+	class Node;
+	class Edge;
+
+	/**
+	*  \class Adjacency
+	*  \brief Compressed sparse row index of neighbours of all Nodes of Graph
+	*
+	*	Nodes have indices 0..getCount()-1, Nodes are before meta-Nodes. Edges have indices 0..getEdgeCount()-1,
+	*	Edges are before meta-Edges. Outgoing neighbours of node i are outNeighbours[outOffsets[i]..outOffsets[i+1]),
+	*	edge leading to neighbour is on the same position in outEdges, incoming neighbours are stored the same way.
+	*	Index is built from Graph::getAdjacency, which rebuilds it after every change of topology of Graph.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class Adjacency
+	{
+	public:
+
+		/**
+		*  \fn public constructor  Adjacency
+		*  \brief Creates empty index which is older than every Graph
+		*/
+		Adjacency();
+
+		/**
+		*  \fn public  build(Data::Graph *graph)
+		*  \brief Rebuilds index from dense stores of Graph, Edges with Node outside Graph are skipped
+		*  \param  graph  indexed Graph
+		*/
+		void build(Data::Graph *graph);
+
+		/**
+		*  \fn inline public constant  getVersion
+		*  \return qlonglong topology version of Graph at the time of build, -1 for empty index
+		*/
+		qlonglong getVersion() const { return version; }
+
+		/**
+		*  \fn inline public constant  getCount
+		*  \return int count of Nodes and meta-Nodes
+		*/
+		int getCount() const { return (int) nodes.size(); }
+
+		/**
+		*  \fn inline public constant  getNodeCount
+		*  \return int count of Nodes, meta-Nodes have indices from this count
+		*/
+		int getNodeCount() const { return nodeCount; }
+
+		/**
+		*  \fn inline public constant  getEdgeCount
+		*  \return int count of Edges and meta-Edges
+		*/
+		int getEdgeCount() const { return (int) edges.size(); }
+
+		/**
+		*  \fn inline public constant  getPlainEdgeCount
+		*  \return int count of Edges, meta-Edges have indices from this count
+		*/
+		int getPlainEdgeCount() const { return plainEdgeCount; }
+
+		/**
+		*  \fn inline public constant  indexOf(qlonglong id)
+		*  \param  id  ID of Node
+		*  \return int index of Node or -1
+		*/
+		int indexOf(qlonglong id) const { return index.value(id, -1); }
+
+		/**
+		*  \fn inline public constant  getNode(int i)
+		*  \param  i  index of Node
+		*  \return Data::Node * Node of index
+		*/
+		Data::Node *getNode(int i) const { return nodes[i]; }
+
+		/**
+		*  \fn inline public constant  getEdge(int e)
+		*  \param  e  index of Edge
+		*  \return Data::Edge * Edge of index
+		*/
+		Data::Edge *getEdge(int e) const { return edges[e]; }
+
+		/**
+		*  \fn inline public constant  getOutDegree(int i)
+		*  \param  i  index of Node
+		*  \return int count of Edges starting in Node
+		*/
+		int getOutDegree(int i) const { return outOffsets[i + 1] - outOffsets[i]; }
+
+		/**
+		*  \fn inline public constant  getInDegree(int i)
+		*  \param  i  index of Node
+		*  \return int count of Edges ending in Node
+		*/
+		int getInDegree(int i) const { return inOffsets[i + 1] - inOffsets[i]; }
+
+		/**
+		*  std::vector<int> edgeSrc
+		*  \brief index of starting Node of every Edge
+		*/
+		std::vector<int> edgeSrc;
+
+		/**
+		*  std::vector<int> edgeDst
+		*  \brief index of ending Node of every Edge
+		*/
+		std::vector<int> edgeDst;
+
+		/**
+		*  std::vector<int> outOffsets
+		*  \brief start of outgoing neighbours of every Node, the last item is count of Edges
+		*/
+		std::vector<int> outOffsets;
+
+		/**
+		*  std::vector<int> outNeighbours
+		*  \brief ending Nodes of outgoing Edges
+		*/
+		std::vector<int> outNeighbours;
+
+		/**
+		*  std::vector<int> outEdges
+		*  \brief indices of outgoing Edges
+		*/
+		std::vector<int> outEdges;
+
+		/**
+		*  std::vector<int> inOffsets
+		*  \brief start of incoming neighbours of every Node, the last item is count of Edges
+		*/
+		std::vector<int> inOffsets;
+
+		/**
+		*  std::vector<int> inNeighbours
+		*  \brief starting Nodes of incoming Edges
+		*/
+		std::vector<int> inNeighbours;
+
+		/**
+		*  std::vector<int> inEdges
+		*  \brief indices of incoming Edges
+		*/
+		std::vector<int> inEdges;
+
+	private:
+
+		/**
+		*  qlonglong version
+		*  \brief topology version of Graph at the time of build
+		*/
+		qlonglong version;
+
+		/**
+		*  int nodeCount
+		*  \brief count of Nodes without meta-Nodes
+		*/
+		int nodeCount;
+
+		/**
+		*  int plainEdgeCount
+		*  \brief count of Edges without meta-Edges
+		*/
+		int plainEdgeCount;
+
+		/**
+		*  std::vector<Data::Node *> nodes
+		*  \brief Nodes by their index
+		*/
+		std::vector<Data::Node *> nodes;
+
+		/**
+		*  std::vector<Data::Edge *> edges
+		*  \brief Edges by their index
+		*/
+		std::vector<Data::Edge *> edges;
+
+		/**
+		*  QHash<qlonglong,int> index
+		*  \brief indices of Nodes by their ID
+		*/
+		QHash<qlonglong, int> index;
+
+		/**
+		*  \fn private static  fill(int count, const std::vector<int> &from, const std::vector<int> &to, std::vector<int> &offsets, std::vector<int> &neighbours, std::vector<int> &edgeIndices)
+		*  \brief Counting sort of Edges by their node from
+		*  \param  count  count of Nodes
+		*  \param  from  node by which Edges are grouped
+		*  \param  to  neighbour of node
+		*  \param  offsets  start of every group
+		*  \param  neighbours  neighbours in groups
+		*  \param  edgeIndices  Edges in groups
+		*/
+		static void fill(int count, const std::vector<int> &from, const std::vector<int> &to, std::vector<int> &offsets, std::vector<int> &neighbours, std::vector<int> &edgeIndices);
+	};
+}
+
+#endif
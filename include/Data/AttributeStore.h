@@ -0,0 +1,260 @@
+/*!
+ * AttributeStore.h
+ * Projekt 3DVisual
+ */
+#ifndef DATA_ATTRIBUTESTORE_DEF
+#define DATA_ATTRIBUTESTORE_DEF 1
+
+#include <vector>
+#include <QHash>
+#include <QString>
+
+namespace Data
+{
+	/**
+	*  \class AttributeStore
+	*  \brief Columnar store of attributes of nodes or edges of one Graph
+	*
+	*	Every attribute (GraphML key) is one typed column, value of element is in the row of the element.
+	*	String values are interned in dictionary of the column, column keeps only their codes. Missing and invalid
+	*	values are marked in null bitmap of the column. Removal of element moves the last row into its place.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class AttributeStore
+	{
+	public:
+
+		/**
+		*  \enum Type
+		*  \brief Type of values of column
+		*/
+		enum Type
+		{
+			STRING,
+			INTEGER,
+			REAL,
+			BOOLEAN
+		};
+
+		/**
+		*  \struct Column
+		*  \brief Values of one attribute of all rows
+		*/
+		struct Column
+		{
+			/**
+			*  QString key
+			*  \brief identifier of attribute, GraphML key id
+			*/
+			QString key;
+
+			/**
+			*  QString name
+			*  \brief readable name of attribute, GraphML attr.name
+			*/
+			QString name;
+
+			/**
+			*  Type type
+			*  \brief type of values
+			*/
+			Type type;
+
+			/**
+			*  QString defaultValue
+			*  \brief value of new rows, new rows are null if it is empty
+			*/
+			QString defaultValue;
+
+			/**
+			*  std::vector<qint64> integers
+			*  \brief values of INTEGER and BOOLEAN column, codes of dictionary of STRING column
+			*/
+			std::vector<qint64> integers;
+
+			/**
+			*  std::vector<double> reals
+			*  \brief values of REAL column
+			*/
+			std::vector<double> reals;
+
+			/**
+			*  std::vector<quint32> nulls
+			*  \brief bitmap of rows without value
+			*/
+			std::vector<quint32> nulls;
+
+			/**
+			*  std::vector<QString> dictionary
+			*  \brief distinct strings of STRING column by their code
+			*/
+			std::vector<QString> dictionary;
+
+			/**
+			*  QHash<QString,int> codes
+			*  \brief codes of strings of dictionary
+			*/
+			QHash<QString, int> codes;
+
+			/**
+			*  \fn inline public constant  isNull(int row)
+			*  \param  row  row of element
+			*  \return bool true, if row has no value
+			*/
+			bool isNull(int row) const { return (nulls[row >> 5] >> (row & 31)) & 1; }
+		};
+
+		/**
+		*  \fn public static  parseType(const QString &graphMLType)
+		*  \brief Returns type of column of GraphML attr.type
+		*  \param  graphMLType  boolean, int, long, float, double or string
+		*  \return Type type of column, unknown types are STRING
+		*/
+		static Type parseType(const QString &graphMLType);
+
+		/**
+		*  \fn public  addColumn(const QString &key, const QString &name, Type type, const QString &defaultValue = QString())
+		*  \brief Adds column, existing rows are set to default value
+		*  \param  key  identifier of attribute
+		*  \param  name  readable name of attribute
+		*  \param  type  type of values
+		*  \param  defaultValue  value of rows without value
+		*  \return int index of column, index of existing column with the same key
+		*/
+		int addColumn(const QString &key, const QString &name, Type type, const QString &defaultValue = QString());
+
+		/**
+		*  \fn inline public constant  getColumnIndex(const QString &key)
+		*  \param  key  identifier of attribute
+		*  \return int index of column or -1
+		*/
+		int getColumnIndex(const QString &key) const { return columnIndex.value(key, -1); }
+
+		/**
+		*  \fn inline public constant  getColumnCount
+		*  \return int count of columns
+		*/
+		int getColumnCount() const { return (int) columns.size(); }
+
+		/**
+		*  \fn inline public constant  getColumn(int column)
+		*  \param  column  index of column
+		*  \return const Column & column for scanning of all rows
+		*/
+		const Column &getColumn(int column) const { return columns[column]; }
+
+		/**
+		*  \fn public  addRow(qlonglong id)
+		*  \brief Adds row of element with default values
+		*  \param  id  ID of element
+		*  \return int row of element, existing row if element already has one
+		*/
+		int addRow(qlonglong id);
+
+		/**
+		*  \fn public  removeRow(qlonglong id)
+		*  \brief Removes row of element, the last row takes its place
+		*  \param  id  ID of element
+		*/
+		void removeRow(qlonglong id);
+
+		/**
+		*  \fn inline public constant  getRow(qlonglong id)
+		*  \param  id  ID of element
+		*  \return int row of element or -1
+		*/
+		int getRow(qlonglong id) const { return rowIndex.value(id, -1); }
+
+		/**
+		*  \fn inline public constant  getRowCount
+		*  \return int count of rows
+		*/
+		int getRowCount() const { return (int) ids.size(); }
+
+		/**
+		*  \fn inline public constant  getId(int row)
+		*  \param  row  row of element
+		*  \return qlonglong ID of element of row
+		*/
+		qlonglong getId(int row) const { return ids[row]; }
+
+		/**
+		*  \fn public  setValue(int column, int row, const QString &text)
+		*  \brief Parses text by type of column and stores it
+		*  \param  column  index of column
+		*  \param  row  row of element
+		*  \param  text  value as text
+		*  \return bool true, if text was valid value, otherwise row is null
+		*/
+		bool setValue(int column, int row, const QString &text);
+
+		/**
+		*  \fn public  setNull(int column, int row)
+		*  \brief Removes value of row
+		*  \param  column  index of column
+		*  \param  row  row of element
+		*/
+		void setNull(int column, int row);
+
+		/**
+		*  \fn public constant  getValue(int column, int row)
+		*  \brief Returns value of row as text
+		*  \param  column  index of column
+		*  \param  row  row of element
+		*  \return QString value, null QString if row has no value
+		*/
+		QString getValue(int column, int row) const;
+
+		/**
+		*  \fn public  clear
+		*  \brief Removes all columns and rows
+		*/
+		void clear();
+
+	private:
+
+		/**
+		*  std::vector<Column> columns
+		*  \brief columns by their index
+		*/
+		std::vector<Column> columns;
+
+		/**
+		*  QHash<QString,int> columnIndex
+		*  \brief indices of columns by their key
+		*/
+		QHash<QString, int> columnIndex;
+
+		/**
+		*  std::vector<qlonglong> ids
+		*  \brief ID of element of every row
+		*/
+		std::vector<qlonglong> ids;
+
+		/**
+		*  QHash<qlonglong,int> rowIndex
+		*  \brief rows of elements by their ID
+		*/
+		QHash<qlonglong, int> rowIndex;
+
+		/**
+		*  \fn private  resizeColumn(Column &column, int rows)
+		*  \brief Changes count of rows of column, new rows are null
+		*  \param  column  resized column
+		*  \param  rows  count of rows
+		*/
+		void resizeColumn(Column &column, int rows);
+
+		/**
+		*  \fn private  copyRow(Column &column, int from, int to)
+		*  \brief Copies value and null flag of row
+		*  \param  column  column
+		*  \param  from  source row
+		*  \param  to  target row
+		*/
+		void copyRow(Column &column, int from, int to);
+	};
+}
+
+#endif
@@ -13,12 +13,8 @@
 #include <QTextStream>
 #include <QtCore/QMap>
 
-#include <osg/PrimitiveSet>
-#include <osg/Camera>
-#include <osgText/Text>
-#include <osgText/FadeText>
-
-#include "Util/ApplicationConfig.h"
+#include <osg/Referenced>
+#include <osg/Vec4>
 
 namespace Data
 {
@@ -26,18 +22,40 @@ namespace Data
 	class Graph;
 	class Type;
 
+	/**
+	*  \class EdgeView
+	*  \brief Drawable representation of an Edge, implemented by the viewer
+	*
+	*  \date 18. 10. 2026
+	*/
+	class EdgeView
+	{
+	public:
+
+		virtual ~EdgeView() {}
+
+		/**
+		*  \fn public virtual  detach
+		*  \brief Unlinks the view from the destroyed edge
+		*/
+		virtual void detach() = 0;
+	};
+
 	/**
 	*  \class Edge
 	*  \brief Object represents an edge in a Graph.
+	*
+	*	Edge holds only data of the edge, its primitive set is in EdgeView created by the viewer.
+	*
 	*  \author Aurel Paulovic, Michal Paprcka
 	*  \date 29. 4. 2010
 	*/
-	class Edge : public osg::DrawArrays
+	class Edge : public osg::Referenced
 	{
 	public:
 
 		/**
-		* \fn public constructor Edge(qlonglong id, QString name, Data::Graph* graph, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented, int pos = 0, osg::ref_ptr<osg::Camera> camera = 0)
+		* \fn public constructor Edge(qlonglong id, QString name, Data::Graph* graph, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented)
 		* \brief  Creates new Edge object connecting two Nodes
 		*
 		* \param id	ID of the Edge 
@@ -47,10 +65,8 @@ namespace Data
 		* \param dstNode 	ending Node
 		* \param type 		Type of the Edge. 
 		* \param isOriented 		true if the Edge is oriented. 
-		* \param pos int		first coordinate in Drawable coordinates array 
-		* \param camera 	current camera used in viewer
 		*/
-		Edge(qlonglong id, QString name, Data::Graph* graph, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented, int pos = 0, osg::ref_ptr<osg::Camera> camera = 0);
+		Edge(qlonglong id, QString name, Data::Graph* graph, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented);
 
 		/**
 		*  \fn public destructor  ~Edge
@@ -176,13 +192,6 @@ namespace Data
 		}
 
 
-		/**
-		*  \fn inline public constant  getCooridnates
-		*  \brief Returns coordinates of the Edge
-		*  \return osg::ref_ptr coordinates of the Edge
-		*/
-		osg::ref_ptr<osg::Vec3Array> getCooridnates() const { return coordinates; }
-
 		/**
 		*  \fn inline public constant  getLength
 		*  \brief Returns length of the Edge
@@ -191,15 +200,6 @@ namespace Data
 		float getLength() const { return length; }
 
 
-		/**
-		*  \fn public  updateCoordinates(osg::Vec3 srcPos, osg::Vec3 dstNode)
-		*  \brief Updates coordinates of the Edge
-		*  \param    srcPos    new coordinates of the starting Node
-		*  \param   dstNode    new coordinates of the ending Node
-		*/
-		void updateCoordinates(osg::Vec3 srcPos, osg::Vec3 dstNode);
-
-
 		/**
 		*  \fn inline public constant  getEdgeColor
 		*  \brief Returns the color of the Edge
@@ -222,29 +222,6 @@ namespace Data
 		void setEdgeColor(osg::Vec4 val) { edgeColor = val; }
 
 
-		/**
-		*  \fn inline public constant  getEdgeTexCoords
-		*  \brief Returns Texture coordinates array.
-		*  \return osg::ref_ptr<osg::Vec2Array> 
-		*/
-		osg::ref_ptr<osg::Vec2Array> getEdgeTexCoords() const { return edgeTexCoords; }
-
-
-		/**
-		*  \fn inline public constant  getCamera
-		*  \brief returns current camera looking at edge
-		*  \return osg::ref_ptr<osg::Camera> 
-		*/
-		osg::ref_ptr<osg::Camera> getCamera() const { return camera; }
-
-
-		/**
-		*  \fn inline public  setCamera(osg::ref_ptr<osg::Camera> val)
-		*  \brief sets current camera used in viewer.
-		*  \param       val   
-		*/
-		void setCamera(osg::ref_ptr<osg::Camera> val) { camera = val; }
-
 		/**
 		*  \fn inline public constant  isSelected
 		*  \brief Returns selected flag
@@ -265,12 +242,22 @@ namespace Data
 
 
 		/**
-		*  \fn public  createLabel(QString name)
-		*  \brief Creates new label
-		*  \param      name     new label
-		*  \return osg::ref_ptr added label
+		*  \fn inline public  setProxy(T * proxy)
+		*  \brief Attaches primitive set proxy of the Edge, the Edge keeps it
+		*
+		*	EdgeGroup creates the proxy when it draws the Edge.
+		*	Edges used only by layout, analysis or export do not allocate coordinates and labels.
+		*
+		*  \param  proxy  scene graph object implementing EdgeView
 		*/
-		osg::ref_ptr<osg::Drawable> createLabel(QString name);
+		template <class T>
+		void setProxy(T * proxy) { this->proxy = proxy; view = proxy; }
+
+		/**
+		*  \fn inline public constant  getView
+		*  \return Data::EdgeView * view of the Edge, NULL if the Edge is not drawn
+		*/
+		Data::EdgeView * getView() const { return view; }
 
 
 		/**
@@ -375,42 +362,23 @@ namespace Data
 
 
 		/**
-		*  osg::ref_ptr camera
-		*  \brief Current camera used in viewer. It is used for billboarding purposes.
-		*/
-		osg::ref_ptr<osg::Camera> camera;
-
-		/**
-		*  osg::ref_ptr coordinates
-		*  \brief Coordinates of the Edge
-		*/
-		osg::ref_ptr<osg::Vec3Array> coordinates;
-
-		/**
-		*  osg::ref_ptr<osg::Vec2Array> edgeTexCoords
-		*  \brief Texture coordinates array.
-		*/
-		osg::ref_ptr<osg::Vec2Array> edgeTexCoords;
-
-		/**
-		*  osg::ref_ptr label
-		*  \brief Label of the Edge
+		*  osg::Vec4 edgeColor
+		*  \brief Color of the Edge
 		*/
-		osg::ref_ptr<osgText::FadeText> label;
+		osg::Vec4 edgeColor;
 
 
 		/**
-		*  Util::ApplicationConfig * appConf
-		*  \brief ApplicationConfig
+		*  osg::ref_ptr<osg::Referenced> proxy
+		*  \brief Primitive set of the Edge in scene graph, NULL if the Edge is not drawn
 		*/
-		Util::ApplicationConfig * appConf;
-
+		osg::ref_ptr<osg::Referenced> proxy;
 
 		/**
-		*  osg::Vec4 edgeColor
-		*  \brief Color of the Edge
+		*  Data::EdgeView * view
+		*  \brief proxy as EdgeView
 		*/
-		osg::Vec4 edgeColor;
+		Data::EdgeView * view;
 
 	protected:
 
@@ -13,6 +13,9 @@
 #include "Data/Edge.h"
 #include "Data/MetaType.h"
 #include "Data/GraphLayout.h"
+#include "Data/SlotMap.h"
+#include "Data/AttributeStore.h"
+#include "Data/Adjacency.h"
 #include "Model/GraphDAO.h"
 #include "Model/GraphLayoutDAO.h"
 #include "Model/TypeDAO.h"
@@ -22,6 +25,8 @@
 
 #include <QString>
 #include <QTextStream>
+#include <QHash>
+#include <QMutex>
 #include <QList>
 #include <QDebug>
 #include <QtSql>
@@ -51,11 +56,52 @@ namespace Data
 	class Graph
     {
     public:
+
+		/**
+		*  \brief Dense store of Nodes with stable handles
+		*/
+		typedef Data::SlotMap<osg::ref_ptr<Data::Node> > NodeStore;
+
+		/**
+		*  \brief Dense store of Edges with stable handles
+		*/
+		typedef Data::SlotMap<osg::ref_ptr<Data::Edge> > EdgeStore;
+
+		/**
+		*  \struct NodeSpec
+		*  \brief Arguments of addNode for one Node of addNodes
+		*/
+		struct NodeSpec
+		{
+			NodeSpec() : type(NULL) {}
+			NodeSpec(QString name, Data::Type* type, osg::Vec3f position = osg::Vec3f(0,0,0)) : name(name), type(type), position(position) {}
+
+			QString name;
+			Data::Type* type;
+			osg::Vec3f position;
+		};
+
+		/**
+		*  \struct EdgeSpec
+		*  \brief Arguments of addEdge for one Edge of addEdges
+		*/
+		struct EdgeSpec
+		{
+			EdgeSpec() : type(NULL), isOriented(false) {}
+			EdgeSpec(QString name, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented) : name(name), srcNode(srcNode), dstNode(dstNode), type(type), isOriented(isOriented) {}
+
+			QString name;
+			osg::ref_ptr<Data::Node> srcNode;
+			osg::ref_ptr<Data::Node> dstNode;
+			Data::Type* type;
+			bool isOriented;
+		};
         
 		/**
 		*  \fn public overloaded constructor  Graph(qlonglong graph_id, QString name, QSqlDatabase* conn, QMap<qlonglong,osg::ref_ptr<Data::Node> > *nodes, QMap<qlonglong,osg::ref_ptr<Data::Edge> > *edges,QMap<qlonglong,osg::ref_ptr<Data::Node> > *metaNodes, QMap<qlonglong,osg::ref_ptr<Data::Edge> > *metaEdges, QMap<qlonglong,Data::Type*> *types)
 		*  \brief Creates new Graph Object from provided nodes, edges, types, metaNodes and metaEdges
 		*
+		*	Graph takes ownership of provided maps, Nodes and Edges are moved to its stores and the maps of Nodes and Edges are deleted.
 		*	This constructor is obsolete, use Graph(qlonglong graph_id, QString name, qlonglong layout_id_counter, qlonglong ele_id_counter, QSqlDatabase* conn) instead
 		*
 		*  \param   graph_id     ID of the graph
@@ -209,6 +255,28 @@ namespace Data
 		*  \return osg::ref_ptr the added Edge
 		*/
 		osg::ref_ptr<Data::Edge> addEdge(QString name, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented); 
+
+		/**
+		*  \fn public  addNodes(const QList<NodeSpec> &specs)
+		*  \brief Creates new Nodes and adds them to the Graph at once
+		*
+		*	Dense stores are reserved once and Nodes are indexed by their Type after all of them are created.
+		*
+		*  \param   specs    names, Types and positions of the Nodes
+		*  \return QList<osg::ref_ptr<Data::Node> > the added Nodes in order of specs
+		*/
+		QList<osg::ref_ptr<Data::Node> > addNodes(const QList<NodeSpec> &specs);
+
+		/**
+		*  \fn public  addEdges(const QList<EdgeSpec> &specs)
+		*  \brief Creates new Edges and adds them to the Graph at once
+		*
+		*	Dense stores are reserved once and Edges are indexed by their Type after all of them are created.
+		*
+		*  \param   specs    names, Nodes, Types and orientation of the Edges
+		*  \return QList<osg::ref_ptr<Data::Edge> > the added Edges in order of specs
+		*/
+		QList<osg::ref_ptr<Data::Edge> > addEdges(const QList<EdgeSpec> &specs);
         
 
 		/**
@@ -244,6 +312,24 @@ namespace Data
 		*  \param       edge the Edge to be removed from the Graph  
 		*/
 		void removeEdge(osg::ref_ptr<Data::Edge> edge);
+
+		/**
+		*  \fn public  removeNodes(const QList<osg::ref_ptr<Data::Node> > &nodes)
+		*  \brief Removes Nodes and all their Edges from the Graph in one pass
+		*
+		*	Index of Nodes by Type is filtered once per affected Type instead of once per Node,
+		*	so removal of all Nodes of one Type is linear.
+		*
+		*  \param      nodes   the Nodes to be removed from the Graph
+		*/
+		void removeNodes(const QList<osg::ref_ptr<Data::Node> > &nodes);
+
+		/**
+		*  \fn public  removeEdges(const QList<osg::ref_ptr<Data::Edge> > &edges)
+		*  \brief Removes Edges from the Graph in one pass
+		*  \param       edges the Edges to be removed from the Graph
+		*/
+		void removeEdges(const QList<osg::ref_ptr<Data::Edge> > &edges);
         
 
 		/**
@@ -266,35 +352,79 @@ namespace Data
 
 
 		/**
-		*  \fn inline public constant  getNodes
-		*  \brief Returns QMap of the Nodes assigned to the Graph
-		*  \return QMap<qlonglong,osg::ref_ptr<Data::Node> > * Nodes assigned to the Graph
+		*  \fn inline public constant  getNodeStore
+		*  \brief Returns dense store of the Nodes assigned to the Graph, order of Nodes changes by removal
+		*  \return const NodeStore & Nodes assigned to the Graph
+		*/
+		const NodeStore &getNodeStore() const { return nodeStore; }
+
+		/**
+		*  \fn inline public constant  getEdgeStore
+		*  \brief Returns dense store of the Edges assigned to the Graph, order of Edges changes by removal
+		*  \return const EdgeStore & Edges assigned to the Graph
+		*/
+		const EdgeStore &getEdgeStore() const { return edgeStore; }
+
+		/**
+		*  \fn inline public constant  getMetaNodeStore
+		*  \brief Returns dense store of the meta-Nodes assigned to the Graph, order of meta-Nodes changes by removal
+		*  \return const NodeStore & meta-Nodes assigned to the Graph
 		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Node> >* getNodes() const { return nodes; } 
+		const NodeStore &getMetaNodeStore() const { return metaNodeStore; }
 
+		/**
+		*  \fn inline public constant  getMetaEdgeStore
+		*  \brief Returns dense store of the meta-Edges assigned to the Graph, order of meta-Edges changes by removal
+		*  \return const EdgeStore & meta-Edges assigned to the Graph
+		*/
+		const EdgeStore &getMetaEdgeStore() const { return metaEdgeStore; }
+
+		/**
+		*  \fn public constant  findNode(qlonglong id)
+		*  \brief Finds Node or meta-Node by its ID in O(1)
+		*  \param  id  ID of the Node
+		*  \return osg::ref_ptr<Data::Node> Node or NULL, if the Graph has no Node with the ID
+		*/
+		osg::ref_ptr<Data::Node> findNode(qlonglong id) const;
 
 		/**
-		*  \fn inline public constant  getEdges
-		*  \brief Returns QMap of the Edges assigned to the Graph
-		*  \return QMap<qlonglong,osg::ref_ptr<Data::Edge> > * Edges assigned to the Graph
+		*  \fn public constant  findEdge(qlonglong id)
+		*  \brief Finds Edge or meta-Edge by its ID in O(1)
+		*  \param  id  ID of the Edge
+		*  \return osg::ref_ptr<Data::Edge> Edge or NULL, if the Graph has no Edge with the ID
 		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Edge> >* getEdges() const { return edges; } 
+		osg::ref_ptr<Data::Edge> findEdge(qlonglong id) const;
 
+		/**
+		*  \fn inline public  getNodeAttributes
+		*  \brief Returns columnar attributes of Nodes and meta-Nodes, rows are indexed by ID of Node
+		*  \return Data::AttributeStore * attributes of Nodes
+		*/
+		Data::AttributeStore * getNodeAttributes() { return &nodeAttributes; }
 
 		/**
-		*  \fn inline public constant  getMetaNodes
-		*  \brief Returns QMap of the meta-Nodes assigned to the Graph
-		*  \return QMap<qlonglong,osg::ref_ptr<Data::Node> > * meta-Nodes assigned to the Graph
+		*  \fn inline public  getEdgeAttributes
+		*  \brief Returns columnar attributes of Edges and meta-Edges, rows are indexed by ID of Edge
+		*  \return Data::AttributeStore * attributes of Edges
 		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Node> >* getMetaNodes() const { return metaNodes; } 
+		Data::AttributeStore * getEdgeAttributes() { return &edgeAttributes; }
 
+		/**
+		*  \fn inline public constant  getTopologyVersion
+		*  \brief Returns version of topology, it is increased by every addition or removal of Node or Edge
+		*  \return qlonglong version of topology
+		*/
+		qlonglong getTopologyVersion() const { return topologyVersion; }
 
 		/**
-		*  \fn inline public constant  getMetaEdges
-		*  \brief Returns meta-Edges assigned to the Graph
-		*  \return QMap<qlonglong,osg::ref_ptr<Data::Edge> > * meta-Edges assigned to the Graph
+		*  \fn public  getAdjacency
+		*  \brief Returns index of neighbours, it is rebuilt on the first call after change of topology
+		*
+		*	Index may be read from several threads, but the Graph must not be changed while the index is used.
+		*
+		*  \return const Data::Adjacency & index of neighbours of the current topology
 		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Edge> >* getMetaEdges() const { return metaEdges; } 
+		const Data::Adjacency & getAdjacency();
 
 
 		/**
@@ -483,30 +613,6 @@ namespace Data
 		QMap<qlonglong, osg::ref_ptr<Data::Edge> > newEdges;
 
 
-		/**
-		*  QMap<qlonglong,osg::ref_ptr<Data::Node> > * nodes
-		*  \brief Nodes in the Graph
-		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Node> >* nodes;
-
-		/**
-		*  QMap<qlonglong,osg::ref_ptr<Data::Edge> > * edges
-		*  \brief Edges in the Graph
-		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Edge> >* edges;
-
-		/**
-		*  QMap<qlonglong,osg::ref_ptr<Data::Node> > * metaNodes
-		*  \brief Meta-Nodes in the Graph
-		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Node> >* metaNodes;
-
-		/**
-		*  QMap<qlonglong,osg::ref_ptr<Data::Edge> > * metaEdges
-		*  \brief Meta-Edges in the Graph
-		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Edge> >* metaEdges;
-
 		/**
 		*  QMap<qlonglong,Data::Type*> * types
 		*  \brief Types in the Graph
@@ -542,6 +648,114 @@ namespace Data
 		*  \brief Meta-Nodes in the Graph sorted by their Type
 		*/
         QMultiMap<qlonglong, osg::ref_ptr<Data::Node> > metaNodesByType;
+
+		/**
+		*  NodeStore nodeStore
+		*  \brief Nodes of the Graph stored without gaps, the only storage of Nodes in the Graph
+		*/
+		NodeStore nodeStore;
+
+		/**
+		*  EdgeStore edgeStore
+		*  \brief Edges of the Graph stored without gaps, the only storage of Edges in the Graph
+		*/
+		EdgeStore edgeStore;
+
+		/**
+		*  NodeStore metaNodeStore
+		*  \brief meta-Nodes of the Graph stored without gaps, the only storage of meta-Nodes in the Graph
+		*/
+		NodeStore metaNodeStore;
+
+		/**
+		*  EdgeStore metaEdgeStore
+		*  \brief meta-Edges of the Graph stored without gaps, the only storage of meta-Edges in the Graph
+		*/
+		EdgeStore metaEdgeStore;
+
+		/**
+		*  QHash<qlonglong,NodeStore::Handle> nodeHandles
+		*  \brief handles of Nodes in nodeStore by their ID
+		*/
+		QHash<qlonglong, NodeStore::Handle> nodeHandles;
+
+		/**
+		*  QHash<qlonglong,EdgeStore::Handle> edgeHandles
+		*  \brief handles of Edges in edgeStore by their ID
+		*/
+		QHash<qlonglong, EdgeStore::Handle> edgeHandles;
+
+		/**
+		*  QHash<qlonglong,NodeStore::Handle> metaNodeHandles
+		*  \brief handles of meta-Nodes in metaNodeStore by their ID
+		*/
+		QHash<qlonglong, NodeStore::Handle> metaNodeHandles;
+
+		/**
+		*  QHash<qlonglong,EdgeStore::Handle> metaEdgeHandles
+		*  \brief handles of meta-Edges in metaEdgeStore by their ID
+		*/
+		QHash<qlonglong, EdgeStore::Handle> metaEdgeHandles;
+
+		/**
+		*  Data::AttributeStore nodeAttributes
+		*  \brief attributes of Nodes in columns
+		*/
+		Data::AttributeStore nodeAttributes;
+
+		/**
+		*  Data::AttributeStore edgeAttributes
+		*  \brief attributes of Edges in columns
+		*/
+		Data::AttributeStore edgeAttributes;
+
+		/**
+		*  qlonglong topologyVersion
+		*  \brief version of topology, increased by storeNode, storeEdge, unstoreNode and unstoreEdge
+		*/
+		qlonglong topologyVersion;
+
+		/**
+		*  Data::Adjacency adjacency
+		*  \brief index of neighbours, valid if its version equals topologyVersion
+		*/
+		Data::Adjacency adjacency;
+
+		/**
+		*  QMutex adjacencyMutex
+		*  \brief guards rebuild of adjacency
+		*/
+		QMutex adjacencyMutex;
+
+		/**
+		*  \fn private  storeNode(osg::ref_ptr<Data::Node> node, bool meta)
+		*  \brief Appends Node to dense store and indexes its handle
+		*  \param  node  added Node
+		*  \param  meta  true, if the Node is meta-Node
+		*/
+		void storeNode(osg::ref_ptr<Data::Node> node, bool meta);
+
+		/**
+		*  \fn private  storeEdge(osg::ref_ptr<Data::Edge> edge, bool meta)
+		*  \brief Appends Edge to dense store and indexes its handle
+		*  \param  edge  added Edge
+		*  \param  meta  true, if the Edge is meta-Edge
+		*/
+		void storeEdge(osg::ref_ptr<Data::Edge> edge, bool meta);
+
+		/**
+		*  \fn private  unstoreNode(qlonglong id)
+		*  \brief Removes Node or meta-Node from dense store
+		*  \param  id  ID of the Node
+		*/
+		void unstoreNode(qlonglong id);
+
+		/**
+		*  \fn private  unstoreEdge(qlonglong id)
+		*  \brief Removes Edge or meta-Edge from dense store
+		*  \param  id  ID of the Edge
+		*/
+		void unstoreEdge(qlonglong id);
 	};
 }
 
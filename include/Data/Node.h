@@ -9,20 +9,15 @@
 
 #include <vector>
 #include <string>
+#include <osg/Referenced>
 #include <osg/Vec3f>
+#include <osg/Vec4>
 #include "Data/Type.h"
 #include "Data/Edge.h"
 #include <QMap>
 #include <QString>
 #include <QTextStream>
 
-#include <osg/Geode>
-#include <osg/Geometry>
-#include <osg/BlendFunc>
-#include <osg/Depth>
-#include <osg/CullFace>
-#include <osgText/Text>
-
 namespace Data
 {
 	class Edge;
@@ -30,13 +25,64 @@ namespace Data
 	class Graph;
 	class GraphLayout;
 
+	/**
+	*  \class NodeView
+	*  \brief Drawable representation of a Node, implemented by the viewer
+	*
+	*	Data does not depend on the viewer, Node only forwards changes of its state to its view.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class NodeView
+	{
+	public:
+
+		virtual ~NodeView() {}
+
+		/**
+		*  \fn public virtual  detach
+		*  \brief Unlinks the view from the destroyed node
+		*/
+		virtual void detach() = 0;
+
+		/**
+		*  \fn public virtual  setColor(osg::Vec4 color)
+		*  \brief Sets drawn color of the node
+		*  \param     color     drawn color
+		*/
+		virtual void setColor(osg::Vec4 color) = 0;
+
+		/**
+		*  \fn public virtual  setFixed(bool fixed)
+		*  \brief Shows or hides mark of fixed node
+		*  \param     fixed     node fixed state
+		*/
+		virtual void setFixed(bool fixed) = 0;
+
+		/**
+		*  \fn public virtual  showLabel(bool visible)
+		*  \brief Shows or hides label of the node
+		*  \param     visible     node name shown
+		*/
+		virtual void showLabel(bool visible) = 0;
+
+		/**
+		*  \fn public virtual  reloadConfig
+		*  \brief Recreates drawables from current configuration
+		*/
+		virtual void reloadConfig() = 0;
+	};
+
 	/**
 	*  \class Node
 	*  \brief Node object represents a single node in a Graph
+	*
+	*	Node holds only data of the node, its drawables are in NodeView created by the viewer.
+	*
 	*  \author Aurel Paulovic, Michal Paprcka
 	*  \date 29. 4. 2010
 	*/
-	class Node : public osg::Geode
+	class Node : public osg::Referenced
 	{
 	public:
 
@@ -197,19 +243,11 @@ namespace Data
 
 
 		/**
-		*  \fn inline public  setFixed(bool fixed) 
+		*  \fn public  setFixed(bool fixed) 
 		*  \brief Sets node fixed state
 		*  \param     fixed     fixed state
 		*/
-		void setFixed(bool fixed) 
-		{ 
-			this->fixed = fixed; 
-
-			if (fixed && !this->containsDrawable(square))
-				this->addDrawable(square);
-			else if (!fixed)
-				this->removeDrawable(square);
-		}
+		void setFixed(bool fixed);
 
 		/**
 		*  \fn inline public constant  isFixed
@@ -220,19 +258,11 @@ namespace Data
 		
 
 		/**
-		*  \fn inline public  setSelected(bool selected) 
+		*  \fn public  setSelected(bool selected) 
 		*  \brief Sets node picked state
 		*  \param     selected     picked state
 		*/
-		void setSelected(bool selected) 
-		{ 
-			if (selected)
-				setDrawableColor(0, osg::Vec4(0.0f, 0.0f, 0.0f, 1.0f));
-			else
-				setDrawableColor(0, color);
-
-			this->selected = selected; 
-		}
+		void setSelected(bool selected);
 
 		/**
 		*  \fn inline public constant  isSelected
@@ -301,17 +331,11 @@ namespace Data
 
 
 		/**
-		*  \fn inline public  setColor(osg::Vec4 color) 
+		*  \fn public  setColor(osg::Vec4 color) 
 		*  \brief Sets default node color
 		*  \param     color   default color
 		*/
-		void setColor(osg::Vec4 color) 
-		{
-			this->color = color;
-
-			if (!selected)
-				setDrawableColor(0, color);
-		}
+		void setColor(osg::Vec4 color);
 
 
 		/**
@@ -359,6 +383,31 @@ namespace Data
 		void setUsingInterpolation(bool val) { usingInterpolation = val; }
 
 
+		/**
+		*  \fn inline public constant  isLabelVisible
+		*  \return bool true, if label of the Node is shown
+		*/
+		bool isLabelVisible() const { return labelVisible; }
+
+		/**
+		*  \fn inline public  setProxy(T * proxy)
+		*  \brief Attaches drawable proxy of the Node, the Node keeps it and forwards changes of its state to it
+		*
+		*	Viewer creates the proxy when it adds the Node to scene graph.
+		*	Nodes used only by layout, analysis or export do not allocate geometry, statesets and labels.
+		*
+		*  \param  proxy  scene graph object implementing NodeView
+		*/
+		template <class T>
+		void setProxy(T * proxy) { this->proxy = proxy; view = proxy; }
+
+		/**
+		*  \fn inline public constant  getView
+		*  \return Data::NodeView * view of the Node, NULL if the Node is not drawn
+		*/
+		Data::NodeView * getView() const { return view; }
+
+
 		/**
 		*  \fn public  reloadConfig
 		*  \brief Reloads node configuration
@@ -367,18 +416,28 @@ namespace Data
 
 
 		/**
-		*  \fn inline public constant  getSettings
-		*  \brief Returns settings of the Node
+		*  \fn inline public  getSettings
+		*  \brief Returns settings of the Node, empty settings are created on the first call
 		*  \return QMap<QString,QString> * settings of the Node
 		*/
-		QMap<QString, QString> * getSettings() const { return settings; }
+		QMap<QString, QString> * getSettings()
+		{
+			if (settings == NULL)
+				settings = new QMap<QString, QString>();
+			return settings;
+		}
 
 		/**
 		*  \fn inline public  setSettings(QMap<QString, QString> * val)
-		*  \brief Sets (overrides) new settings of the Node
+		*  \brief Sets (overrides) new settings of the Node, the Node takes ownership of them
 		*  \param   val    new settings 
 		*/
-		void setSettings(QMap<QString, QString> * val) { settings = val; }
+		void setSettings(QMap<QString, QString> * val)
+		{
+			if (settings != val)
+				delete settings;
+			settings = val;
+		}
 
 	private:
 
@@ -463,46 +522,16 @@ namespace Data
 		bool selected;
 
 		/**
-		*  bool usingInterpolation
-		*  \brief node interpolation usage
+		*  bool labelVisible
+		*  \brief true, if label of the node is shown
 		*/
-		bool usingInterpolation;
-
+		bool labelVisible;
 
 		/**
-		*  \fn private static  createNode(const float & scale, osg::StateSet* bbState)
-		*  \brief Creates node drawable
-		*  \param      scale    node scale
-		*  \param  bbState    node stateset
-		*  \return osg::ref_ptr node drawable
-		*/
-		static osg::ref_ptr<osg::Drawable> createNode(const float & scale, osg::StateSet* bbState);
-
-		/**
-		*  \fn private static  createStateSet(Data::Type * type = 0)
-		*  \brief Creates node stateset
-		*  \param   type     node type
-		*  \return osg::ref_ptr node stateset
-		*/
-		static osg::ref_ptr<osg::StateSet> createStateSet(Data::Type * type = 0);
-
-		/**
-		*  \fn private static  createLabel(const float & scale, QString name)
-		*  \brief Creates node label from name
-		*  \param      scale     label scale
-		*  \param       name     label text
-		*  \return osg::ref_ptr node label
-		*/
-		static osg::ref_ptr<osg::Drawable> createLabel(const float & scale, QString name);
-
-		/**
-		*  \fn private static  createSquare
-		*  \brief Creates square around node
-		*  \param  scale   square scale  
-		*  \param  bbState     square stateset
-		*  \return osg::ref_ptr square drawable
+		*  bool usingInterpolation
+		*  \brief node interpolation usage
 		*/
-		static osg::ref_ptr<osg::Drawable> createSquare(const float & scale, osg::StateSet* bbState);
+		bool usingInterpolation;
 
 
 		/**
@@ -513,31 +542,16 @@ namespace Data
 
 
 		/**
-		*  \fn private  setDrawableColor(int pos, osg::Vec4 color)
-		*  \brief Sets drawble color
-		*  \param     pos     drawable position
-		*  \param     color     drawable color
-		*/
-		void setDrawableColor(int pos, osg::Vec4 color);
-
-		/**
-		*  QString labelText
-		*  \brief Text show in the label
-		*/
-		QString labelText;
-
-
-		/**
-		*  osg::ref_ptr label
-		*  \brief Label drawable
+		*  osg::ref_ptr<osg::Referenced> proxy
+		*  \brief Drawables of the Node in scene graph, NULL if the Node is not drawn
 		*/
-		osg::ref_ptr<osg::Drawable> label;
+		osg::ref_ptr<osg::Referenced> proxy;
 
 		/**
-		*  osg::ref_ptr square
-		*  \brief Square drawable
+		*  Data::NodeView * view
+		*  \brief proxy as NodeView
 		*/
-		osg::ref_ptr<osg::Drawable> square;
+		Data::NodeView * view;
 
 	protected:
 
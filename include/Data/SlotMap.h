@@ -0,0 +1,233 @@
+/*!
+ * SlotMap.h
+ * Projekt 3DVisual
+ */
+#ifndef DATA_SLOTMAP_DEF
+#define DATA_SLOTMAP_DEF 1
+
+#include <vector>
+#include <QtGlobal>
+
+namespace Data
+{
+	/**
+	*  \class SlotMap
+	*  \brief Dense store of values addressed by stable generational handles
+	*
+	*	Values are kept contiguous in one vector, removal moves the last value into the freed place. Handle points to slot,
+	*	slot points to the current place of value. Generation of slot is increased by every removal, so handle of removed
+	*	value never reaches value inserted later into the same slot. Insertion, removal and lookup are O(1).
+	*
+	*  \date 18. 10. 2026
+	*/
+	template <class T>
+	class SlotMap
+	{
+	public:
+
+		/**
+		*  \struct Handle
+		*  \brief Stable reference to value, default handle is invalid
+		*/
+		struct Handle
+		{
+			Handle() : slot(0), generation(0) {}
+			Handle(quint32 slot, quint32 generation) : slot(slot), generation(generation) {}
+
+			bool operator==(const Handle &other) const { return slot == other.slot && generation == other.generation; }
+			bool operator!=(const Handle &other) const { return !(*this == other); }
+
+			/**
+			*  quint32 slot
+			*  \brief index of slot
+			*/
+			quint32 slot;
+
+			/**
+			*  quint32 generation
+			*  \brief generation of slot at the time of insertion, 0 for invalid handle
+			*/
+			quint32 generation;
+		};
+
+		/**
+		*  \fn public  insert(const T &value)
+		*  \brief Appends value to the end of dense values
+		*  \param  value  inserted value
+		*  \return Handle handle of the value
+		*/
+		Handle insert(const T &value)
+		{
+			quint32 slot;
+			if (!freeSlots.empty())
+			{
+				slot = freeSlots.back();
+				freeSlots.pop_back();
+			}
+			else
+			{
+				slot = (quint32) slots.size();
+				slots.push_back(0);
+				generations.push_back(1);
+			}
+			slots[slot] = (quint32) values.size();
+			values.push_back(value);
+			owners.push_back(slot);
+			return Handle(slot, generations[slot]);
+		}
+
+		/**
+		*  \fn public  remove(const Handle &handle)
+		*  \brief Removes value, the last value takes its place
+		*  \param  handle  handle of the value
+		*  \return bool true, if handle was valid
+		*/
+		bool remove(const Handle &handle)
+		{
+			if (!contains(handle))
+			{
+				return false;
+			}
+			quint32 place = slots[handle.slot];
+			quint32 last = (quint32) values.size() - 1;
+			if (place != last)
+			{
+				values[place] = values[last];
+				owners[place] = owners[last];
+				slots[owners[place]] = place;
+			}
+			values.pop_back();
+			owners.pop_back();
+			// stare handle na slot prestanu platit
+			generations[handle.slot]++;
+			if (generations[handle.slot] == 0)
+			{
+				generations[handle.slot] = 1;
+			}
+			freeSlots.push_back(handle.slot);
+			return true;
+		}
+
+		/**
+		*  \fn inline public constant  contains(const Handle &handle)
+		*  \brief Checks if handle points to stored value
+		*  \param  handle  handle of the value
+		*  \return bool true, if value was not removed
+		*/
+		bool contains(const Handle &handle) const
+		{
+			return handle.generation != 0 && handle.slot < slots.size() && generations[handle.slot] == handle.generation;
+		}
+
+		/**
+		*  \fn inline public  get(const Handle &handle)
+		*  \brief Returns value of handle
+		*  \param  handle  handle of the value
+		*  \return T * value or NULL, if handle is not valid
+		*/
+		T *get(const Handle &handle) { return contains(handle) ? &values[slots[handle.slot]] : NULL; }
+
+		/**
+		*  \fn inline public constant  get(const Handle &handle)
+		*  \brief Returns value of handle
+		*  \param  handle  handle of the value
+		*  \return const T * value or NULL, if handle is not valid
+		*/
+		const T *get(const Handle &handle) const { return contains(handle) ? &values[slots[handle.slot]] : NULL; }
+
+		/**
+		*  \fn inline public constant  size
+		*  \brief Returns count of stored values
+		*  \return int count of values
+		*/
+		int size() const { return (int) values.size(); }
+
+		/**
+		*  \fn inline public constant  isEmpty
+		*  \return bool true, if no value is stored
+		*/
+		bool isEmpty() const { return values.empty(); }
+
+		/**
+		*  \fn inline public constant  at(int i)
+		*  \brief Returns value on dense position, positions change by removal
+		*  \param  i  position from 0 to size() - 1
+		*  \return const T & value
+		*/
+		const T &at(int i) const { return values[i]; }
+
+		/**
+		*  \fn inline public constant  handleAt(int i)
+		*  \brief Returns handle of value on dense position
+		*  \param  i  position from 0 to size() - 1
+		*  \return Handle handle of the value
+		*/
+		Handle handleAt(int i) const { return Handle(owners[i], generations[owners[i]]); }
+
+		/**
+		*  \fn inline public  reserve(int count)
+		*  \brief Allocates space for count of values
+		*  \param  count  expected count of values
+		*/
+		void reserve(int count)
+		{
+			values.reserve(count);
+			owners.reserve(count);
+			slots.reserve(count);
+			generations.reserve(count);
+		}
+
+		/**
+		*  \fn public  clear
+		*  \brief Removes all values, all handles stop to be valid
+		*/
+		void clear()
+		{
+			for (size_t i = 0; i < owners.size(); i++)
+			{
+				generations[owners[i]]++;
+				if (generations[owners[i]] == 0)
+				{
+					generations[owners[i]] = 1;
+				}
+				freeSlots.push_back(owners[i]);
+			}
+			values.clear();
+			owners.clear();
+		}
+
+	private:
+
+		/**
+		*  std::vector<T> values
+		*  \brief stored values without gaps
+		*/
+		std::vector<T> values;
+
+		/**
+		*  std::vector<quint32> owners
+		*  \brief slot of every value
+		*/
+		std::vector<quint32> owners;
+
+		/**
+		*  std::vector<quint32> slots
+		*  \brief position of value of every slot
+		*/
+		std::vector<quint32> slots;
+
+		/**
+		*  std::vector<quint32> generations
+		*  \brief current generation of every slot
+		*/
+		std::vector<quint32> generations;
+
+		/**
+		*  std::vector<quint32> freeSlots
+		*  \brief slots without value
+		*/
+		std::vector<quint32> freeSlots;
+	};
+}
+
+#endif
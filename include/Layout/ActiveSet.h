@@ -0,0 +1,246 @@
+/**
+*  ActiveSet.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_ACTIVE_SET_DEF
+#define LAYOUT_ACTIVE_SET_DEF 1
+
+#include <vector>
+
+#include "Layout/LayoutState.h"
+#include "Layout/SpatialGrid.h"
+
+namespace Layout
+{
+	/**
+	*  \class ActiveSet
+	*
+	*  \brief Set of nodes whose forces are computed in the next iteration of layout
+	*
+	*	Node which has not moved for STILL_ITERATIONS iterations and whose neighbours in graph have not moved either
+	*	is parked. Parked node still repulses other nodes, but its own forces are not computed. It is activated
+	*	again when its neighbour in graph moves, when a node moves near it (within the wake radius) or when user
+	*	edits it. On almost converged graph the work of iteration is proportional to the disturbed region.
+	*
+	*	Adjacency of nodes is stored in CSR format, so active nodes can sum their attractive forces themselves.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class ActiveSet
+	{
+	public:
+
+		/**
+		*  static const int STILL_ITERATIONS
+		*  \brief count of iterations without movement after which node can be parked
+		*/
+		static const int STILL_ITERATIONS = 10;
+
+		/**
+		*  \fn public constructor  ActiveSet
+		*  \brief Creates empty set
+		*/
+		ActiveSet();
+
+		/**
+		*  \fn public  reset(const Layout::LayoutState &state, float radius, float wakeDistance)
+		*  \brief Builds adjacency of nodes of snapshot and activates all nodes
+		*  \param  state  snapshot of graph
+		*  \param  radius  nodes closer than radius to moving node are activated
+		*  \param  wakeDistance  distance which node has to move to activate nodes near it
+		*/
+		void reset(const Layout::LayoutState &state, float radius, float wakeDistance);
+
+		/**
+		*  \fn public  clear
+		*  \brief Removes all nodes, the set has to be reset before use
+		*/
+		void clear();
+
+		/**
+		*  \fn inline public constant  isValid
+		*  \brief Returns true, if the set was reset for snapshot with count nodes
+		*  \param  count  count of nodes of snapshot
+		*  \return bool true, if the set corresponds to snapshot
+		*/
+		bool isValid(int count) const { return (int) still.size() == count && count > 0; }
+
+		/**
+		*  \fn public  disturb(const Layout::LayoutState &state, int node)
+		*  \brief Activates node edited by user, its neighbours and nodes near its new position
+		*  \param  state  snapshot of graph
+		*  \param  node  index of edited node
+		*/
+		void disturb(const Layout::LayoutState &state, int node);
+
+		/**
+		*  \fn public  record(const Layout::LayoutState &state, int node, float distance)
+		*  \brief Records movement of active node during iteration, activates nodes influenced by it
+		*  \param  state  snapshot of graph
+		*  \param  node  index of active node
+		*  \param  distance  distance moved by node, 0 if node did not move
+		*/
+		void record(const Layout::LayoutState &state, int node, float distance);
+
+		/**
+		*  \fn public  update
+		*  \brief Parks still nodes with still neighbourhood and adds activated nodes, called before iteration
+		*/
+		void update();
+
+		/**
+		*  \fn public  parkAll
+		*  \brief Parks all nodes, used when only edited part of graph has to be layouted
+		*/
+		void parkAll();
+
+		/**
+		*  \fn public constant  collectNeighbourhood(const std::vector<int> &seeds, int hops, int maxCount, std::vector<int> &region)
+		*  \brief Finds nodes in at most hops edges or meta edges from seeds by breadth first search
+		*  \param  seeds  indices of seed nodes
+		*  \param  hops  maximal distance from seeds in edges
+		*  \param  maxCount  maximal count of found nodes, nodes closer to seeds are found first
+		*  \param  region  sorted indices of found nodes including seeds
+		*/
+		void collectNeighbourhood(const std::vector<int> &seeds, int hops, int maxCount, std::vector<int> &region) const;
+
+		/**
+		*  \fn inline public constant  getActive
+		*  \brief Returns sorted indices of active nodes
+		*  \return const std::vector<int> & active nodes
+		*/
+		const std::vector<int> &getActive() const { return activeList; }
+
+		/**
+		*  \fn inline public constant  getEdgeBegin(int node)
+		*  \brief Returns position of the first neighbour of node by edges in getEdgeNeighbours()
+		*  \param  node  index of node
+		*  \return int position of the first neighbour
+		*/
+		int getEdgeBegin(int node) const { return edgeOffsets[node]; }
+
+		/**
+		*  \fn inline public constant  getEdgeEnd(int node)
+		*  \brief Returns position after the last neighbour of node by edges in getEdgeNeighbours()
+		*  \param  node  index of node
+		*  \return int position after the last neighbour
+		*/
+		int getEdgeEnd(int node) const { return edgeOffsets[node + 1]; }
+
+		/**
+		*  \fn inline public constant  getEdgeNeighbours
+		*  \brief Returns neighbours of all nodes by edges
+		*  \return const int * indices of neighbours
+		*/
+		const int *getEdgeNeighbours() const { return edgeNeighbours.empty() ? NULL : &edgeNeighbours[0]; }
+
+		/**
+		*  \fn inline public constant  getMetaBegin(int node)
+		*  \brief Returns position of the first neighbour of node by meta edges in getMetaNeighbours()
+		*  \param  node  index of node
+		*  \return int position of the first neighbour
+		*/
+		int getMetaBegin(int node) const { return metaOffsets[node]; }
+
+		/**
+		*  \fn inline public constant  getMetaEnd(int node)
+		*  \brief Returns position after the last neighbour of node by meta edges in getMetaNeighbours()
+		*  \param  node  index of node
+		*  \return int position after the last neighbour
+		*/
+		int getMetaEnd(int node) const { return metaOffsets[node + 1]; }
+
+		/**
+		*  \fn inline public constant  getMetaNeighbours
+		*  \brief Returns neighbours of all nodes by meta edges
+		*  \return const int * indices of neighbours
+		*/
+		const int *getMetaNeighbours() const { return metaNeighbours.empty() ? NULL : &metaNeighbours[0]; }
+
+	private:
+
+		/**
+		*  std::vector<int> edgeOffsets, edgeNeighbours
+		*  \brief neighbours by edges in CSR format
+		*/
+		std::vector<int> edgeOffsets, edgeNeighbours;
+
+		/**
+		*  std::vector<int> metaOffsets, metaNeighbours
+		*  \brief neighbours by meta edges in CSR format
+		*/
+		std::vector<int> metaOffsets, metaNeighbours;
+
+		/**
+		*  std::vector<int> still
+		*  \brief count of iterations since the last movement of every node
+		*/
+		std::vector<int> still;
+
+		/**
+		*  std::vector<float> drift
+		*  \brief distance moved by every node since it last activated nodes near it
+		*/
+		std::vector<float> drift;
+
+		/**
+		*  std::vector<unsigned char> active
+		*  \brief 1 for active or activated nodes
+		*/
+		std::vector<unsigned char> active;
+
+		/**
+		*  std::vector<int> activeList
+		*  \brief sorted indices of active nodes
+		*/
+		std::vector<int> activeList;
+
+		/**
+		*  std::vector<int> activated
+		*  \brief nodes activated since the last update
+		*/
+		std::vector<int> activated;
+
+		/**
+		*  std::vector<int> near
+		*  \brief buffer of nodes found in grid
+		*/
+		std::vector<int> near;
+
+		/**
+		*  Layout::SpatialGrid grid
+		*  \brief positions of nodes with cells of size of wake radius
+		*/
+		Layout::SpatialGrid grid;
+
+		/**
+		*  float wakeDistance
+		*  \brief distance which node has to move to activate nodes near it
+		*/
+		float wakeDistance;
+
+		/**
+		*  \fn private  activate(int node)
+		*  \brief Activates node and resets its still counter
+		*  \param  node  index of node
+		*/
+		void activate(int node);
+
+		/**
+		*  \fn private  activateNeighbours(int node)
+		*  \brief Activates neighbours of node by edges and meta edges
+		*  \param  node  index of node
+		*/
+		void activateNeighbours(int node);
+
+		/**
+		*  \fn private  activateNear(const Layout::LayoutState &state, int node)
+		*  \brief Activates nodes near position of node
+		*  \param  state  snapshot of graph
+		*  \param  node  index of node
+		*/
+		void activateNear(const Layout::LayoutState &state, int node);
+	};
+}
+
+#endif
@@ -0,0 +1,133 @@
+/**
+*  Checkpoint.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_CHECKPOINT_DEF
+#define LAYOUT_CHECKPOINT_DEF 1
+
+#include <QString>
+
+#include "Layout/LayoutState.h"
+
+namespace Layout
+{
+	/**
+	*  \class Checkpoint
+	*
+	*  \brief Saves and loads layout of graph in compact little-endian binary file
+	*
+	*	File is stored in directory under hash of topology of graph, so reopened graph finds its last layout.
+	*	Hash and order of nodes in file depend only on order of IDs, not on their values and not on order of nodes
+	*	in snapshot. File contains header and position, velocity and fixed flag of every node (25 bytes per node).
+	*
+	*  \date 18. 10. 2026
+	*/
+	class Checkpoint
+	{
+	public:
+
+		/**
+		*  \struct Header
+		*  \brief State of engine saved with positions
+		*/
+		struct Header
+		{
+			/**
+			*  QString engine
+			*  \brief name of engine which computed the layout
+			*/
+			QString engine;
+
+			/**
+			*  float sizeFactor
+			*  \brief size of graph layout
+			*/
+			float sizeFactor;
+
+			/**
+			*  float flexibility
+			*  \brief flexibility of edges
+			*/
+			float flexibility;
+
+			/**
+			*  bool useMaxDistance
+			*  \brief true, if repulsion was limited by distance
+			*/
+			bool useMaxDistance;
+
+			/**
+			*  int iterations
+			*  \brief count of performed iterations
+			*/
+			int iterations;
+
+			/**
+			*  bool converged
+			*  \brief true, if no node moved in the last iteration
+			*/
+			bool converged;
+		};
+
+		/**
+		*  \fn public static  hashTopology(const Layout::LayoutState &state)
+		*  \brief Returns 64-bit FNV-1a hash of counts of nodes and meta nodes and of sorted edges and meta edges
+		*  \param  state  snapshot of graph
+		*  \return quint64 hash of topology
+		*/
+		static quint64 hashTopology(const Layout::LayoutState &state);
+
+		/**
+		*  \fn public static  getPath(const QString &directory, quint64 topology)
+		*  \brief Returns path of file of topology
+		*  \param  directory  directory of checkpoints
+		*  \param  topology  hash of topology
+		*  \return QString path of file
+		*/
+		static QString getPath(const QString &directory, quint64 topology);
+
+		/**
+		*  \fn public static  save(const QString &directory, const Layout::LayoutState &state, const Header &header)
+		*  \brief Writes layout of snapshot into directory, file of the same topology is replaced
+		*  \param  directory  directory of checkpoints, it is created if it does not exist
+		*  \param  state  snapshot of graph
+		*  \param  header  state of engine
+		*  \return bool true, if file was written
+		*/
+		static bool save(const QString &directory, const Layout::LayoutState &state, const Header &header);
+
+		/**
+		*  \fn public static  load(const QString &directory, Layout::LayoutState &state, Header &header)
+		*  \brief Reads saved layout of topology of snapshot, sets positions, velocities and fixed flags of its nodes
+		*  \param  directory  directory of checkpoints
+		*  \param  state  snapshot of graph
+		*  \param  header  read state of engine
+		*  \return bool true, if layout was found and read, otherwise snapshot is not changed
+		*/
+		static bool load(const QString &directory, Layout::LayoutState &state, Header &header);
+
+	private:
+
+		/**
+		*  quint32 MAGIC
+		*  \brief first bytes of file
+		*/
+		static const quint32 MAGIC = 0x4b43594c;
+
+		/**
+		*  quint16 VERSION
+		*  \brief version of format
+		*/
+		static const quint16 VERSION = 1;
+
+		/**
+		*  \fn private static  getOrder(const Layout::LayoutState &state, std::vector<int> &order)
+		*  \brief Sorts nodes and meta nodes of snapshot by their IDs
+		*  \param  state  snapshot of graph
+		*  \param  order  indices of nodes in order of file, nodes are before meta nodes
+		*/
+		static void getOrder(const Layout::LayoutState &state, std::vector<int> &order);
+	};
+}
+
+#endif
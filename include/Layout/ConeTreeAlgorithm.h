@@ -0,0 +1,103 @@
+/**
+*  ConeTreeAlgorithm.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_CONE_TREE_ALGORITHM_DEF
+#define LAYOUT_CONE_TREE_ALGORITHM_DEF 1
+
+#include <vector>
+
+#include "Data/Graph.h"
+#include "Layout/LayoutState.h"
+#include "Layout/PlacementEngine.h"
+
+namespace Layout
+{
+	/**
+	*  \class ConeTreeAlgorithm
+	*
+	*  \brief Layout engine placing trees and directed acyclic graphs as 3D cone tree in O(n + e)
+	*
+	*	Spanning forest is grown by breadth-first search along edge direction from nodes without incoming edges,
+	*	remaining nodes (meta nodes, cycles) are attached along edges in any direction. Children of every node
+	*	lie on a circle one level below it, the circle is large enough that cones of subtrees do not overlap.
+	*	Edges which are not in the spanning forest are only drawn.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class ConeTreeAlgorithm : public Layout::PlacementEngine
+	{
+	public:
+
+		/**
+		*  \fn inline public constant  GetName
+		*  \brief Returns name of engine
+		*  \return const char * cone
+		*/
+		const char *GetName() const { return "cone"; }
+
+		/**
+		*  \fn public static  isHierarchy(Data::Graph *graph)
+		*  \brief Returns true, if graph is a forest or a sparse directed acyclic graph, such graph is placed well by cone tree
+		*  \param  graph  tested graph
+		*  \return bool true, if graph with an unoriented edge is a forest, or if oriented edges have no cycle and there are
+		*	at most HIERARCHY_EDGE_RATIO edges per node
+		*/
+		static bool isHierarchy(Data::Graph *graph);
+
+	protected:
+
+		/**
+		*  \fn protected  place(Layout::LayoutState &state)
+		*  \brief Places not fixed nodes as cone tree
+		*  \param  state  snapshot of graph
+		*/
+		void place(Layout::LayoutState &state);
+
+	private:
+
+		/**
+		*  float HIERARCHY_EDGE_RATIO
+		*  \brief maximal count of edges per node of hierarchy, edges of tree have ratio below 1
+		*/
+		static const float HIERARCHY_EDGE_RATIO;
+
+		/**
+		*  float LEVEL_DISTANCE
+		*  \brief distance of levels of tree in lengths of edge
+		*/
+		static const float LEVEL_DISTANCE;
+
+		/**
+		*  std::vector<int> offsets
+		*  \brief edges of node i are neighbours[offsets[i]] .. neighbours[offsets[i + 1] - 1]
+		*/
+		std::vector<int> offsets;
+
+		/**
+		*  std::vector<int> neighbours
+		*  \brief neighbours of all nodes, negative value -1 - j marks incoming edge from node j
+		*/
+		std::vector<int> neighbours;
+
+		/**
+		*  \fn private static  isForest(const Data::Adjacency &adjacency)
+		*  \brief Checks edges regardless of their direction
+		*  \param  adjacency  index of graph
+		*  \return bool true, if edges form no cycle
+		*/
+		static bool isForest(const Data::Adjacency &adjacency);
+
+		/**
+		*  \fn private  grow(std::vector<int> &order, int head, std::vector<int> &parent, bool directed) const
+		*  \brief Continues breadth-first search of spanning forest from nodes order[head..]
+		*  \param  order  nodes in order of search, found nodes are appended
+		*  \param  head  first node whose neighbours were not searched
+		*  \param  parent  parent of node in forest, -1 for roots, -2 for nodes not found yet
+		*  \param  directed  true, if only outgoing edges are followed
+		*/
+		void grow(std::vector<int> &order, int head, std::vector<int> &parent, bool directed) const;
+	};
+}
+
+#endif
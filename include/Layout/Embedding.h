@@ -0,0 +1,179 @@
+/**
+*  Embedding.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_EMBEDDING_DEF
+#define LAYOUT_EMBEDDING_DEF 1
+
+#include <vector>
+
+#include "Layout/LayoutState.h"
+#include "Layout/WorkerPool.h"
+
+namespace Layout
+{
+	/**
+	*  \class Embedding
+	*
+	*  \brief High-dimensional embedding of graph used by spectral placement and Pivot MDS
+	*
+	*	Every node gets one coordinate for each pivot - its distance from the pivot in edges. Pivots are either
+	*	chosen one after another as the node farthest from all previous ones, or at random, then the searches
+	*	from pivots are independent and run in parallel. Three principal components of the coordinates give
+	*	3D positions, which keep distances in graph well (place). Pivot MDS (placeMds) takes principal components
+	*	of doubly centered squared distances instead. Time is O(m * (n + e) + m^2 * n) for m pivots, n nodes
+	*	and e edges. Nodes and meta nodes of snapshot and both edges and meta edges are embedded.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class Embedding
+	{
+	public:
+
+		/**
+		*  enum PivotChoice
+		*  \brief method of choice of pivots
+		*/
+		enum PivotChoice {
+			PIVOTS_FARTHEST, PIVOTS_RANDOM
+		};
+
+		/**
+		*  \fn public constructor  Embedding(Layout::WorkerPool *pool = NULL)
+		*  \brief Creates empty embedding
+		*  \param  pool  workers of searches and covariance, NULL computes everything in the calling thread
+		*/
+		Embedding(Layout::WorkerPool *pool = NULL);
+
+		/**
+		*  \fn public  build(const Layout::LayoutState &state, int pivotCount, unsigned int seed, Embedding::PivotChoice choice = PIVOTS_FARTHEST)
+		*  \brief Chooses pivots and computes distances of all nodes from them
+		*  \param  state  snapshot of the layouted graph
+		*  \param  pivotCount  count of pivots, at most count of nodes is used
+		*  \param  seed  seed of choice of pivots
+		*  \param  choice  PIVOTS_FARTHEST spreads pivots over graph, but searches run one after another,
+		*	PIVOTS_RANDOM searches from all pivots in parallel
+		*/
+		void build(const Layout::LayoutState &state, int pivotCount, unsigned int seed, Embedding::PivotChoice choice = PIVOTS_FARTHEST);
+
+		/**
+		*  \fn public  place(Layout::LayoutState &state, double edgeLength)
+		*  \brief Sets positions of not fixed nodes to principal components of distances, distances are overwritten
+		*  \param  state  snapshot passed to build
+		*  \param  edgeLength  average length of edge in the placement
+		*  \return bool false, if graph has no edges and nodes were not placed
+		*/
+		bool place(Layout::LayoutState &state, double edgeLength);
+
+		/**
+		*  \fn public  placeMds(Layout::LayoutState &state, double edgeLength)
+		*  \brief Sets positions of not fixed nodes by Pivot MDS, distances are overwritten
+		*  \param  state  snapshot passed to build
+		*  \param  edgeLength  average length of edge in the placement
+		*  \return bool false, if graph has no edges and nodes were not placed
+		*/
+		bool placeMds(Layout::LayoutState &state, double edgeLength);
+
+		/**
+		*  \fn inline public constant  getPivotCount
+		*  \brief Returns count of chosen pivots
+		*  \return int count of pivots
+		*/
+		int getPivotCount() const { return (int) pivots.size(); }
+
+	private:
+
+		/**
+		*  Layout::WorkerPool * pool
+		*  \brief workers of parallel parts, NULL if embedding is computed in the calling thread
+		*/
+		Layout::WorkerPool *pool;
+
+		/**
+		*  int count
+		*  \brief count of embedded nodes
+		*/
+		int count;
+
+		/**
+		*  std::vector<int> offsets
+		*  \brief neighbours of node i are neighbours[offsets[i]] .. neighbours[offsets[i + 1] - 1]
+		*/
+		std::vector<int> offsets;
+
+		/**
+		*  std::vector<int> neighbours
+		*  \brief lists of neighbours of all nodes
+		*/
+		std::vector<int> neighbours;
+
+		/**
+		*  std::vector<int> pivots
+		*  \brief indices of pivots in order of choice
+		*/
+		std::vector<int> pivots;
+
+		/**
+		*  std::vector<float> distances
+		*  \brief distances from pivots, column of pivot p starts at p * count, unreachable nodes are one edge
+		*	farther than the farthest reachable node
+		*/
+		std::vector<float> distances;
+
+		/**
+		*  std::vector<std::vector<int> > queues
+		*  \brief queue of search for every worker
+		*/
+		std::vector<std::vector<int> > queues;
+
+		/**
+		*  std::vector<int> pairA, pairB
+		*  \brief pairs of columns of the upper triangle of covariance, split among workers
+		*/
+		std::vector<int> pairA, pairB;
+
+		/**
+		*  std::vector<double> covariance
+		*  \brief covariance of columns of distances, m x m
+		*/
+		std::vector<double> covariance;
+
+		/**
+		*  \fn private  search(int source, float *distance, std::vector<int> &queue)
+		*  \brief Computes distances from source by breadth-first search
+		*  \param  source  index of source node
+		*  \param  distance  column of distances of count nodes
+		*  \param  queue  queue of search with at least count items
+		*/
+		void search(int source, float *distance, std::vector<int> &queue) const;
+
+		/**
+		*  \fn private  searchPivots(int worker, int begin, int end)
+		*  \brief Computes distances from pivots [begin, end), task of worker pool
+		*  \param  worker  index of worker, selects queue
+		*  \param  begin  first pivot
+		*  \param  end  pivot after the last pivot
+		*/
+		void searchPivots(int worker, int begin, int end);
+
+		/**
+		*  \fn private  computeCovariance(int worker, int begin, int end)
+		*  \brief Computes items [begin, end) of pairA and pairB of covariance, task of worker pool
+		*  \param  worker  index of worker
+		*  \param  begin  first pair
+		*  \param  end  pair after the last pair
+		*/
+		void computeCovariance(int worker, int begin, int end);
+
+		/**
+		*  \fn private  project(Layout::LayoutState &state, double edgeLength)
+		*  \brief Sets positions of not fixed nodes to projection of distances to their three principal components
+		*  \param  state  snapshot passed to build
+		*  \param  edgeLength  average length of edge in the placement
+		*  \return bool false, if nodes were not placed
+		*/
+		bool project(Layout::LayoutState &state, double edgeLength);
+	};
+}
+
+#endif
@@ -11,16 +11,41 @@
 #include <string.h>
 #include <osg/Vec3f>
 #include <QMap>
+#include <QHash>
+#include <QLinkedList>
 #include <math.h>
+#include <float.h>
+#include <limits.h>
 #include <ctime>
 #include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QTime>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QFileInfo>
+#include <QDesktopServices>
+#include <QDebug>
 #include <QThread>
+#include <vector>
+#include <algorithm>
 
 #include "Viewer/DataHelper.h"
 #include "Data/Edge.h"
 #include "Data/Node.h"
 #include "Data/Type.h"
 #include "Data/Graph.h"
+#include "Layout/ActiveSet.h"
+#include "Layout/Checkpoint.h"
+#include "Layout/Embedding.h"
+#include "Layout/LayoutEngine.h"
+#include "Layout/ForceKernels.h"
+#include "Layout/LayoutState.h"
+#include "Layout/Multilevel.h"
+#include "Layout/Octree.h"
+#include "Layout/PositionBuffer.h"
+#include "Layout/SpatialGrid.h"
+#include "Layout/WorkerPool.h"
 #include "Util/ApplicationConfig.h"
 
 namespace Layout
@@ -34,10 +59,26 @@ namespace Layout
 	*
 	*  \date 28. 4. 2010
 	*/
-	class FRAlgorithm : public QThread
+	class FRAlgorithm : public QThread, public Layout::LayoutEngine
 	{
 	public:		
 
+		/**
+		*  enum RepulsionMode
+		*  \brief method of repulsive forces computation
+		*/
+		enum RepulsionMode {
+			REPULSION_EXACT, REPULSION_BARNES_HUT, REPULSION_GRID
+		};
+
+		/**
+		*  enum Placement
+		*  \brief method of initial placement of new graph
+		*/
+		enum Placement {
+			PLACEMENT_RANDOM, PLACEMENT_MULTILEVEL, PLACEMENT_SPECTRAL, PLACEMENT_PIVOT_MDS
+		};
+
 		/**
 		*  \fn public overloaded constructor  FRAlgorithm
 		*  \brief Creates new FRAlgorithm object
@@ -51,6 +92,12 @@ namespace Layout
 		*/
 		FRAlgorithm(Data::Graph *graph);		
 
+		/**
+		*  \fn public destructor  ~FRAlgorithm
+		*  \brief Destroys FRAlgorithm object and its workers
+		*/
+		~FRAlgorithm();
+
 		/**
 		*  \fn public  SetParameters(float sizeFactor,float flexibility,int animationSpeed,bool useMaxDistance)
 		*  \brief Sets parameters of layout algorithm
@@ -74,6 +121,57 @@ namespace Layout
 		*/
 		void SetAlphaValue(float val) {ALPHA = val; };
 
+		/**
+		*  \fn inline public  SetRepulsionMode(FRAlgorithm::RepulsionMode mode)
+		*  \brief Sets method of repulsive forces computation
+		*  \param      mode  REPULSION_EXACT computes all pairs, REPULSION_BARNES_HUT approximates distant nodes by octree,
+		*	REPULSION_GRID computes only pairs closer than GRID_RADIUS_FACTOR * K (at most MAX_DISTANCE) found in uniform grid
+		*	(even if maximal distance is not used)
+		*
+		*	Octree pays off only on large graphs, up to about ten thousand nodes the exact kernel is as fast or faster.
+		*	Iteration of grid grows linearly with count of nodes as long as nodes are spread about K apart.
+		*/
+		void SetRepulsionMode(FRAlgorithm::RepulsionMode mode) { repulsionMode = mode; }
+
+		/**
+		*  \fn inline public  SetPlacement(FRAlgorithm::Placement mode)
+		*  \brief Sets method of initial placement used for the next graph set by SetGraph
+		*  \param      mode  PLACEMENT_RANDOM keeps random positions, PLACEMENT_MULTILEVEL lays out coarsened graphs and refines them level by level,
+		*	PLACEMENT_SPECTRAL places nodes by high-dimensional embedding of distances from pivots, PLACEMENT_PIVOT_MDS by Pivot MDS.
+		*	Multilevel placement is not a mode for large graphs. On grids and random sparse graphs up to a few thousand nodes it converges
+		*	two to five times sooner than random placement, forests do not converge sooner at all.
+		*	Large graphs need RepulsionMode grid or barneshut, or the non-iterative pivotmds engine.
+		*/
+		void SetPlacement(FRAlgorithm::Placement mode) { placement = mode; }
+
+		/**
+		*  \fn inline public  SetOpeningAngle(float val)
+		*  \brief Sets opening angle of Barnes-Hut approximation
+		*  \param      val  ratio of cell size and distance under which cell is approximated by its center of mass
+		*/
+		void SetOpeningAngle(float val) { theta = val; }
+
+		/**
+		*  \fn inline public  SetSeed(unsigned int val)
+		*  \brief Sets seed of random generator, layouts are identical for the same seed and count of workers
+		*  \param      val  seed used by Randomize and by separation of coincident nodes
+		*/
+		void SetSeed(unsigned int val) { seed = val; }
+
+		/**
+		*  \fn public  SetMaxIterationsPerSecond(int val)
+		*  \brief Limits count of iterations per second, so layout does not use whole core
+		*  \param      val  maximal count of iterations per second, 0 = unlimited
+		*/
+		void SetMaxIterationsPerSecond(int val);
+
+		/**
+		*  \fn inline public  SetActiveSet(bool val)
+		*  \brief Enables computing forces only for nodes which move or whose neighbourhood moves, call before Run
+		*  \param      val  true, if still nodes are parked
+		*/
+		void SetActiveSet(bool val) { useActiveSet = val; localParked = false; activeSet.clear(); }
+
 		/**
 		*  \fn public  PauseAlg
 		*  \brief Pause layout algorithm
@@ -92,6 +190,28 @@ namespace Layout
 		*/
 		void WakeUpAlg();
 
+		/**
+		*  \fn public  StopAlg
+		*  \brief Stops layout algorithm, Run returns after the current iteration
+		*/
+		void StopAlg();
+
+		/**
+		*  \fn public  RelayoutLocal(const QLinkedList<osg::ref_ptr<Data::Node> > &seeds, int hops, int iterations)
+		*  \brief Layouts only neighbourhood of edited nodes, the rest of graph is held as fixed anchors
+		*
+		*	Called from renderer thread after user edit. Layout thread captures changed topology, runs at most iterations
+		*	iterations on nodes in at most hops edges from seeds and then merges the neighbourhood with the rest of graph.
+		*	Local iterations are cheap also on large graphs. After the first local relayout the rest of graph stays parked
+		*	in active set also if SetActiveSet is off, merged layout moves only the neighbourhood and nodes it pushes.
+		*	Anchor octree is reused by next request with the same neighbourhood, e.g. while user drags a node.
+		*
+		*  \param  seeds  edited nodes
+		*  \param  hops  radius of neighbourhood in edges
+		*  \param  iterations  maximal count of local iterations
+		*/
+		void RelayoutLocal(const QLinkedList<osg::ref_ptr<Data::Node> > &seeds, int hops, int iterations);
+
 		/**
 		*  \fn public  IsRunning
 		*  \brief Returns if layout algorithm is running or not
@@ -105,12 +225,29 @@ namespace Layout
 		*/
 		void Run();
 
+		/**
+		*  \fn public  Step
+		*  \brief Runs one iteration of layout in the calling thread
+		*
+		*	Used without layout thread, e.g. by headless batch layout. Must not be called while Run is running.
+		*
+		*  \return bool true, if some node moved
+		*/
+		bool Step();
+
 		/**
 		*  \fn public  SetGraph(Data::Graph *graph)
 		*  \brief Sets graph data structure
 		*  \param graph  data structure containing nodes, edges and types
 		*/
 		void SetGraph(Data::Graph *graph);
+
+		/**
+		*  \fn public constant  GetName
+		*  \brief Returns name of engine by initial placement: fr, multilevel, spectral or pivotmds-fr
+		*  \return const char * name of engine
+		*/
+		const char *GetName() const;
 		
 	
 	private:	
@@ -193,6 +330,43 @@ namespace Layout
 		*  \brief constaint using maximal distance of nodes, when repulsive force is aplied
 		*/
 		bool useMaxDistance;
+
+		/**
+		*  FRAlgorithm::RepulsionMode repulsionMode
+		*  \brief method of repulsive forces computation
+		*/
+		FRAlgorithm::RepulsionMode repulsionMode;
+
+		/**
+		*  float theta
+		*  \brief opening angle of Barnes-Hut approximation
+		*/
+		float theta;
+
+		/**
+		*  Layout::Octree nodeTree
+		*  \brief octree of node positions used by Barnes-Hut repulsion
+		*/
+		Layout::Octree nodeTree;
+
+		/**
+		*  Layout::Octree metaNodeTree
+		*  \brief octree of meta node positions used by Barnes-Hut repulsion
+		*/
+		Layout::Octree metaNodeTree;
+
+		/**
+		*  std::vector<Layout::Octree> componentTrees
+		*  \brief octrees of node positions of connected components, used instead of nodeTree if components are sorted
+		*/
+		std::vector<Layout::Octree> componentTrees;
+
+		/**
+		*  Layout::SpatialGrid nodeGrid
+		*  \brief uniform grid of node positions used by grid repulsion
+		*/
+		Layout::SpatialGrid nodeGrid;
+
 		/**
 		*  bool notEnd
 		*  \brief algorithm end flag
@@ -205,6 +379,86 @@ namespace Layout
 		*/
 		volatile bool isIterating;
 
+		/**
+		*  QMutex schedulerMutex
+		*  \brief guards state, notEnd and frozen flag of graph between Run and control methods
+		*/
+		QMutex schedulerMutex;
+
+		/**
+		*  QWaitCondition schedulerCondition
+		*  \brief wakes sleeping Run after play, wake up, stop or change of graph
+		*/
+		QWaitCondition schedulerCondition;
+
+		/**
+		*  int minInterval
+		*  \brief minimal duration of one iteration in milliseconds, 0 = unlimited
+		*/
+		int minInterval;
+
+		/**
+		*  int sliceMs
+		*  \brief time budget of layout in one frame of viewer in milliseconds, 0 = iterations are not divided
+		*/
+		int sliceMs;
+
+		/**
+		*  int FRAME_INTERVAL
+		*  \brief period of frames of viewer in milliseconds, budgeted stepping performs one part of iteration per frame
+		*/
+		static const int FRAME_INTERVAL = 16;
+
+		/**
+		*  int SLICE_CHUNK
+		*  \brief count of items processed by one worker between checks of time budget
+		*/
+		static const int SLICE_CHUNK = 256;
+
+		/**
+		*  enum SlicePhase
+		*  \brief phase of computation of forces, forces of one phase are computed in parts
+		*/
+		enum SlicePhase {
+			SLICE_IDLE, SLICE_META_REPULSION, SLICE_REPULSION, SLICE_EDGES, SLICE_META_EDGES, SLICE_REDUCE, SLICE_ACTIVE
+		};
+
+		/**
+		*  FRAlgorithm::SlicePhase slicePhase
+		*  \brief phase of unfinished computation of forces, SLICE_IDLE if the next step starts new iteration
+		*/
+		FRAlgorithm::SlicePhase slicePhase;
+
+		/**
+		*  int sliceNext
+		*  \brief first item of slicePhase which was not processed
+		*/
+		int sliceNext;
+
+		/**
+		*  Layout::Telemetry::Sample sample
+		*  \brief measurements of actual iteration, recorded into telemetry when nodes are moved
+		*/
+		Layout::Telemetry::Sample sample;
+
+		/**
+		*  double displacementSum
+		*  \brief sum of moves of nodes in actual iteration
+		*/
+		double displacementSum;
+
+		/**
+		*  int appliedCount
+		*  \brief count of nodes whose forces were applied in actual iteration
+		*/
+		int appliedCount;
+
+		/**
+		*  \fn private  loadConfig
+		*  \brief reads parameters of algorithm from application config, called by constructors
+		*/
+		void loadConfig();
+
 		/**
 		*  \fn private  computeCalm
 		*  \brief computes rest mass chord
@@ -226,59 +480,258 @@ namespace Layout
 		*/
 		osg::Vec3f getRandomLocation();
 
-		/**
-		*  \fn private  terminate
-		*  \brief Terminates algorithm
-		*/
-		void terminate();
 				
 		/**
-		*  osg::Vec3f fv
-		*  \brief force vector
+		*  osg::Vec3f barycenter
+		*  \brief barycenter position
 		*/
-		osg::Vec3f fv;
+		osg::Vec3f barycenter;
 		
 		/**
-		*  osg::Vec3f last
-		*  \brief origin position of node
+		*  osg::Vec3f centripetal
+		*  \brief centripetal position
 		*/
-		osg::Vec3f last;
-		
+		osg::Vec3f centripetal;
+
 		/**
-		*  osg::Vec3f newLoc
-		*  \brief new position of node
+		*  unsigned int seed
+		*  \brief seed of random generator
 		*/
-		osg::Vec3f newLoc;
+		unsigned int seed;
 
 		/**
-		*  osg::Vec3f up
-		*  \brief vector U
+		*  Layout::WorkerPool * pool
+		*  \brief workers computing forces in parallel
 		*/
-		osg::Vec3f up;
+		Layout::WorkerPool *pool;
 
 		/**
-		*  osg::Vec3f vp
-		*  \brief vector V
+		*  Layout::LayoutState layoutState
+		*  \brief compact snapshot of graph on which the algorithm iterates
 		*/
-		osg::Vec3f vp;
-		
+		Layout::LayoutState layoutState;
+
 		/**
-		*  osg::Vec3f barycenter
-		*  \brief barycenter position
+		*  int pulledEdits
+		*  \brief count of user edits read by the last pull or capture
 		*/
-		osg::Vec3f barycenter;
-		
+		int pulledEdits;
+
 		/**
-		*  osg::Vec3f centripetal
-		*  \brief centripetal position
+		*  QString checkpointDirectory
+		*  \brief directory where converged layouts are saved, empty if they are not saved, relative path from config is in data directory of user
 		*/
-		osg::Vec3f centripetal;
+		QString checkpointDirectory;
+
+		/**
+		*  bool checkpointDirty
+		*  \brief true, if nodes moved since the layout was saved or resumed
+		*/
+		bool checkpointDirty;
+
+		/**
+		*  Layout::LayoutState resumeState
+		*  \brief saved layout read by SetGraph, the first iteration takes velocities from it, empty if nothing was read
+		*/
+		Layout::LayoutState resumeState;
+
+		/**
+		*  Layout::Checkpoint::Header resumeHeader
+		*  \brief state of engine saved with resumeState
+		*/
+		Layout::Checkpoint::Header resumeHeader;
+
+		/**
+		*  Layout::LayoutState * current
+		*  \brief snapshot whose forces are computed, layoutState or a coarser level of multilevel placement
+		*/
+		Layout::LayoutState *current;
+
+		/**
+		*  FRAlgorithm::Placement placement
+		*  \brief method of initial placement of new graph
+		*/
+		FRAlgorithm::Placement placement;
+
+		/**
+		*  bool placementPending
+		*  \brief true, if graph was set and was not placed yet
+		*/
+		bool placementPending;
+
+		/**
+		*  int MULTILEVEL_MIN_COUNT
+		*  \brief count of nodes of graph, which is not coarsened any more
+		*/
+		static const int MULTILEVEL_MIN_COUNT = 50;
+
+		/**
+		*  int MULTILEVEL_COARSEST_ITERATIONS
+		*  \brief maximal count of iterations of one level, the coarsest level gets it
+		*/
+		static const int MULTILEVEL_COARSEST_ITERATIONS = 300;
+
+		/**
+		*  int MULTILEVEL_LEVEL_ITERATIONS
+		*  \brief minimal count of iterations of one level, the finest levels get it
+		*/
+		static const int MULTILEVEL_LEVEL_ITERATIONS = 100;
+
+		/**
+		*  int MULTILEVEL_LEVEL_WORK
+		*  \brief count of node moves of one level, budget of level is MULTILEVEL_LEVEL_WORK / count of its nodes iterations
+		*/
+		static const int MULTILEVEL_LEVEL_WORK = 20000;
+
+		/**
+		*  float MULTILEVEL_START_TEMPERATURE
+		*  \brief maximal movement of node in the first iteration of level, multiple of rest length of level
+		*/
+		static const float MULTILEVEL_START_TEMPERATURE;
+
+		/**
+		*  float MULTILEVEL_END_TEMPERATURE
+		*  \brief maximal movement of node in the last iteration of level, multiple of rest length of level
+		*/
+		static const float MULTILEVEL_END_TEMPERATURE;
+
+		/**
+		*  float temperature
+		*  \brief maximal movement of node during multilevel placement, 0 otherwise
+		*/
+		float temperature;
+
+		/**
+		*  int EMBEDDING_PIVOTS
+		*  \brief count of pivots of spectral placement, i.e. dimension of embedding
+		*/
+		static const int EMBEDDING_PIVOTS = 50;
+
+		/**
+		*  bool useActiveSet
+		*  \brief true, if forces are computed only for active nodes
+		*/
+		bool useActiveSet;
+
+		/**
+		*  bool localParked
+		*  \brief true, if local relayout parked the rest of graph, forces are then computed only for active nodes
+		*/
+		bool localParked;
 
 		/**
-		*  double dist
-		*  \brief distance between two positions
+		*  bool useComponents
+		*  \brief true, if connected components are layouted independently and packed together
 		*/
-		double dist;	
+		bool useComponents;
+
+		/**
+		*  bool packPending
+		*  \brief true, if components of new snapshot were not packed yet
+		*/
+		bool packPending;
+
+		/**
+		*  Layout::ActiveSet activeSet
+		*  \brief active nodes of layoutState
+		*/
+		Layout::ActiveSet activeSet;
+
+		/**
+		*  int ACTIVE_RADIUS_FACTOR
+		*  \brief radius around moving node in which parked nodes are activated, in multiples of K
+		*/
+		static const int ACTIVE_RADIUS_FACTOR = 10;
+
+		/**
+		*  int GRID_RADIUS_FACTOR
+		*  \brief range of repulsive force of REPULSION_GRID in multiples of K, cells of grid have the same size
+		*/
+		static const int GRID_RADIUS_FACTOR = 4;
+
+		/**
+		*  std::vector<qlonglong> localSeeds
+		*  \brief IDs of seeds of requested local relayout, guarded by schedulerMutex
+		*/
+		std::vector<qlonglong> localSeeds;
+
+		/**
+		*  int localHops
+		*  \brief radius of neighbourhood of requested local relayout
+		*/
+		int localHops;
+
+		/**
+		*  int localIterations
+		*  \brief count of iterations of requested local relayout
+		*/
+		int localIterations;
+
+		/**
+		*  bool localPending
+		*  \brief true, if local relayout was requested and layout thread has not taken it yet
+		*/
+		bool localPending;
+
+		/**
+		*  std::vector<int> localRegion
+		*  \brief sorted indices of nodes layouted by local relayout
+		*/
+		std::vector<int> localRegion;
+
+		/**
+		*  std::vector<int> localSlot
+		*  \brief index of every node of localRegion in localTree, -1 for meta nodes
+		*/
+		std::vector<int> localSlot;
+
+		/**
+		*  int localLeft
+		*  \brief count of remaining local iterations, 0 if local relayout is not running
+		*/
+		int localLeft;
+
+		/**
+		*  std::vector<float> anchorX, anchorY, anchorZ
+		*  \brief positions of nodes outside localRegion
+		*/
+		std::vector<float> anchorX, anchorY, anchorZ;
+
+		/**
+		*  std::vector<float> localX, localY, localZ
+		*  \brief positions of nodes of localRegion
+		*/
+		std::vector<float> localX, localY, localZ;
+
+		/**
+		*  Layout::Octree anchorTree
+		*  \brief octree of anchors, built once for local relayout
+		*/
+		Layout::Octree anchorTree;
+
+		/**
+		*  std::vector<int> anchorRegion
+		*  \brief localRegion, for which anchorTree was built
+		*/
+		std::vector<int> anchorRegion;
+
+		/**
+		*  Layout::Octree localTree
+		*  \brief octree of nodes of localRegion, built in every local iteration
+		*/
+		Layout::Octree localTree;
+
+		/**
+		*  int LOCAL_MAX_COUNT
+		*  \brief maximal count of nodes layouted by local relayout
+		*/
+		static const int LOCAL_MAX_COUNT = 5000;
+
+		/**
+		*  std::vector<std::vector<osg::Vec3f> > workerForces
+		*  \brief attractive forces accumulated privately by each worker
+		*/
+		std::vector<std::vector<osg::Vec3f> > workerForces;
 
 		/**
 		*  \fn private  iterate
@@ -288,71 +741,354 @@ namespace Layout
 		bool iterate();
 
 		/**
-		*  \fn private  applyForces(Data::Node* node)
-		*  \brief Applyies forces to node
-		*  \param   node node to which will be aplified forces
+		*  \fn private  computeForces(Layout::LayoutState &snapshot)
+		*  \brief Computes forces of all nodes of snapshot
+		*  \param  snapshot  snapshot of graph
+		*/
+		void computeForces(Layout::LayoutState &snapshot);
+
+		/**
+		*  \fn private  moveNodes(Layout::LayoutState &snapshot)
+		*  \brief Moves not fixed nodes of snapshot by computed forces
+		*  \param  snapshot  snapshot of graph
+		*  \return bool true, if some node moved
+		*/
+		bool moveNodes(Layout::LayoutState &snapshot);
+
+		/**
+		*  \fn private  packComponents
+		*  \brief Moves connected components of layoutState, so their bounding spheres are packed in rows and layers around center
+		*
+		*	Components are packed from the one with most nodes and moved together with their meta nodes. Components with
+		*	fixed node or meta node are not moved, packed components avoid their bounding spheres. Called after
+		*	the first placement and after layout settles, so components do not jump between iterations.
+		*
+		*  \return bool true, if some component moved
+		*/
+		bool packComponents();
+
+		/**
+		*  \fn private  prepareRepulsion(Layout::LayoutState &snapshot)
+		*  \brief Builds octrees or updates grid of snapshot used by repulsive forces
+		*  \param  snapshot  snapshot of graph
+		*/
+		void prepareRepulsion(Layout::LayoutState &snapshot);
+
+		/**
+		*  \fn private  startIteration(bool &changed)
+		*  \brief Reads user edits, places new graph, performs step of local relayout and starts computation of forces
+		*  \param  changed  set if iteration ends without forces, true if layout has to continue
+		*  \return bool true, if forces have to be computed by continueForces
+		*/
+		bool startIteration(bool &changed);
+
+		/**
+		*  \fn private  startForces(Layout::LayoutState &snapshot, bool active)
+		*  \brief Prepares repulsion and sets the first phase of computation of forces
+		*  \param  snapshot  snapshot of graph
+		*  \param  active  true, if only forces of active nodes of layoutState are computed
+		*/
+		void startForces(Layout::LayoutState &snapshot, bool active);
+
+		/**
+		*  \fn private  continueForces(int budget, int &updates)
+		*  \brief Continues computation of forces of current snapshot in parts of SLICE_CHUNK items per worker until time budget runs out
+		*  \param  budget  time budget in milliseconds, 0 = compute all remaining forces
+		*  \param  updates  count of nodes whose repulsive forces were computed is added
+		*  \return bool true, if all forces are computed
+		*/
+		bool continueForces(int budget, int &updates);
+
+		/**
+		*  \fn inline private constant  usesActiveSet
+		*  \brief Returns true, if forces are computed only for active nodes, i.e. active set is enabled or local relayout parked the graph
+		*  \return bool true, if still nodes are parked
+		*/
+		bool usesActiveSet() const { return useActiveSet || localParked; }
+
+		/**
+		*  \fn private  moveActiveNodes
+		*  \brief Moves not fixed active nodes of layoutState and records their movement in active set
+		*  \return bool true, if some node moved
+		*/
+		bool moveActiveNodes();
+
+		/**
+		*  \fn private  takeLocalRequest(std::vector<qlonglong> &seeds, int &hops, int &iterations)
+		*  \brief Takes local relayout requested by RelayoutLocal
+		*  \param  seeds  IDs of seeds
+		*  \param  hops  radius of neighbourhood in edges
+		*  \param  iterations  maximal count of local iterations
+		*  \return bool true, if local relayout was requested
+		*/
+		bool takeLocalRequest(std::vector<qlonglong> &seeds, int &hops, int &iterations);
+
+		/**
+		*  \fn private  startLocal(const std::vector<qlonglong> &seeds, int hops, int iterations)
+		*  \brief Finds neighbourhood of seeds and builds octree of anchors
+		*  \param  seeds  IDs of seeds
+		*  \param  hops  radius of neighbourhood in edges
+		*  \param  iterations  maximal count of local iterations
+		*/
+		void startLocal(const std::vector<qlonglong> &seeds, int hops, int iterations);
+
+		/**
+		*  \fn private  computeLocalForces
+		*  \brief Computes forces of nodes of localRegion
+		*/
+		void computeLocalForces();
+
+		/**
+		*  \fn private  moveLocalNodes
+		*  \brief Moves not fixed nodes of localRegion
+		*  \return bool true, if some node moved
+		*/
+		bool moveLocalNodes();
+
+		/**
+		*  \fn private  finishLocal
+		*  \brief Ends local relayout, nodes of localRegion and their surroundings are activated in active set, the rest stays parked
+		*/
+		void finishLocal();
+
+		/**
+		*  \fn private  placeMultilevel
+		*  \brief Places nodes by layouting coarsened graphs from the coarsest one and interpolating positions to finer levels
+		*
+		*	Every level including the original graph gets its own budget of iterations, coarse levels more. Temperature
+		*	falls geometrically within the budget from MULTILEVEL_START_TEMPERATURE to MULTILEVEL_END_TEMPERATURE times
+		*	rest length of the level, so the movement limit grows with the level instead of fixed MAX_MOVEMENT.
+		*/
+		void placeMultilevel();
+
+		/**
+		*  \fn private  placeSpectral
+		*  \brief Places nodes by principal components of their distances from pivots, the shape is close to the final layout
+		*	PLACEMENT_SPECTRAL chooses pivots one after another, PLACEMENT_PIVOT_MDS chooses them at random and searches in parallel
+		*/
+		void placeSpectral();
+
+		/**
+		*  \fn private  resume
+		*  \brief Reads saved layout of graph and writes positions and fixed flags into its nodes, called by SetGraph instead of Randomize
+		*  \return bool true, if graph has saved layout
+		*/
+		bool resume();
+
+		/**
+		*  \fn private  applyResumed
+		*  \brief Sets velocities of captured nodes to velocities of resumed layout
+		*  \return bool true, if resumed layout converged with the same engine and parameters and needs no iterations
+		*/
+		bool applyResumed();
+
+		/**
+		*  \fn private  saveCheckpoint(bool converged)
+		*  \brief Saves layoutState into checkpointDirectory, called from layout thread
+		*  \param  converged  true, if no node moved in the last iteration
+		*/
+		void saveCheckpoint(bool converged);
+
+		/**
+		*  \fn private  applyForces(int i)
+		*  \brief Applyies forces to node in snapshot
+		*  \param   i index of node to which will be aplified forces
 		*  \return bool 
 		*/
-		bool applyForces(Data::Node* node);
+		bool applyForces(int i);
+
+		/**
+		*  \fn private  prepareIteration
+		*  \brief Captures snapshot of graph if its topology changed, otherwise reads user edits of nodes
+		*/
+		void prepareIteration();
+
+		/**
+		*  \fn private  computeRepulsive(int worker, int begin, int end)
+		*  \brief Computes repulsive forces of nodes [begin, end)
+		*  \param  worker  index of worker
+		*  \param  begin  first node
+		*  \param  end  node after the last node
+		*/
+		void computeRepulsive(int worker, int begin, int end);
+
+		/**
+		*  \fn private  computeMetaRepulsive(int worker, int begin, int end)
+		*  \brief Computes repulsive forces of meta nodes [begin, end), indices are relative to the first meta node
+		*  \param  worker  index of worker
+		*  \param  begin  first meta node
+		*  \param  end  meta node after the last meta node
+		*/
+		void computeMetaRepulsive(int worker, int begin, int end);
+
+		/**
+		*  \fn private  buildComponentTrees(int worker, int begin, int end)
+		*  \brief Builds octrees of connected components [begin, end) of current snapshot
+		*  \param  worker  index of worker
+		*  \param  begin  first component
+		*  \param  end  component after the last component
+		*/
+		void buildComponentTrees(int worker, int begin, int end);
+
+		/**
+		*  \fn private  computeActive(int worker, int begin, int end)
+		*  \brief Computes repulsive and attractive forces of active nodes [begin, end), indices are positions in active set
+		*  \param  worker  index of worker
+		*  \param  begin  first active node
+		*  \param  end  active node after the last active node
+		*/
+		void computeActive(int worker, int begin, int end);
+
+		/**
+		*  \fn private constant  addNodeRepulsive(int i, float &fx, float &fy, float &fz)
+		*  \brief Adds repulsive force of all nodes to node i
+		*  \param  i  index of node
+		*  \param  fx, fy, fz  accumulated force of node
+		*/
+		void addNodeRepulsive(int i, float &fx, float &fy, float &fz) const;
+
+		/**
+		*  \fn private constant  addMetaNodeRepulsive(int i, float &fx, float &fy, float &fz)
+		*  \brief Adds repulsive force of all meta nodes to meta node i
+		*  \param  i  index of meta node
+		*  \param  fx, fy, fz  accumulated force of meta node
+		*/
+		void addMetaNodeRepulsive(int i, float &fx, float &fy, float &fz) const;
+
+		/**
+		*  \fn private  computeLocal(int worker, int begin, int end)
+		*  \brief Computes forces of nodes of localRegion [begin, end)
+		*  \param  worker  index of worker
+		*  \param  begin  first position in localRegion
+		*  \param  end  position after the last node
+		*/
+		void computeLocal(int worker, int begin, int end);
 
 		/**
-		*  \fn private  addAttractive(Data::Edge* edge, float factor)
-		*  \brief Adds attractive force to node
-		*  \param  edge  which associate two nodes on which effect attractive force
-		*  \param  factor  multiplicer of attaractive force
+		*  \fn private constant  addNeighbourAttractive(int i, float &fx, float &fy, float &fz)
+		*  \brief Adds attractive forces of edges and meta edges of node i using adjacency of active set
+		*  \param  i  index of node
+		*  \param  fx, fy, fz  accumulated force of node
 		*/
-		void addAttractive(Data::Edge* edge, float factor);
+		void addNeighbourAttractive(int i, float &fx, float &fy, float &fz) const;
 
 		/**
-		*  \fn private  addMetaAttractive(Data::Node* u, Data::Node* meta, float factor)
-		*  \brief Adds attractive force between node U and meta node
-		*  \param   u  node U   
-		*  \param   meta meta node   
-		*  \param   factor  multiplicer of attaractive force   
+		*  \fn private  computeAttractive(int worker, int begin, int end)
+		*  \brief Accumulates attractive forces of edges [begin, end) into forces of worker
+		*  \param  worker  index of worker
+		*  \param  begin  first edge
+		*  \param  end  edge after the last edge
 		*/
-		void addMetaAttractive(Data::Node* u, Data::Node* meta, float factor);
+		void computeAttractive(int worker, int begin, int end);
 
 		/**
-		*  \fn private  addRepulsive(Data::Node* u, Data::Node* v, float factor)
-		*  \brief Adds repulsive force between two nodes into node U
-		*  \param  u  node U   
-		*  \param  v  node V   
+		*  \fn private  computeMetaAttractive(int worker, int begin, int end)
+		*  \brief Accumulates attractive forces of meta edges [begin, end) into forces of worker
+		*  \param  worker  index of worker
+		*  \param  begin  first meta edge
+		*  \param  end  meta edge after the last meta edge
+		*/
+		void computeMetaAttractive(int worker, int begin, int end);
+
+		/**
+		*  \fn private  reduceForces(int worker, int begin, int end)
+		*  \brief Adds forces of all workers in worker order into forces of nodes [begin, end)
+		*  \param  worker  index of worker
+		*  \param  begin  first node
+		*  \param  end  node after the last node
+		*/
+		void reduceForces(int worker, int begin, int end);
+
+		/**
+		*  \fn private constant  addAttractive(float dx, float dy, float dz, float factor, osg::Vec3f &force)
+		*  \brief Adds attractive force pulling node U towards node V
+		*  \param  dx, dy, dz  position of node V relative to node U
+		*  \param  factor  multiplicer of attaractive force divided by K
+		*  \param  force  accumulated force of node U
+		*/
+		void addAttractive(float dx, float dy, float dz, float factor, osg::Vec3f &force) const;
+
+		/**
+		*  \fn private constant  addRepulsive(float ux, float uy, float uz, float vx, float vy, float vz, float factor, unsigned int pair, float &fx, float &fy, float &fz)
+		*  \brief Adds repulsive force between node U and mass in position V
+		*  \param  ux, uy, uz  position of node U   
+		*  \param  vx, vy, vz  position of repulsing mass   
 		*  \param  factor  multiplicer of repulsive force   
+		*  \param  pair  hash of the pair, used to separate coincident positions
+		*  \param  fx, fy, fz  accumulated force of node U
 		*/
-		void addRepulsive(Data::Node* u, Data::Node* v, float factor);
+		void addRepulsive(float ux, float uy, float uz, float vx, float vy, float vz, float factor, unsigned int pair, float &fx, float &fy, float &fz) const;
 
 		/**
-		*  \fn private  rep(double distance)
-		*  \brief Computes repulsive force
-		*  \param  distance  distance between two vectors   
-		*  \return float size of repulsive force
+		*  \fn private constant  addRepulsive(float ux, float uy, float uz, int self, const Layout::Octree &tree, float factor, float &fx, float &fy, float &fz)
+		*  \brief Adds repulsive forces of all nodes in octree into node U using Barnes-Hut approximation
+		*  \param  ux, uy, uz  position of node U   
+		*  \param  self  index of node U in octree
+		*  \param  tree  octree of repulsing nodes
+		*  \param  factor  multiplicer of repulsive force   
+		*  \param  fx, fy, fz  accumulated force of node U
 		*/
-		float rep(double distance);
+		void addRepulsive(float ux, float uy, float uz, int self, const Layout::Octree &tree, float factor, float &fx, float &fy, float &fz) const;
 
 		/**
-		*  \fn private  attr(double distance)
-		*  \brief Computes attractive force
-		*  \param     distance  distance between two vectors   
-		*  \return float size of attractive force
+		*  \fn private constant  addRepulsive(int i, const Layout::SpatialGrid &grid, float factor, float &fx, float &fy, float &fz)
+		*  \brief Adds repulsive forces of nodes closer than gridDistance into node I, nodes are searched in neighbouring cells of grid
+		*  \param  i  index of node
+		*  \param  grid  grid of repulsing nodes
+		*  \param  factor  multiplicer of repulsive force   
+		*  \param  fx, fy, fz  accumulated force of node I
 		*/
-		float attr(double distance);
+		void addRepulsive(int i, const Layout::SpatialGrid &grid, float factor, float &fx, float &fy, float &fz) const;
 
 		/**
-		*  \fn private  centr(double distance)
-		*  \brief Computes centripetal force
-		*  \param      distance   distance between two vectors  
-		*  \return float size of centripetal force
+		*  \fn private constant  addCoincident(int i, int begin, int end, float factor, float &fx, float &fy, float &fz)
+		*  \brief Adds repulsive forces of nodes [begin, end) lying in the same position as node I, which are skipped by force kernel
+		*  \param  i  index of node
+		*  \param  begin  first repulsing node
+		*  \param  end  node after the last repulsing node
+		*  \param  factor  multiplicer of repulsive force   
+		*  \param  fx, fy, fz  accumulated force of node I
+		*/
+		void addCoincident(int i, int begin, int end, float factor, float &fx, float &fy, float &fz) const;
+
+		/**
+		*  \fn inline private constant  repulsiveStrength(float factor)
+		*  \brief Returns strength of repulsive force used by force kernels
+		*  \param  factor  multiplicer of repulsive force
+		*  \return float K^2 multiplied by factor
+		*/
+		float repulsiveStrength(float factor) const { return (float) (K * K) * factor; }
+
+		/**
+		*  \fn inline private constant  maxDistance2
+		*  \brief Returns square of maximal distance of repulsing nodes
+		*  \return float square of MAX_DISTANCE, if maximal distance is used, otherwise maximal float
+		*/
+		float maxDistance2() const { return useMaxDistance ? MAX_DISTANCE * MAX_DISTANCE : FLT_MAX; }
+
+		/**
+		*  \fn inline private constant  gridDistance
+		*  \brief Returns range of repulsive force of REPULSION_GRID and edge length of its cells
+		*  \return float GRID_RADIUS_FACTOR * K, at most MAX_DISTANCE
+		*/
+		float gridDistance() const { return std::min(MAX_DISTANCE, (float) (GRID_RADIUS_FACTOR * K)); }
+
+		/**
+		*  \fn private constant  pairHash(int u, int v)
+		*  \brief Returns deterministic hash of ordered pair of nodes
+		*  \param  u  index of node U
+		*  \param  v  index of node V
+		*  \return unsigned int hash of the pair
 		*/
-		float centr(double distance);
+		unsigned int pairHash(int u, int v) const;
 
 		/**
-		*  \fn private  distance(osg::Vec3f u,osg::Vec3f v)
-		*  \brief Computes distance between vectors U and V.
-		*  \param       u  vector U   
-		*  \param       v  vector V   
-		*  \return double distance between two vectors
+		*  \fn private constant  centr(double distance)
+		*  \brief Computes centripetal force
+		*  \param      distance   distance between two vectors  
+		*  \return float size of centripetal force
 		*/
-		double distance(osg::Vec3f u,osg::Vec3f v);
+		float centr(double distance) const;
 	};
 }
 
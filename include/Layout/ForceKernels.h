@@ -0,0 +1,146 @@
+/**
+*  ForceKernels.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_FORCE_KERNELS_DEF
+#define LAYOUT_FORCE_KERNELS_DEF 1
+
+#include <math.h>
+
+namespace Layout
+{
+	/**
+	*  \class ForceKernels
+	*
+	*  \brief Vectorized evaluation of Fruchterman-Reingold forces on coordinate arrays
+	*
+	*	Repulsive force of node V on node U is (V - U) * (-strength / d^2), which is the force of size
+	*	strength / d pointing from V to U, so the kernel needs no square root. Attractive force on node U is
+	*	(V - U) * d * factor, which is the force of size d^2 * factor pointing to V.
+	*
+	*	Kernels are implemented in scalar code, SSE2 and AVX2. The best level supported by the processor is
+	*	selected at runtime, the level can be lowered by setLevel.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class ForceKernels
+	{
+	public:
+
+		/**
+		*  enum Level
+		*  \brief instruction set used by kernels
+		*/
+		enum Level {
+			SCALAR, SSE2, AVX2
+		};
+
+		/**
+		*  \fn public static  getSupportedLevel
+		*  \brief Returns the best level supported by processor and operating system
+		*  \return ForceKernels::Level supported level
+		*/
+		static ForceKernels::Level getSupportedLevel();
+
+		/**
+		*  \fn public static  getLevel
+		*  \brief Returns level used by kernels
+		*  \return ForceKernels::Level used level
+		*/
+		static ForceKernels::Level getLevel();
+
+		/**
+		*  \fn public static  setLevel(ForceKernels::Level level)
+		*  \brief Sets level used by kernels, unsupported level is lowered to the supported one
+		*  \param  level  requested level
+		*/
+		static void setLevel(ForceKernels::Level level);
+
+		/**
+		*  \fn public static  getLevelName(ForceKernels::Level level)
+		*  \brief Returns name of level
+		*  \param  level  level
+		*  \return const char * name of level ("scalar", "sse2" or "avx2")
+		*/
+		static const char *getLevelName(ForceKernels::Level level);
+
+		/**
+		*  \fn public static  parseLevel(const char *name)
+		*  \brief Returns level with given name
+		*  \param  name  name of level, "auto" or unknown name means the supported level
+		*  \return ForceKernels::Level level
+		*/
+		static ForceKernels::Level parseLevel(const char *name);
+
+		/**
+		*  \fn public static  repulsive(float ux, float uy, float uz, const float *x, const float *y, const float *z, int begin, int end, float strength, float maxDistance2, float &fx, float &fy, float &fz)
+		*  \brief Adds repulsive forces of nodes [begin, end) into force of node U
+		*
+		*	Pairs in zero distance are skipped and counted, caller separates them (the node U itself is counted too).
+		*
+		*  \param  ux, uy, uz  position of node U
+		*  \param  x, y, z  positions of repulsing nodes
+		*  \param  begin  first repulsing node
+		*  \param  end  node after the last repulsing node
+		*  \param  strength  K^2 multiplied by multiplicer of repulsive force
+		*  \param  maxDistance2  square of maximal distance of repulsing nodes
+		*  \param  fx, fy, fz  accumulated force of node U
+		*  \return int count of nodes in zero distance from U
+		*/
+		static int repulsive(float ux, float uy, float uz, const float *x, const float *y, const float *z,
+			int begin, int end, float strength, float maxDistance2, float &fx, float &fy, float &fz);
+
+		/**
+		*  \fn public static  attractive(const int *src, const int *dst, int count, const float *x, const float *y, const float *z, float factor, float *fx, float *fy, float *fz)
+		*  \brief Computes attractive forces of edges, force of i-th edge acts on its source node, opposite force on destination node
+		*  \param  src  indices of source nodes of edges
+		*  \param  dst  indices of destination nodes of edges
+		*  \param  count  count of edges
+		*  \param  x, y, z  positions of nodes
+		*  \param  factor  multiplicer of attractive force divided by K
+		*  \param  fx, fy, fz  computed forces of edges
+		*/
+		static void attractive(const int *src, const int *dst, int count, const float *x, const float *y, const float *z,
+			float factor, float *fx, float *fy, float *fz);
+
+		/**
+		*  \fn inline public static  repulsivePair(float dx, float dy, float dz, float strength, float &fx, float &fy, float &fz)
+		*  \brief Adds repulsive force of mass in relative position (dx, dy, dz), the distance must not be zero
+		*  \param  dx, dy, dz  position of repulsing mass relative to node U
+		*  \param  strength  K^2 multiplied by multiplicer of repulsive force
+		*  \param  fx, fy, fz  accumulated force of node U
+		*/
+		static void repulsivePair(float dx, float dy, float dz, float strength, float &fx, float &fy, float &fz)
+		{
+			float s = -strength / (dx * dx + dy * dy + dz * dz);
+			fx += dx * s;
+			fy += dy * s;
+			fz += dz * s;
+		}
+
+		/**
+		*  \fn inline public static  attractivePair(float dx, float dy, float dz, float factor, float &fx, float &fy, float &fz)
+		*  \brief Adds attractive force towards node in relative position (dx, dy, dz)
+		*  \param  dx, dy, dz  position of attracting node relative to node U
+		*  \param  factor  multiplicer of attractive force divided by K
+		*  \param  fx, fy, fz  accumulated force of node U
+		*/
+		static void attractivePair(float dx, float dy, float dz, float factor, float &fx, float &fy, float &fz)
+		{
+			float s = sqrtf(dx * dx + dy * dy + dz * dz) * factor;
+			fx += dx * s;
+			fy += dy * s;
+			fz += dz * s;
+		}
+
+	private:
+
+		/**
+		*  int level
+		*  \brief level used by kernels, -1 before the first use
+		*/
+		static int level;
+	};
+}
+
+#endif
@@ -0,0 +1,286 @@
+/**
+*  IgraphAlgorithm.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_IGRAPH_ALGORITHM_DEF
+#define LAYOUT_IGRAPH_ALGORITHM_DEF 1
+
+#include <vector>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QTime>
+#include <QMap>
+
+#include "igraph/igraph.h"
+#include <osg/Vec3f>
+#include <osg/ref_ptr>
+
+#include "Data/Edge.h"
+#include "Data/Node.h"
+#include "Data/Graph.h"
+#include "Layout/LayoutEngine.h"
+#include "Util/ApplicationConfig.h"
+
+namespace Layout
+{
+	/**
+	*  \class IgraphAlgorithm
+	*
+	*  \brief Layout engine computing Fruchterman-Reingold layout by iGraph library
+	*
+	*	Nodes and meta nodes are mapped to compact iGraph vertex indices 0..n-1. The igraph_t structure and the layout
+	*	matrix are kept between steps, the structure is rebuilt only when topology of graph changes, moved or fixed
+	*	nodes only update positions in the matrix. Every step runs STEP_ITERATIONS iterations of simulated annealing,
+	*	layout converges after STEP_COUNT steps. Time of iteration is O(n^2).
+	*
+	*  \date 18. 10. 2026
+	*/
+	class IgraphAlgorithm : public Layout::LayoutEngine
+	{
+	public:
+
+		/**
+		*  \fn public constructor  IgraphAlgorithm
+		*  \brief Creates engine without graph
+		*/
+		IgraphAlgorithm();
+
+		/**
+		*  \fn public destructor  ~IgraphAlgorithm
+		*  \brief Releases iGraph structures
+		*/
+		~IgraphAlgorithm();
+
+		/**
+		*  \fn inline public constant  GetName
+		*  \brief Returns name of engine
+		*  \return const char * igraph
+		*/
+		const char *GetName() const { return "igraph"; }
+
+		/**
+		*  \fn public  SetGraph(Data::Graph *graph)
+		*  \brief Sets graph, iGraph structures are built in the next step
+		*  \param  graph  data structure containing nodes, edges and types
+		*/
+		void SetGraph(Data::Graph *graph);
+
+		/**
+		*  \fn public  SetParameters(float sizeFactor, float flexibility, int animationSpeed, bool useMaxDistance)
+		*  \brief Sets size of layout, the other parameters are not used by iGraph
+		*  \param  sizeFactor  size of graph layout
+		*  \param  flexibility  not used
+		*  \param  animationSpeed  not used
+		*  \param  useMaxDistance  not used
+		*/
+		void SetParameters(float sizeFactor, float flexibility, int animationSpeed, bool useMaxDistance);
+
+		/**
+		*  \fn public  Run
+		*  \brief Runs steps until StopAlg, sleeps while paused or converged
+		*/
+		void Run();
+
+		/**
+		*  \fn public  Step
+		*  \brief Runs one step of annealing in the calling thread
+		*  \return bool false, if annealing is finished
+		*/
+		bool Step();
+
+		/**
+		*  \fn public  PauseAlg
+		*  \brief Pauses layout
+		*/
+		void PauseAlg();
+
+		/**
+		*  \fn public  RunAlg
+		*  \brief Starts or resumes layout
+		*/
+		void RunAlg();
+
+		/**
+		*  \fn public  WakeUpAlg
+		*  \brief Continues annealing from the current positions after user edit
+		*/
+		void WakeUpAlg();
+
+		/**
+		*  \fn public  StopAlg
+		*  \brief Ends Run after the current step
+		*/
+		void StopAlg();
+
+		/**
+		*  \fn public  IsRunning
+		*  \brief Returns true, if Run is iterating
+		*  \return bool true, if layout is running
+		*/
+		bool IsRunning();
+
+	private:
+
+		/**
+		*  int STEP_COUNT
+		*  \brief count of steps of annealing
+		*/
+		static const int STEP_COUNT = 100;
+
+		/**
+		*  int STEP_ITERATIONS
+		*  \brief count of iterations of one step
+		*/
+		static const int STEP_ITERATIONS = 5;
+
+		/**
+		*  int WAKE_UP_STEPS
+		*  \brief count of cold steps run after user edit
+		*/
+		static const int WAKE_UP_STEPS = 20;
+
+		/**
+		*  double COOLING_EXPONENT
+		*  \brief exponent of cooling, temperature is maximal movement of node
+		*/
+		static const double COOLING_EXPONENT;
+
+		/**
+		*  Data::Graph * graph
+		*  \brief layouted graph
+		*/
+		Data::Graph *graph;
+
+		/**
+		*  igraph_t igraphGraph
+		*  \brief iGraph structure of graph, valid if built is true
+		*/
+		igraph_t igraphGraph;
+
+		/**
+		*  igraph_matrix_t layout
+		*  \brief positions of vertices, row i belongs to nodes[i]
+		*/
+		igraph_matrix_t layout;
+
+		/**
+		*  bool built
+		*  \brief true, if igraphGraph corresponds to graph
+		*/
+		bool built;
+
+		/**
+		*  qlonglong builtTopology
+		*  \brief topology version of graph when igraphGraph was built
+		*/
+		qlonglong builtTopology;
+
+		/**
+		*  Data::Graph * builtGraph
+		*  \brief graph, from which igraphGraph was built
+		*/
+		Data::Graph *builtGraph;
+
+		/**
+		*  bool seeded
+		*  \brief true, if layout contains positions, otherwise the first step starts from random layout
+		*/
+		bool seeded;
+
+		/**
+		*  std::vector<osg::ref_ptr<Data::Node> > nodes
+		*  \brief nodes by their iGraph vertex index
+		*/
+		std::vector<osg::ref_ptr<Data::Node> > nodes;
+
+		/**
+		*  int version
+		*  \brief incremented with every rebuild, frame copies nodes only when version changes
+		*/
+		int version;
+
+		/**
+		*  int stepIndex
+		*  \brief index of the next step of annealing
+		*/
+		int stepIndex;
+
+		/**
+		*  float sizeFactor
+		*  \brief normal length of edge
+		*/
+		float sizeFactor;
+
+		/**
+		*  int pulledEdits
+		*  \brief count of user edits included in layout
+		*/
+		int pulledEdits;
+
+		/**
+		*  enum State
+		*  \brief state of Run
+		*/
+		enum State {
+			RUNNING, PAUSED
+		};
+
+		/**
+		*  IgraphAlgorithm::State state
+		*  \brief actual state of the algorithm
+		*/
+		IgraphAlgorithm::State state;
+
+		/**
+		*  bool notEnd
+		*  \brief false after StopAlg
+		*/
+		bool notEnd;
+
+		/**
+		*  volatile bool isIterating
+		*  \brief true, while Run is iterating
+		*/
+		volatile bool isIterating;
+
+		/**
+		*  QMutex schedulerMutex
+		*  \brief guards state, notEnd, stepIndex and graph
+		*/
+		QMutex schedulerMutex;
+
+		/**
+		*  QWaitCondition schedulerCondition
+		*  \brief wakes sleeping Run after play, wake up, stop or change of graph
+		*/
+		QWaitCondition schedulerCondition;
+
+		/**
+		*  \fn private  rebuild
+		*  \brief Maps nodes to compact indices, builds igraphGraph and copies positions of nodes into layout
+		*/
+		void rebuild();
+
+		/**
+		*  \fn private  pullPositions
+		*  \brief Copies positions of nodes into layout after user edit, igraphGraph is kept
+		*/
+		void pullPositions();
+
+		/**
+		*  \fn private  release
+		*  \brief Destroys igraphGraph
+		*/
+		void release();
+
+		/**
+		*  \fn private  publish
+		*  \brief Writes positions from layout into position buffer
+		*/
+		void publish();
+	};
+}
+
+#endif
@@ -0,0 +1,352 @@
+/**
+*  LayoutEngine.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_LAYOUT_ENGINE_DEF
+#define LAYOUT_LAYOUT_ENGINE_DEF 1
+
+#include <QAtomicInt>
+#include <QLinkedList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <osg/ref_ptr>
+
+#include "Data/Graph.h"
+#include "Data/Node.h"
+#include "Layout/LayoutState.h"
+#include "Layout/PositionBuffer.h"
+#include "Layout/Telemetry.h"
+
+namespace Layout
+{
+	/**
+	*  \class LayoutEngine
+	*
+	*  \brief Common interface of layout algorithms driven by LayoutThread
+	*
+	*	Engine computes positions of nodes in its own thread (Run) or in the calling thread (Step, RunIterations)
+	*	and publishes them through position buffer. Renderer thread takes the newest complete frame by ApplyPositions.
+	*	Engines are created by name, so the engine can be chosen for every graph at runtime.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class LayoutEngine
+	{
+	public:
+
+		/**
+		*  \struct Stats
+		*  \brief Statistics of iterations since the graph was set
+		*/
+		struct Stats
+		{
+			/**
+			*  int iterations
+			*  \brief count of performed iterations
+			*/
+			int iterations;
+
+			/**
+			*  double lastIterationMs
+			*  \brief duration of the last iteration in milliseconds
+			*/
+			double lastIterationMs;
+
+			/**
+			*  double totalMs
+			*  \brief duration of all iterations in milliseconds
+			*/
+			double totalMs;
+
+			/**
+			*  bool converged
+			*  \brief true, if no node moved in the last iteration
+			*/
+			bool converged;
+
+			/**
+			*  int slices
+			*  \brief count of parts of iterations, iteration of budgeted stepping is processed in more parts
+			*/
+			int slices;
+
+			/**
+			*  int lastSliceUpdates
+			*  \brief count of nodes whose forces were computed in the last part of iteration
+			*/
+			int lastSliceUpdates;
+		};
+
+		/**
+		*  \fn public constructor  LayoutEngine
+		*  \brief Creates engine without graph
+		*/
+		LayoutEngine();
+
+		/**
+		*  \fn public virtual destructor  ~LayoutEngine
+		*  \brief Destroys engine
+		*/
+		virtual ~LayoutEngine();
+
+		/**
+		*  \fn public static  create(const QString &name)
+		*  \brief Creates engine by name: fr, multilevel, spectral, pivotmds-fr (FR with multilevel, spectral or Pivot MDS
+		*	initial placement), pivotmds, cone or igraph
+		*  \param  name  name of engine, unknown name creates FR engine
+		*  \return Layout::LayoutEngine * new engine
+		*/
+		static LayoutEngine *create(const QString &name);
+
+		/**
+		*  \fn public static  getNames
+		*  \brief Returns names of engines known by create
+		*  \return QStringList names of engines
+		*/
+		static QStringList getNames();
+
+		/**
+		*  \fn public static  resolve(const QString &name, Data::Graph *graph)
+		*  \brief Chooses engine for graph, name auto selects cone for trees and sparse acyclic graphs and fr otherwise
+		*  \param  name  name of engine from configuration
+		*  \param  graph  layouted graph, NULL if it is not known yet
+		*  \return QString name of engine for create
+		*/
+		static QString resolve(const QString &name, Data::Graph *graph);
+
+		/**
+		*  \fn public virtual constant  GetName
+		*  \brief Returns name of engine
+		*  \return const char * name of engine
+		*/
+		virtual const char *GetName() const = 0;
+
+		/**
+		*  \fn public virtual  SetGraph(Data::Graph *graph)
+		*  \brief Sets graph which is layouted
+		*  \param  graph  data structure containing nodes, edges and types
+		*/
+		virtual void SetGraph(Data::Graph *graph) = 0;
+
+		/**
+		*  \fn public virtual  SetParameters(float sizeFactor, float flexibility, int animationSpeed, bool useMaxDistance)
+		*  \brief Sets parameters of layout
+		*  \param  sizeFactor  size of graph layout
+		*  \param  flexibility  flexibility of graph layouting
+		*  \param  animationSpeed  speed of animation
+		*  \param  useMaxDistance  true, if repulsive forces are limited by distance
+		*/
+		virtual void SetParameters(float sizeFactor, float flexibility, int animationSpeed, bool useMaxDistance) = 0;
+
+		/**
+		*  \fn public virtual  SetAlphaValue(float val)
+		*  \brief Sets multiplicity of forces, ignored by engines without such parameter
+		*  \param  val  multiplicity of forces
+		*/
+		virtual void SetAlphaValue(float val) {}
+
+		/**
+		*  \fn public virtual  Run
+		*  \brief Runs layout in the calling thread until StopAlg, sleeps while paused or converged
+		*/
+		virtual void Run() = 0;
+
+		/**
+		*  \fn public virtual  Step
+		*  \brief Runs one iteration of layout in the calling thread, must not be called while Run is running
+		*  \return bool true, if some node moved
+		*/
+		virtual bool Step() = 0;
+
+		/**
+		*  \fn public  RunIterations(int maxIterations, int maxMilliseconds)
+		*  \brief Runs Step in the calling thread until layout converges or budget is exhausted
+		*  \param  maxIterations  maximal count of iterations, 0 = unlimited
+		*  \param  maxMilliseconds  maximal time in milliseconds, 0 = unlimited
+		*  \return int count of performed iterations
+		*/
+		int RunIterations(int maxIterations, int maxMilliseconds);
+
+		/**
+		*  \fn public virtual  PauseAlg
+		*  \brief Pauses layout
+		*/
+		virtual void PauseAlg() = 0;
+
+		/**
+		*  \fn public virtual  RunAlg
+		*  \brief Starts or resumes layout
+		*/
+		virtual void RunAlg() = 0;
+
+		/**
+		*  \fn public virtual  WakeUpAlg
+		*  \brief Wakes up converged layout after user edit of graph
+		*/
+		virtual void WakeUpAlg() = 0;
+
+		/**
+		*  \fn public virtual  StopAlg
+		*  \brief Ends Run after the current iteration
+		*/
+		virtual void StopAlg() = 0;
+
+		/**
+		*  \fn public virtual  IsRunning
+		*  \brief Returns true, if Run is iterating
+		*  \return bool true, if layout is running
+		*/
+		virtual bool IsRunning() = 0;
+
+		/**
+		*  \fn public virtual  RelayoutLocal(const QLinkedList<osg::ref_ptr<Data::Node> > &seeds, int hops, int iterations)
+		*  \brief Layouts neighbourhood of edited nodes, engines without local layout wake up the whole layout
+		*  \param  seeds  edited nodes
+		*  \param  hops  radius of neighbourhood in edges
+		*  \param  iterations  maximal count of local iterations
+		*/
+		virtual void RelayoutLocal(const QLinkedList<osg::ref_ptr<Data::Node> > &seeds, int hops, int iterations) { WakeUpAlg(); }
+
+		/**
+		*  \fn public  ApplyPositions
+		*  \brief Sets target positions of nodes from the newest frame published by layout, called from renderer thread
+		*
+		*	Frame is applied only if it includes all user edits, otherwise it would return moved nodes back.
+		*	Fixed nodes keep their positions.
+		*
+		*  \return int sequence number of the last applied frame, 0 if no frame was applied yet
+		*/
+		int ApplyPositions();
+
+		/**
+		*  \fn public  PostEdits(const QLinkedList<osg::ref_ptr<Data::Node> > &nodes)
+		*  \brief Queues positions and fixed flags of nodes edited by user, called from GUI thread before WakeUpAlg or RelayoutLocal
+		*
+		*	Layout thread reads edits only from the queue, so it does not read nodes written by GUI thread.
+		*	Later edit of the same node replaces the queued one.
+		*
+		*  \param  nodes  edited nodes
+		*/
+		void PostEdits(const QLinkedList<osg::ref_ptr<Data::Node> > &nodes);
+
+		/**
+		*  \fn inline public constant  GetEditCount
+		*  \brief Returns count of user edits of graph reported by RunAlg, WakeUpAlg and SetGraph
+		*  \return int count of edits
+		*/
+		int GetEditCount() const { return (int) editCount; }
+
+		/**
+		*  \fn inline public  GetPositionBuffer
+		*  \brief Returns buffer of positions published after every step
+		*  \return Layout::PositionBuffer * buffer of positions
+		*/
+		Layout::PositionBuffer *GetPositionBuffer() { return &positionBuffer; }
+
+		/**
+		*  \fn public  GetStats
+		*  \brief Returns statistics of iterations, can be called from any thread
+		*  \return Layout::LayoutEngine::Stats statistics
+		*/
+		Layout::LayoutEngine::Stats GetStats();
+
+		/**
+		*  \fn inline public  GetTelemetry
+		*  \brief Returns measurements of the last iterations, can be read from any thread
+		*  \return Layout::Telemetry & ring buffer of measurements, engines which do not iterate leave it empty
+		*/
+		Layout::Telemetry &GetTelemetry() { return telemetry; }
+
+	protected:
+
+		/**
+		*  Layout::Telemetry telemetry
+		*  \brief measurements of the last iterations, cleared with statistics
+		*/
+		Layout::Telemetry telemetry;
+
+		/**
+		*  Layout::PositionBuffer positionBuffer
+		*  \brief positions published by layout thread and applied by renderer thread
+		*/
+		Layout::PositionBuffer positionBuffer;
+
+		/**
+		*  QAtomicInt editCount
+		*  \brief count of user edits of graph, published frame has to include all of them
+		*/
+		QAtomicInt editCount;
+
+		/**
+		*  int appliedSequence
+		*  \brief sequence number of the last frame applied by renderer thread
+		*/
+		int appliedSequence;
+
+		/**
+		*  \fn protected  recordIteration(double milliseconds, bool changed)
+		*  \brief Adds finished iteration to statistics
+		*  \param  milliseconds  duration of iteration
+		*  \param  changed  true, if some node moved
+		*/
+		void recordIteration(double milliseconds, bool changed);
+
+		/**
+		*  \fn protected  resetStats
+		*  \brief Clears statistics, called when graph is set
+		*/
+		void resetStats();
+
+		/**
+		*  \fn protected  restoreStats(int iterations, bool converged)
+		*  \brief Sets statistics of resumed layout
+		*  \param  iterations  count of iterations performed before layout was saved
+		*  \param  converged  true, if saved layout was converged
+		*/
+		void restoreStats(int iterations, bool converged);
+
+		/**
+		*  \fn protected  recordSlice(int updates)
+		*  \brief Adds finished part of iteration to statistics
+		*  \param  updates  count of nodes whose forces were computed
+		*/
+		void recordSlice(int updates);
+
+		/**
+		*  \fn protected  takeEdits(QHash<qlonglong, Layout::LayoutState::Edit> &edits)
+		*  \brief Moves queued user edits to edits, called from layout thread
+		*  \param  edits  receives edits by ID of node
+		*/
+		void takeEdits(QHash<qlonglong, Layout::LayoutState::Edit> &edits);
+
+	private:
+
+		/**
+		*  QMutex editMutex
+		*  \brief guards pendingEdits between GUI thread and layout thread
+		*/
+		QMutex editMutex;
+
+		/**
+		*  QHash<qlonglong,Layout::LayoutState::Edit> pendingEdits
+		*  \brief user edits not taken by layout thread yet, by ID of node
+		*/
+		QHash<qlonglong, Layout::LayoutState::Edit> pendingEdits;
+
+		/**
+		*  QMutex statsMutex
+		*  \brief guards stats between layout thread and readers
+		*/
+		QMutex statsMutex;
+
+		/**
+		*  Layout::LayoutEngine::Stats stats
+		*  \brief statistics of iterations
+		*/
+		Layout::LayoutEngine::Stats stats;
+	};
+}
+
+#endif
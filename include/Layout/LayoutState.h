@@ -0,0 +1,308 @@
+/**
+*  LayoutState.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_LAYOUT_STATE_DEF
+#define LAYOUT_LAYOUT_STATE_DEF 1
+
+#include <vector>
+#include <osg/Vec3f>
+#include <osg/ref_ptr>
+#include <QHash>
+
+#include "Data/Node.h"
+#include "Data/Edge.h"
+#include "Data/Graph.h"
+#include "Layout/PositionBuffer.h"
+
+namespace Layout
+{
+	/**
+	*  \class LayoutState
+	*
+	*  \brief Compact snapshot of graph used by layout algorithms
+	*
+	*	Positions, forces, velocities and fixed flags of nodes are stored in contiguous arrays (structure of arrays),
+	*	edges are stored as pairs of node indices. Nodes are stored first, meta nodes after them. Layout algorithm
+	*	iterates only on the arrays, reads Data::Node objects only when it captures graph and never writes them,
+	*	user edits are pulled from the queue filled by GUI thread (Layout::LayoutEngine::PostEdits),
+	*	new positions are published to renderer through Layout::PositionBuffer.
+	*
+	*	Arrays are public, so hot loops can access them without getters.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class LayoutState
+	{
+	public:
+
+		/**
+		*  \fn public constructor  LayoutState
+		*  \brief Creates empty snapshot
+		*/
+		LayoutState();
+
+		/**
+		*  \struct Edit
+		*  \brief Position and fixed flag of node set by user
+		*/
+		struct Edit
+		{
+			osg::Vec3f position;
+			bool fixed;
+		};
+
+		/**
+		*  \fn public  capture(Data::Graph *graph)
+		*  \brief Rebuilds all arrays from nodes, meta nodes, edges and meta edges of the graph
+		*  \param  graph  captured graph
+		*/
+		void capture(Data::Graph *graph);
+
+		/**
+		*  \fn public  pull(const QHash<qlonglong, Layout::LayoutState::Edit> &edits, std::vector<int> *changed = NULL)
+		*  \brief Sets positions and fixed flags edited by user, so they are not overwritten
+		*  \param  edits  edits by ID of node, nodes which are not captured are skipped
+		*  \param  changed  if not NULL, indices of nodes whose position or fixed flag changed are appended
+		*/
+		void pull(const QHash<qlonglong, Layout::LayoutState::Edit> &edits, std::vector<int> *changed = NULL);
+
+		/**
+		*  \fn public  publish(Layout::PositionBuffer &buffer, int edits)
+		*  \brief Writes positions of captured nodes into the back frame of buffer and publishes it
+		*  \param  buffer  buffer read by renderer
+		*  \param  edits  count of user edits read by the last pull
+		*/
+		void publish(Layout::PositionBuffer &buffer, int edits) const;
+
+		/**
+		*  \fn public  clear
+		*  \brief Removes all nodes and edges from snapshot
+		*/
+		void clear();
+
+		/**
+		*  \fn public  resize(int count)
+		*  \brief Sets count of nodes, new nodes are placed in origin and are not bound to any Data::Node, all nodes are regular nodes
+		*  \param  count  count of nodes
+		*/
+		void resize(int count);
+
+		/**
+		*  \fn inline public  invalidate
+		*  \brief Forces capture before the next step
+		*/
+		void invalidate() { valid = false; }
+
+		/**
+		*  \fn public constant  isStale(Data::Graph *graph)
+		*  \brief Returns true, if snapshot does not correspond to topology of graph and has to be captured again
+		*  \param  graph  layouted graph
+		*  \return bool true, if snapshot is stale
+		*/
+		bool isStale(Data::Graph *graph) const;
+
+		/**
+		*  \fn public  sortComponents
+		*  \brief Finds connected components by edges and meta edges and reorders nodes, so nodes of every component are stored together
+		*
+		*	Components are numbered by their first node, order of nodes inside component and meta nodes are kept.
+		*	Edges are remapped, indices of nodes read before sorting are not valid.
+		*/
+		void sortComponents();
+
+		/**
+		*  \fn inline public constant  getComponentCount
+		*  \brief Returns count of connected components found by sortComponents
+		*  \return int count of components, 0 if components were not sorted
+		*/
+		int getComponentCount() const { return componentStart.empty() ? 0 : (int) componentStart.size() - 1; }
+
+		/**
+		*  \fn inline public constant  getCount
+		*  \brief Returns count of nodes and meta nodes
+		*  \return int count of nodes and meta nodes
+		*/
+		int getCount() const { return (int) x.size(); }
+
+		/**
+		*  \fn inline public constant  getNodeCount
+		*  \brief Returns count of nodes, meta nodes are stored after them
+		*  \return int count of nodes
+		*/
+		int getNodeCount() const { return nodeCount; }
+
+		/**
+		*  \fn inline public constant  getPosition(int i)
+		*  \brief Returns position of node
+		*  \param  i  index of node
+		*  \return osg::Vec3f position of node
+		*/
+		osg::Vec3f getPosition(int i) const { return osg::Vec3f(x[i], y[i], z[i]); }
+
+		/**
+		*  \fn inline public  setPosition(int i, const osg::Vec3f &position)
+		*  \brief Sets position of node
+		*  \param  i  index of node
+		*  \param  position  new position
+		*/
+		void setPosition(int i, const osg::Vec3f &position) { x[i] = position.x(); y[i] = position.y(); z[i] = position.z(); }
+
+		/**
+		*  \fn public constant  indexOf(qlonglong id)
+		*  \brief Returns index of node with given ID
+		*  \param  id  ID of node
+		*  \return int index of node, -1 if node is not captured
+		*/
+		int indexOf(qlonglong id) const { return index.value(id, -1); }
+
+		/**
+		*  \enum NeighbourEdges
+		*  \brief Kinds of edges included by buildNeighbours
+		*/
+		enum NeighbourEdges
+		{
+			NEIGHBOURS_EDGES = 1, NEIGHBOURS_META_EDGES = 2, NEIGHBOURS_ALL = 3
+		};
+
+		/**
+		*  \fn public constant  buildNeighbours(int count, int kinds, bool markIncoming, std::vector<int> &offsets, std::vector<int> &neighbours)
+		*  \brief Builds symmetric adjacency of the first count nodes in CSR format, loops and edges to other nodes are skipped
+		*
+		*	Neighbours of node i are neighbours[offsets[i]] .. neighbours[offsets[i + 1] - 1] in order of edges,
+		*	edges are before meta edges.
+		*
+		*  \param  count  count of indexed nodes
+		*  \param  kinds  NEIGHBOURS_EDGES, NEIGHBOURS_META_EDGES or NEIGHBOURS_ALL
+		*  \param  markIncoming  true stores source j of edge in list of its destination as -1 - j
+		*  \param  offsets  position of the first neighbour of every node, the last item is count of neighbours
+		*  \param  neighbours  neighbours of all nodes
+		*/
+		void buildNeighbours(int count, int kinds, bool markIncoming, std::vector<int> &offsets, std::vector<int> &neighbours) const;
+
+		/**
+		*  \fn inline public static  hash(unsigned int seed, unsigned int value)
+		*  \brief Deterministic pseudorandom generator independent of rand(), used by random choices of layout algorithms
+		*  \param  seed  seed of sequence
+		*  \param  value  position in sequence
+		*  \return unsigned int pseudorandom number
+		*/
+		static unsigned int hash(unsigned int seed, unsigned int value)
+		{
+			unsigned int h = seed ^ (value * 2654435761u);
+			h ^= h >> 16;
+			h *= 0x85ebca6bu;
+			h ^= h >> 13;
+			h *= 0xc2b2ae35u;
+			h ^= h >> 16;
+			return h;
+		}
+
+		/**
+		*  std::vector<float> x, y, z
+		*  \brief positions of nodes
+		*/
+		std::vector<float> x, y, z;
+
+		/**
+		*  std::vector<float> fx, fy, fz
+		*  \brief forces accumulated in actual step
+		*/
+		std::vector<float> fx, fy, fz;
+
+		/**
+		*  std::vector<float> vx, vy, vz
+		*  \brief velocities of nodes
+		*/
+		std::vector<float> vx, vy, vz;
+
+		/**
+		*  std::vector<unsigned char> fixed
+		*  \brief 1, if node is fixed and must not be moved
+		*/
+		std::vector<unsigned char> fixed;
+
+		/**
+		*  std::vector<qlonglong> ids
+		*  \brief IDs of nodes
+		*/
+		std::vector<qlonglong> ids;
+
+		/**
+		*  std::vector<osg::ref_ptr<Data::Node> > nodes
+		*  \brief captured nodes, empty if snapshot is not bound to graph
+		*/
+		std::vector<osg::ref_ptr<Data::Node> > nodes;
+
+		/**
+		*  std::vector<int> edgeSrc, edgeDst
+		*  \brief indices of source and destination nodes of edges
+		*/
+		std::vector<int> edgeSrc, edgeDst;
+
+		/**
+		*  std::vector<int> metaEdgeSrc, metaEdgeDst
+		*  \brief indices of source and destination nodes of meta edges
+		*/
+		std::vector<int> metaEdgeSrc, metaEdgeDst;
+
+		/**
+		*  std::vector<int> component
+		*  \brief connected component of every node and meta node, -1 for meta node not connected to any node, empty if components were not sorted
+		*/
+		std::vector<int> component;
+
+		/**
+		*  std::vector<int> componentStart
+		*  \brief nodes of component c are componentStart[c] .. componentStart[c + 1] - 1
+		*/
+		std::vector<int> componentStart;
+
+	private:
+
+		/**
+		*  QHash<qlonglong, int> index
+		*  \brief index of node in arrays by its ID
+		*/
+		QHash<qlonglong, int> index;
+
+		/**
+		*  int nodeCount
+		*  \brief count of nodes, meta nodes are stored after them
+		*/
+		int nodeCount;
+
+		/**
+		*  int version
+		*  \brief incremented by every capture, frames copy list of nodes only if it changes
+		*/
+		int version;
+
+		/**
+		*  Data::Graph * graph
+		*  \brief captured graph
+		*/
+		Data::Graph *graph;
+
+		/**
+		*  qlonglong topologyVersion
+		*  \brief topology version of graph during capture
+		*/
+		qlonglong topologyVersion;
+
+		/**
+		*  bool valid
+		*  \brief false, if snapshot has to be captured again
+		*/
+		bool valid;
+
+		/**
+		*  \fn private  addNode(Data::Node *node)
+		*  \brief Appends node to arrays
+		*  \param  node  appended node
+		*/
+		void addNode(Data::Node *node);
+	};
+}
+
+#endif
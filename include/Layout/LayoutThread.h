@@ -4,7 +4,7 @@
 #include <QThread>
 #include "Util/ApplicationConfig.h"
 #include "Layout/Layout.h"
-#include "Layout/FRAlgorithm.h"
+#include "Layout/LayoutEngine.h"
 
 namespace Layout
 {
@@ -26,7 +26,7 @@ namespace Layout
 		 * \brief Constructor of thread for layout algorithm.
 		 * 
 		 */
-		LayoutThread(Layout::FRAlgorithm* alg);
+		LayoutThread(Layout::LayoutEngine* alg);
 
 		/**
 		 * 
@@ -54,6 +54,26 @@ namespace Layout
 		*/
 		void wakeUp();
 
+		/**
+		*  \fn public  stop
+		*  \brief Stops layout algorithm, the thread finishes after the current iteration
+		*/
+		void stop();
+
+		/**
+		*  \fn public  relayoutLocal(const QLinkedList<osg::ref_ptr<Data::Node> > &seeds)
+		*  \brief Layouts only neighbourhood of edited nodes, size of neighbourhood is read from configuration
+		*  \param  seeds  edited nodes
+		*/
+		void relayoutLocal(const QLinkedList<osg::ref_ptr<Data::Node> > &seeds);
+
+		/**
+		*  \fn public  postEdits(const QLinkedList<osg::ref_ptr<Data::Node> > &nodes)
+		*  \brief Passes positions and fixed flags of nodes moved or fixed by user to layout algorithm
+		*  \param  nodes  edited nodes
+		*/
+		void postEdits(const QLinkedList<osg::ref_ptr<Data::Node> > &nodes);
+
 		/**
 		*  \fn public  setAlphaValue(float val)
 		*  \brief Sets multiplicity of forces
@@ -68,6 +88,20 @@ namespace Layout
 		*/
 		bool isRunning();
 
+		/**
+		*  \fn public  applyPositions
+		*  \brief Sets target positions of nodes from the newest complete frame of layout, called from renderer thread
+		*  \return int sequence number of the last applied frame
+		*/
+		int applyPositions();
+
+		/**
+		*  \fn public  getEditCount
+		*  \brief Returns count of user edits reported to layout algorithm
+		*  \return int count of edits
+		*/
+		int getEditCount();
+
 	protected:
 
 		/**
@@ -80,10 +114,10 @@ namespace Layout
 	private:
 
 		/**
-		*  Layout::FRAlgorithm * alg
-		*  \brief Object of Fruchterman-Reingold algorithm
+		*  Layout::LayoutEngine * alg
+		*  \brief Object of layout engine
 		*/
-		Layout::FRAlgorithm* alg;
+		Layout::LayoutEngine* alg;
 
 		/**
 		*  Util::ApplicationConfig * appConf
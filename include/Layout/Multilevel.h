@@ -0,0 +1,105 @@
+/**
+*  Multilevel.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_MULTILEVEL_DEF
+#define LAYOUT_MULTILEVEL_DEF 1
+
+#include <vector>
+
+#include "Layout/LayoutState.h"
+
+namespace Layout
+{
+	/**
+	*  \class Multilevel
+	*
+	*  \brief Hierarchy of coarser graphs used by multilevel layout
+	*
+	*	Every coarser level is created by matching pairs of adjacent nodes, nodes which have no unmatched neighbour
+	*	are collapsed into the lightest neighbouring group. Each node of coarser level plays the role of meta node
+	*	of its group, but it exists only in the compact snapshot. Only nodes (not meta nodes) of the finest level
+	*	and edges among them are coarsened.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class Multilevel
+	{
+	public:
+
+		/**
+		*  \fn public constructor  Multilevel
+		*  \brief Creates empty hierarchy
+		*/
+		Multilevel();
+
+		/**
+		*  \fn public  build(const Layout::LayoutState &finest, int minCount, unsigned int seed)
+		*  \brief Coarsens the finest level until it has at most minCount nodes or it can not be coarsened effectively
+		*  \param  finest  snapshot of the layouted graph
+		*  \param  minCount  count of nodes sufficient for the coarsest level
+		*  \param  seed  seed of the order in which nodes are matched
+		*/
+		void build(const Layout::LayoutState &finest, int minCount, unsigned int seed);
+
+		/**
+		*  \fn public  clear
+		*  \brief Removes all levels
+		*/
+		void clear();
+
+		/**
+		*  \fn inline public constant  getLevelCount
+		*  \brief Returns count of coarser levels, level 1 is created from the finest level, the last level is the coarsest
+		*  \return int count of coarser levels
+		*/
+		int getLevelCount() const { return (int) levels.size(); }
+
+		/**
+		*  \fn inline public  getLevel(int level)
+		*  \brief Returns snapshot of coarser level
+		*  \param  level  level from 1 to getLevelCount()
+		*  \return Layout::LayoutState & snapshot of the level
+		*/
+		Layout::LayoutState &getLevel(int level) { return levels[level - 1]; }
+
+		/**
+		*  \fn public  prolong(int level, Layout::LayoutState &finer, float spread)
+		*  \brief Places not fixed nodes of finer level into position of their group in level with small offset
+		*  \param  level  coarser level from 1 to getLevelCount()
+		*  \param  finer  snapshot of level - 1, the finest snapshot for level 1
+		*  \param  spread  maximal offset of node from position of its group in each axis
+		*/
+		void prolong(int level, Layout::LayoutState &finer, float spread);
+
+	private:
+
+		/**
+		*  std::vector<Layout::LayoutState> levels
+		*  \brief coarser levels, the first one is created from the finest level
+		*/
+		std::vector<Layout::LayoutState> levels;
+
+		/**
+		*  std::vector<std::vector<int> > parents
+		*  \brief parents[l][i] is index of group of node i of level l in level l + 1
+		*/
+		std::vector<std::vector<int> > parents;
+
+		/**
+		*  \fn private static  coarsen(const Layout::LayoutState &fine, int count, const std::vector<int> &weight, Layout::LayoutState &coarse, std::vector<int> &parent, std::vector<int> &coarseWeight, unsigned int seed)
+		*  \brief Creates one coarser level
+		*  \param  fine  finer level
+		*  \param  count  count of coarsened nodes of finer level
+		*  \param  weight  count of original nodes in nodes of finer level
+		*  \param  coarse  created level
+		*  \param  parent  index of group in created level for every coarsened node of finer level
+		*  \param  coarseWeight  count of original nodes in nodes of created level
+		*  \param  seed  seed of the order in which nodes are matched
+		*/
+		static void coarsen(const Layout::LayoutState &fine, int count, const std::vector<int> &weight,
+			Layout::LayoutState &coarse, std::vector<int> &parent, std::vector<int> &coarseWeight, unsigned int seed);
+	};
+}
+
+#endif
@@ -0,0 +1,170 @@
+/**
+*  Octree.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_OCTREE_DEF
+#define LAYOUT_OCTREE_DEF 1
+
+#include <vector>
+#include <osg/Vec3f>
+
+namespace Layout
+{
+	/**
+	*  \class Octree
+	*
+	*  \brief Space partitioning tree of node positions used by Barnes-Hut approximation of repulsive forces
+	*
+	*	Every cell stores the total mass and the center of mass of the points inside it, so a group of distant
+	*	nodes can be replaced by one pseudo-node when computing repulsive forces.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class Octree
+	{
+	public:
+
+		/**
+		*  \struct Cell
+		*  \brief One cube of the octree
+		*/
+		struct Cell
+		{
+			/**
+			*  osg::Vec3f center
+			*  \brief geometric center of the cube
+			*/
+			osg::Vec3f center;
+
+			/**
+			*  float halfSize
+			*  \brief half of the cube edge length
+			*/
+			float halfSize;
+
+			/**
+			*  osg::Vec3f massCenter
+			*  \brief center of mass of points inside the cube
+			*/
+			osg::Vec3f massCenter;
+
+			/**
+			*  float mass
+			*  \brief number of points inside the cube
+			*/
+			float mass;
+
+			/**
+			*  int children[8]
+			*  \brief indices of child cells, -1 if the child does not exist
+			*/
+			int children[8];
+
+			/**
+			*  int point
+			*  \brief index of the point stored in leaf, -1 for inner cells and empty leaves
+			*/
+			int point;
+
+			/**
+			*  bool leaf
+			*  \brief true, if the cell has no children
+			*/
+			bool leaf;
+		};
+
+		/**
+		*  \fn public constructor  Octree
+		*  \brief Creates empty octree
+		*/
+		Octree();
+
+		/**
+		*  \fn public  build(const float *x, const float *y, const float *z, int count)
+		*  \brief Rebuilds the tree from given points, each point has unit mass
+		*  \param  x  x coordinates of points
+		*  \param  y  y coordinates of points
+		*  \param  z  z coordinates of points
+		*  \param  count  count of points
+		*/
+		void build(const float *x, const float *y, const float *z, int count);
+
+		/**
+		*  \fn inline public constant  getCells
+		*  \brief Returns cells of the tree, cell 0 is the root
+		*  \return const std::vector<Cell> & cells of the tree
+		*/
+		const std::vector<Cell> &getCells() const { return cells; }
+
+		/**
+		*  \fn inline public constant  isEmpty
+		*  \brief Returns true, if the tree contains no points
+		*  \return bool true, if the tree is empty
+		*/
+		bool isEmpty() const { return cells.empty() || cells[0].mass == 0; }
+
+		/**
+		*  int MAX_DEPTH
+		*  \brief maximal depth of the tree, deeper cells aggregate coincident points
+		*/
+		static const int MAX_DEPTH = 32;
+
+	private:
+
+		/**
+		*  std::vector<Cell> cells
+		*  \brief cells of the tree stored in one array
+		*/
+		std::vector<Cell> cells;
+
+		/**
+		*  const float * x, * y, * z
+		*  \brief coordinates of points of the tree during build
+		*/
+		const float *x, *y, *z;
+
+		/**
+		*  \fn inline private constant  point(int i)
+		*  \brief Returns position of point during build
+		*  \param  i  index of the point
+		*  \return osg::Vec3f position of the point
+		*/
+		osg::Vec3f point(int i) const { return osg::Vec3f(x[i], y[i], z[i]); }
+
+		/**
+		*  \fn private  createCell(const osg::Vec3f &center, float halfSize)
+		*  \brief Appends new empty leaf cell
+		*  \param  center  center of the cube
+		*  \param  halfSize  half of the cube edge length
+		*  \return int index of the new cell
+		*/
+		int createCell(const osg::Vec3f &center, float halfSize);
+
+		/**
+		*  \fn private  insert(int cell, int point, int depth)
+		*  \brief Inserts point into subtree of cell
+		*  \param  cell  index of the cell
+		*  \param  point  index of the point
+		*  \param  depth  depth of the cell
+		*/
+		void insert(int cell, int point, int depth);
+
+		/**
+		*  \fn private  insertIntoChild(int cell, int point, int depth)
+		*  \brief Inserts point into child of inner cell, the child is created if needed
+		*  \param  cell  index of the inner cell
+		*  \param  point  index of the point
+		*  \param  depth  depth of the inner cell
+		*/
+		void insertIntoChild(int cell, int point, int depth);
+
+		/**
+		*  \fn private  computeMass(int cell)
+		*  \brief Computes mass and center of mass of subtree of cell
+		*  \param  cell  index of the cell
+		*/
+		void computeMass(int cell);
+	};
+}
+
+#endif
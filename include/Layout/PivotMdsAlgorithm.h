@@ -0,0 +1,81 @@
+/**
+*  PivotMdsAlgorithm.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_PIVOT_MDS_ALGORITHM_DEF
+#define LAYOUT_PIVOT_MDS_ALGORITHM_DEF 1
+
+#include "Layout/Embedding.h"
+#include "Layout/LayoutState.h"
+#include "Layout/PlacementEngine.h"
+#include "Layout/WorkerPool.h"
+#include "Util/ApplicationConfig.h"
+
+namespace Layout
+{
+	/**
+	*  \class PivotMdsAlgorithm
+	*
+	*  \brief Layout engine placing nodes by Pivot MDS in one step
+	*
+	*	Distances from PIVOT_COUNT random pivots are computed by parallel breadth-first searches and doubly centered,
+	*	positions are their three principal components. Layout is not iterative, so it suits graphs too large
+	*	for force directed layout.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class PivotMdsAlgorithm : public Layout::PlacementEngine
+	{
+	public:
+
+		/**
+		*  \fn public constructor  PivotMdsAlgorithm
+		*  \brief Creates engine without graph
+		*/
+		PivotMdsAlgorithm();
+
+		/**
+		*  \fn public destructor  ~PivotMdsAlgorithm
+		*  \brief Destroys engine and its workers
+		*/
+		~PivotMdsAlgorithm();
+
+		/**
+		*  \fn inline public constant  GetName
+		*  \brief Returns name of engine
+		*  \return const char * pivotmds
+		*/
+		const char *GetName() const { return "pivotmds"; }
+
+	protected:
+
+		/**
+		*  \fn protected  place(Layout::LayoutState &state)
+		*  \brief Places not fixed nodes by Pivot MDS
+		*  \param  state  snapshot of graph
+		*/
+		void place(Layout::LayoutState &state);
+
+	private:
+
+		/**
+		*  int PIVOT_COUNT
+		*  \brief count of pivots
+		*/
+		static const int PIVOT_COUNT = 50;
+
+		/**
+		*  Layout::WorkerPool * pool
+		*  \brief workers of breadth-first searches and covariance
+		*/
+		Layout::WorkerPool *pool;
+
+		/**
+		*  unsigned int seed
+		*  \brief seed of choice of pivots
+		*/
+		unsigned int seed;
+	};
+}
+
+#endif
@@ -0,0 +1,175 @@
+/**
+*  PlacementEngine.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_PLACEMENT_ENGINE_DEF
+#define LAYOUT_PLACEMENT_ENGINE_DEF 1
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QTime>
+
+#include "Data/Graph.h"
+#include "Layout/LayoutEngine.h"
+#include "Layout/LayoutState.h"
+
+namespace Layout
+{
+	/**
+	*  \class PlacementEngine
+	*
+	*  \brief Layout engine which is not iterative and places all nodes in one step
+	*
+	*	Placement is computed again only when topology of graph changes. Other user edits (moved or fixed nodes)
+	*	are only read from graph and published, so they are kept. Subclasses implement place.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class PlacementEngine : public Layout::LayoutEngine
+	{
+	public:
+
+		/**
+		*  \fn public constructor  PlacementEngine
+		*  \brief Creates engine without graph
+		*/
+		PlacementEngine();
+
+		/**
+		*  \fn public  SetGraph(Data::Graph *graph)
+		*  \brief Sets graph, it is placed in the next step
+		*  \param  graph  data structure containing nodes, edges and types
+		*/
+		void SetGraph(Data::Graph *graph);
+
+		/**
+		*  \fn public  SetParameters(float sizeFactor, float flexibility, int animationSpeed, bool useMaxDistance)
+		*  \brief Sets length of edge, the other parameters are not used
+		*  \param  sizeFactor  size of graph layout
+		*  \param  flexibility  not used
+		*  \param  animationSpeed  not used
+		*  \param  useMaxDistance  not used
+		*/
+		void SetParameters(float sizeFactor, float flexibility, int animationSpeed, bool useMaxDistance);
+
+		/**
+		*  \fn public  Run
+		*  \brief Places graph after every change until StopAlg
+		*/
+		void Run();
+
+		/**
+		*  \fn public  Step
+		*  \brief Places graph if topology changed, otherwise only publishes user edits
+		*  \return bool true, if graph was placed
+		*/
+		bool Step();
+
+		/**
+		*  \fn public  PauseAlg
+		*  \brief Pauses layout
+		*/
+		void PauseAlg();
+
+		/**
+		*  \fn public  RunAlg
+		*  \brief Starts or resumes layout
+		*/
+		void RunAlg();
+
+		/**
+		*  \fn public  WakeUpAlg
+		*  \brief Publishes user edit or places changed topology
+		*/
+		void WakeUpAlg();
+
+		/**
+		*  \fn public  StopAlg
+		*  \brief Ends Run after the current step
+		*/
+		void StopAlg();
+
+		/**
+		*  \fn public  IsRunning
+		*  \brief Returns true, if Run is not paused
+		*  \return bool true, if layout is running
+		*/
+		bool IsRunning();
+
+	protected:
+
+		/**
+		*  float sizeFactor
+		*  \brief length of edge
+		*/
+		float sizeFactor;
+
+		/**
+		*  \fn protected pure virtual  place(Layout::LayoutState &state)
+		*  \brief Sets positions of not fixed nodes of captured snapshot, called from layout thread
+		*  \param  state  snapshot of graph
+		*/
+		virtual void place(Layout::LayoutState &state) = 0;
+
+	private:
+
+		/**
+		*  Data::Graph * graph
+		*  \brief layouted graph
+		*/
+		Data::Graph *graph;
+
+		/**
+		*  Layout::LayoutState layoutState
+		*  \brief compact snapshot of graph
+		*/
+		Layout::LayoutState layoutState;
+
+		/**
+		*  int pulledEdits
+		*  \brief count of user edits read from graph by the last step
+		*/
+		int pulledEdits;
+
+		/**
+		*  enum State
+		*  \brief state of Run
+		*/
+		enum State {
+			RUNNING, PAUSED
+		};
+
+		/**
+		*  PlacementEngine::State state
+		*  \brief actual state of the algorithm
+		*/
+		PlacementEngine::State state;
+
+		/**
+		*  bool notEnd
+		*  \brief false after StopAlg
+		*/
+		bool notEnd;
+
+		/**
+		*  volatile bool isIterating
+		*  \brief true, while Run is not paused
+		*/
+		volatile bool isIterating;
+
+		/**
+		*  QMutex schedulerMutex
+		*  \brief guards state, notEnd and graph
+		*/
+		QMutex schedulerMutex;
+
+		/**
+		*  QWaitCondition schedulerCondition
+		*  \brief wakes sleeping Run after play, wake up, stop or change of graph
+		*/
+		QWaitCondition schedulerCondition;
+	};
+}
+
+#endif
@@ -0,0 +1,151 @@
+/**
+*  PositionBuffer.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_POSITION_BUFFER_DEF
+#define LAYOUT_POSITION_BUFFER_DEF 1
+
+#include <vector>
+#include <osg/Vec3f>
+#include <osg/ref_ptr>
+#include <QAtomicInt>
+
+#include "Data/Node.h"
+
+namespace Layout
+{
+	/**
+	*  \class PositionBuffer
+	*
+	*  \brief Triple buffer of node positions passed from layout thread to renderer
+	*
+	*	Layout thread (the only writer) fills the back frame and publishes it by one atomic exchange with the ready
+	*	frame. Renderer (the only reader) exchanges its front frame with the ready frame only if a newer frame was
+	*	published. Neither side waits for the other and the reader always sees a complete frame. Frames published
+	*	while the reader did not acquire any are dropped, only the newest one is kept.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class PositionBuffer
+	{
+	public:
+
+		/**
+		*  \struct Frame
+		*  \brief Positions of all layouted nodes after one step of layout
+		*/
+		struct Frame
+		{
+			/**
+			*  int sequence
+			*  \brief sequence number of the frame, 0 if no frame was published yet
+			*/
+			int sequence;
+
+			/**
+			*  int edits
+			*  \brief count of user edits included in positions
+			*/
+			int edits;
+
+			/**
+			*  int version
+			*  \brief version of node list, nodes are copied only when the layouted topology changes
+			*/
+			int version;
+
+			/**
+			*  std::vector<osg::ref_ptr<Data::Node> > nodes
+			*  \brief layouted nodes
+			*/
+			std::vector<osg::ref_ptr<Data::Node> > nodes;
+
+			/**
+			*  std::vector<osg::Vec3f> positions
+			*  \brief target positions of nodes
+			*/
+			std::vector<osg::Vec3f> positions;
+
+			Frame() : sequence(0), edits(0), version(-1) {}
+		};
+
+		/**
+		*  \fn public constructor  PositionBuffer
+		*  \brief Creates buffer without published frames
+		*/
+		PositionBuffer();
+
+		/**
+		*  \fn inline public  getBackFrame
+		*  \brief Returns frame filled by writer, it is not visible to reader until publish
+		*  \return Layout::PositionBuffer::Frame & back frame
+		*/
+		Frame &getBackFrame() { return frames[back]; }
+
+		/**
+		*  \fn public  publish
+		*  \brief Numbers the back frame and makes it the newest frame for reader, writer gets another back frame
+		*/
+		void publish();
+
+		/**
+		*  \fn public  acquire
+		*  \brief Returns the newest published frame, the frame is valid until the next acquire
+		*  \return const Layout::PositionBuffer::Frame * newest frame, NULL if no frame was published yet
+		*/
+		const Frame *acquire();
+
+		/**
+		*  \fn inline public constant  getSequence
+		*  \brief Returns sequence number of the newest published frame, can be called from any thread
+		*  \return int sequence number, 0 if no frame was published yet
+		*/
+		int getSequence() const { return (int) published; }
+
+	private:
+
+		/**
+		*  Layout::PositionBuffer::Frame frames[3]
+		*  \brief back, ready and front frame
+		*/
+		Frame frames[3];
+
+		/**
+		*  QAtomicInt ready
+		*  \brief index of ready frame, FRESH bit is set if reader has not acquired it yet
+		*/
+		QAtomicInt ready;
+
+		/**
+		*  QAtomicInt published
+		*  \brief sequence number of the newest published frame
+		*/
+		QAtomicInt published;
+
+		/**
+		*  int back
+		*  \brief index of frame filled by writer
+		*/
+		int back;
+
+		/**
+		*  int front
+		*  \brief index of frame read by reader
+		*/
+		int front;
+
+		/**
+		*  int sequence
+		*  \brief sequence number of the last published frame, used by writer
+		*/
+		int sequence;
+
+		/**
+		*  static const int FRESH
+		*  \brief bit of ready marking frame not acquired yet
+		*/
+		static const int FRESH = 4;
+	};
+}
+
+#endif
@@ -0,0 +1,293 @@
+/**
+*  SpatialGrid.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_SPATIAL_GRID_DEF
+#define LAYOUT_SPATIAL_GRID_DEF 1
+
+#include <vector>
+#include <QHash>
+
+namespace Layout
+{
+	/**
+	*  \class SpatialGrid
+	*
+	*  \brief Uniform grid of cubic cells used by repulsive forces limited by maximal distance
+	*
+	*	If the cell size equals to the maximal distance, all nodes repulsing a node lie in its cell or in one of 26
+	*	neighbouring cells. Cells are stored in hash table, so only occupied cells use memory. The grid is updated
+	*	incrementally, only nodes which crossed border of their cell are moved to another cell. After every update
+	*	coordinates of nodes are copied into arrays ordered by cells, so each cell is a contiguous range usable
+	*	by vectorized force kernels.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class SpatialGrid
+	{
+	public:
+
+		/**
+		*  \fn public constructor  SpatialGrid
+		*  \brief Creates empty grid
+		*/
+		SpatialGrid();
+
+		/**
+		*  \fn public  setCellSize(float size)
+		*  \brief Sets edge length of cells, grid is emptied if the size changes
+		*  \param  size  edge length of cells
+		*/
+		void setCellSize(float size);
+
+		/**
+		*  \fn inline public constant  getCellSize
+		*  \brief Returns edge length of cells
+		*  \return float edge length of cells
+		*/
+		float getCellSize() const { return cellSize; }
+
+		/**
+		*  \fn public  clear
+		*  \brief Removes all nodes and cells
+		*/
+		void clear();
+
+		/**
+		*  \fn public  update(const float *x, const float *y, const float *z, int count)
+		*  \brief Moves nodes which changed their cell and copies their coordinates into arrays ordered by cells
+		*
+		*	If the count of nodes changed, the grid is built again.
+		*
+		*  \param  x, y, z  positions of nodes
+		*  \param  count  count of nodes
+		*/
+		void update(const float *x, const float *y, const float *z, int count);
+
+		/**
+		*  \fn public  move(int node, float x, float y, float z)
+		*  \brief Moves one node into cell containing its new position, arrays ordered by cells are not updated
+		*  \param  node  index of node
+		*  \param  x, y, z  new position of node
+		*/
+		void move(int node, float x, float y, float z);
+
+		/**
+		*  \fn public constant  collectNear(float x, float y, float z, std::vector<int> &result)
+		*  \brief Appends nodes of the cell containing position and of its 26 neighbouring cells
+		*  \param  x, y, z  position
+		*  \param  result  indices of found nodes
+		*/
+		void collectNear(float x, float y, float z, std::vector<int> &result) const;
+
+		/**
+		*  \fn inline public constant  getCellOf(int node)
+		*  \brief Returns cell containing node
+		*  \param  node  index of node
+		*  \return int index of cell
+		*/
+		int getCellOf(int node) const { return cellOf[node]; }
+
+		/**
+		*  \fn inline public constant  getNeighbourBegin(int cell)
+		*  \brief Returns position of the first occupied neighbour of cell (including the cell itself) in getNeighbours()
+		*  \param  cell  index of cell
+		*  \return int position of the first neighbour
+		*/
+		int getNeighbourBegin(int cell) const { return neighbourOffsets[cell]; }
+
+		/**
+		*  \fn inline public constant  getNeighbourEnd(int cell)
+		*  \brief Returns position after the last occupied neighbour of cell in getNeighbours()
+		*  \param  cell  index of cell
+		*  \return int position after the last neighbour
+		*/
+		int getNeighbourEnd(int cell) const { return neighbourOffsets[cell + 1]; }
+
+		/**
+		*  \fn inline public constant  getNeighbours
+		*  \brief Returns occupied neighbouring cells of all cells
+		*  \return const int * indices of cells
+		*/
+		const int *getNeighbours() const { return neighbours.empty() ? NULL : &neighbours[0]; }
+
+		/**
+		*  \fn inline public constant  getBegin(int cell)
+		*  \brief Returns position of the first node of cell in arrays ordered by cells
+		*  \param  cell  index of cell
+		*  \return int position of the first node
+		*/
+		int getBegin(int cell) const { return cellOffsets[cell]; }
+
+		/**
+		*  \fn inline public constant  getEnd(int cell)
+		*  \brief Returns position after the last node of cell in arrays ordered by cells
+		*  \param  cell  index of cell
+		*  \return int position after the last node
+		*/
+		int getEnd(int cell) const { return cellOffsets[cell + 1]; }
+
+		/**
+		*  \fn inline public constant  getX
+		*  \brief Returns x coordinates of nodes ordered by cells
+		*  \return const float * coordinates
+		*/
+		const float *getX() const { return sortedX.empty() ? NULL : &sortedX[0]; }
+
+		/**
+		*  \fn inline public constant  getY
+		*  \brief Returns y coordinates of nodes ordered by cells
+		*  \return const float * coordinates
+		*/
+		const float *getY() const { return sortedY.empty() ? NULL : &sortedY[0]; }
+
+		/**
+		*  \fn inline public constant  getZ
+		*  \brief Returns z coordinates of nodes ordered by cells
+		*  \return const float * coordinates
+		*/
+		const float *getZ() const { return sortedZ.empty() ? NULL : &sortedZ[0]; }
+
+		/**
+		*  \fn inline public constant  getNodes
+		*  \brief Returns indices of nodes ordered by cells
+		*  \return const int * indices of nodes
+		*/
+		const int *getNodes() const { return sortedNodes.empty() ? NULL : &sortedNodes[0]; }
+
+		/**
+		*  \fn inline public constant  getMovedCount
+		*  \brief Returns count of nodes which changed cell during the last update
+		*  \return int count of moved nodes
+		*/
+		int getMovedCount() const { return moved; }
+
+	private:
+
+		/**
+		*  float cellSize
+		*  \brief edge length of cells
+		*/
+		float cellSize;
+
+		/**
+		*  QHash<qlonglong, int> cellIndex
+		*  \brief index of cell by its key made of integer coordinates
+		*/
+		QHash<qlonglong, int> cellIndex;
+
+		/**
+		*  std::vector<qlonglong> cellKeys
+		*  \brief key of every cell
+		*/
+		std::vector<qlonglong> cellKeys;
+
+		/**
+		*  std::vector<std::vector<int> > members
+		*  \brief nodes of every cell
+		*/
+		std::vector<std::vector<int> > members;
+
+		/**
+		*  std::vector<int> cellOf
+		*  \brief cell of every node
+		*/
+		std::vector<int> cellOf;
+
+		/**
+		*  std::vector<int> slotOf
+		*  \brief position of every node in members of its cell
+		*/
+		std::vector<int> slotOf;
+
+		/**
+		*  int emptyCells
+		*  \brief count of cells without nodes
+		*/
+		int emptyCells;
+
+		/**
+		*  int moved
+		*  \brief count of nodes which changed cell during the last update
+		*/
+		int moved;
+
+		/**
+		*  std::vector<int> cellOffsets
+		*  \brief position of the first node of every cell in arrays ordered by cells
+		*/
+		std::vector<int> cellOffsets;
+
+		/**
+		*  std::vector<int> neighbourOffsets
+		*  \brief position of the first neighbour of every cell in neighbours
+		*/
+		std::vector<int> neighbourOffsets;
+
+		/**
+		*  std::vector<int> neighbours
+		*  \brief occupied neighbouring cells of all cells
+		*/
+		std::vector<int> neighbours;
+
+		/**
+		*  std::vector<float> sortedX, sortedY, sortedZ
+		*  \brief coordinates of nodes ordered by cells
+		*/
+		std::vector<float> sortedX, sortedY, sortedZ;
+
+		/**
+		*  std::vector<int> sortedNodes
+		*  \brief indices of nodes ordered by cells
+		*/
+		std::vector<int> sortedNodes;
+
+		/**
+		*  \fn private constant  keyOf(float x, float y, float z)
+		*  \brief Returns key of cell containing position
+		*  \param  x, y, z  position
+		*  \return qlonglong key of cell
+		*/
+		qlonglong keyOf(float x, float y, float z) const;
+
+		/**
+		*  \fn private static  makeKey(int i, int j, int k)
+		*  \brief Returns key of cell with integer coordinates
+		*  \param  i, j, k  integer coordinates of cell
+		*  \return qlonglong key of cell
+		*/
+		static qlonglong makeKey(int i, int j, int k);
+
+		/**
+		*  \fn private  insert(int node, qlonglong key)
+		*  \brief Inserts node into cell with key, the cell is created if needed
+		*  \param  node  index of node
+		*  \param  key  key of cell
+		*/
+		void insert(int node, qlonglong key);
+
+		/**
+		*  \fn private  remove(int node)
+		*  \brief Removes node from its cell
+		*  \param  node  index of node
+		*/
+		void remove(int node);
+
+		/**
+		*  \fn private  rebuild(const float *x, const float *y, const float *z, int count)
+		*  \brief Builds the grid from scratch
+		*  \param  x, y, z  positions of nodes
+		*  \param  count  count of nodes
+		*/
+		void rebuild(const float *x, const float *y, const float *z, int count);
+
+		/**
+		*  \fn private  pack(const float *x, const float *y, const float *z)
+		*  \brief Copies coordinates into arrays ordered by cells and finds occupied neighbours of cells
+		*  \param  x, y, z  positions of nodes
+		*/
+		void pack(const float *x, const float *y, const float *z);
+	};
+}
+
+#endif
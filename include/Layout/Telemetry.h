@@ -0,0 +1,158 @@
+/**
+*  Telemetry.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_TELEMETRY_DEF
+#define LAYOUT_TELEMETRY_DEF 1
+
+#include <vector>
+#include <QMutex>
+#include <QString>
+
+namespace Layout
+{
+	/**
+	*  \class Telemetry
+	*
+	*  \brief Ring buffer of measurements of the last iterations of layout
+	*
+	*	Layout thread records one sample per iteration, GUI or batch tool reads copies of samples at any time.
+	*	Buffer grows up to its capacity, then the oldest samples are overwritten.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class Telemetry
+	{
+	public:
+
+		/**
+		*  \struct Sample
+		*  \brief Measurements of one iteration
+		*/
+		struct Sample
+		{
+			/**
+			*  int iteration
+			*  \brief index of iteration since the graph was set, starting with 1
+			*/
+			int iteration;
+
+			/**
+			*  float repulsionMs
+			*  \brief duration of repulsive forces including octrees or grid, in active set mode all forces of active nodes
+			*/
+			float repulsionMs;
+
+			/**
+			*  float attractionMs
+			*  \brief duration of attractive forces of edges and meta edges and of summing forces of workers
+			*/
+			float attractionMs;
+
+			/**
+			*  float applyMs
+			*  \brief duration of moving nodes and packing of components
+			*/
+			float applyMs;
+
+			/**
+			*  double energy
+			*  \brief total kinetic energy of nodes after iteration, nodes have unit mass
+			*/
+			double energy;
+
+			/**
+			*  float maxDisplacement
+			*  \brief the longest move of node
+			*/
+			float maxDisplacement;
+
+			/**
+			*  float meanDisplacement
+			*  \brief mean move of nodes whose forces were applied
+			*/
+			float meanDisplacement;
+
+			/**
+			*  int moved
+			*  \brief count of nodes which moved
+			*/
+			int moved;
+		};
+
+		/**
+		*  int DEFAULT_CAPACITY
+		*  \brief count of kept samples, if capacity is not set
+		*/
+		static const int DEFAULT_CAPACITY = 1024;
+
+		/**
+		*  \fn public constructor  Telemetry
+		*  \brief Creates empty buffer with DEFAULT_CAPACITY
+		*/
+		Telemetry();
+
+		/**
+		*  \fn public  setCapacity(int capacity)
+		*  \brief Sets count of kept samples and removes all samples
+		*  \param  capacity  count of kept samples
+		*/
+		void setCapacity(int capacity);
+
+		/**
+		*  \fn public  record(const Sample &sample)
+		*  \brief Appends sample, overwrites the oldest sample if buffer is full
+		*  \param  sample  measurements of iteration
+		*/
+		void record(const Sample &sample);
+
+		/**
+		*  \fn public constant  getSamples(std::vector<Sample> &samples)
+		*  \brief Copies kept samples from the oldest one
+		*  \param  samples  copied samples
+		*/
+		void getSamples(std::vector<Sample> &samples) const;
+
+		/**
+		*  \fn public  clear
+		*  \brief Removes all samples
+		*/
+		void clear();
+
+		/**
+		*  \fn public constant  writeCsv(const QString &path)
+		*  \brief Writes kept samples as CSV with header
+		*  \param  path  path of written file
+		*  \return bool true, if file was written
+		*/
+		bool writeCsv(const QString &path) const;
+
+	private:
+
+		/**
+		*  std::vector<Sample> samples
+		*  \brief kept samples, samples[next] is the oldest one if buffer is full
+		*/
+		std::vector<Sample> samples;
+
+		/**
+		*  int next
+		*  \brief position of the next sample in full buffer
+		*/
+		int next;
+
+		/**
+		*  int capacity
+		*  \brief count of kept samples
+		*/
+		int capacity;
+
+		/**
+		*  QMutex mutex
+		*  \brief guards samples and next
+		*/
+		mutable QMutex mutex;
+	};
+}
+
+#endif
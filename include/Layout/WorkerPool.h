@@ -0,0 +1,158 @@
+/**
+*  WorkerPool.h
+*  Projekt 3DVisual
+*/
+#ifndef LAYOUT_WORKER_POOL_DEF
+#define LAYOUT_WORKER_POOL_DEF 1
+
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSemaphore>
+
+namespace Layout
+{
+	/**
+	*  \class ParallelTask
+	*  \brief Work which can be split into contiguous ranges processed by workers of WorkerPool
+	*/
+	class ParallelTask
+	{
+	public:
+
+		/**
+		*  \fn public virtual destructor  ~ParallelTask
+		*  \brief Destroys the task
+		*/
+		virtual ~ParallelTask() {}
+
+		/**
+		*  \fn public pure virtual  run(int worker, int begin, int end)
+		*  \brief Processes items [begin, end)
+		*  \param  worker  index of worker, range processed by worker is always the same for same count of items
+		*  \param  begin  first processed item
+		*  \param  end  item after the last processed item
+		*/
+		virtual void run(int worker, int begin, int end) = 0;
+	};
+
+	/**
+	*  \class MemberTask
+	*  \brief ParallelTask calling member function void T::fn(int worker, int begin, int end)
+	*/
+	template <class T>
+	class MemberTask : public ParallelTask
+	{
+	public:
+
+		/**
+		*  \fn public constructor  MemberTask(T *object, void (T::*function)(int, int, int))
+		*  \brief Creates task calling function of object
+		*  \param  object  called object
+		*  \param  function  called member function
+		*/
+		MemberTask(T *object, void (T::*function)(int, int, int)) : object(object), function(function) {}
+
+		void run(int worker, int begin, int end) { (object->*function)(worker, begin, end); }
+
+	private:
+
+		/**
+		*  T * object
+		*  \brief called object
+		*/
+		T *object;
+
+		/**
+		*  void (T::*function)(int, int, int)
+		*  \brief called member function
+		*/
+		void (T::*function)(int, int, int);
+	};
+
+	/**
+	*  \class WorkerPool
+	*
+	*  \brief Fixed number of workers which process one ParallelTask at a time
+	*
+	*	Items of task are split into as many contiguous ranges as there are workers. The split depends only
+	*	on count of items and count of workers, so results merged in worker order are deterministic.
+	*/
+	class WorkerPool
+	{
+	public:
+
+		/**
+		*  \fn public constructor  WorkerPool(int threadCount = 0)
+		*  \brief Creates pool of workers
+		*  \param  threadCount  count of workers, 0 means count of hardware threads
+		*/
+		WorkerPool(int threadCount = 0);
+
+		/**
+		*  \fn public destructor  ~WorkerPool
+		*  \brief Waits for workers and destroys the pool
+		*/
+		~WorkerPool();
+
+		/**
+		*  \fn inline public constant  getThreadCount
+		*  \brief Returns count of workers
+		*  \return int count of workers
+		*/
+		int getThreadCount() const { return threadCount; }
+
+		/**
+		*  \fn public  run(Layout::ParallelTask *task, int count)
+		*  \brief Processes items [0, count) of task by all workers and waits until they are done
+		*
+		*	Range of the first worker is processed by the calling thread.
+		*
+		*  \param  task  processed task
+		*  \param  count  count of items
+		*/
+		void run(Layout::ParallelTask *task, int count);
+
+		/**
+		*  \fn public  run(Layout::ParallelTask *task, int begin, int end)
+		*  \brief Processes items [begin, end) of task by all workers and waits until they are done, used to process task in parts
+		*  \param  task  processed task
+		*  \param  begin  first item
+		*  \param  end  item after the last item
+		*/
+		void run(Layout::ParallelTask *task, int begin, int end);
+
+		/**
+		*  \fn public static  getRange(int worker, int workers, int count, int &begin, int &end)
+		*  \brief Computes range of items processed by worker
+		*  \param  worker  index of worker
+		*  \param  workers  count of workers
+		*  \param  count  count of items
+		*  \param  begin  first item of range
+		*  \param  end  item after the last item of range
+		*/
+		static void getRange(int worker, int workers, int count, int &begin, int &end);
+
+	private:
+
+		/**
+		*  int threadCount
+		*  \brief count of workers
+		*/
+		int threadCount;
+
+		/**
+		*  QThreadPool pool
+		*  \brief threads of workers, except of the calling thread
+		*/
+		QThreadPool pool;
+
+		/**
+		*  QSemaphore done
+		*  \brief released once by every finished range
+		*/
+		QSemaphore done;
+	};
+}
+
+#endif
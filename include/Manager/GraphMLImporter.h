@@ -0,0 +1,118 @@
+/*!
+ * GraphMLImporter.h
+ * Projekt 3DVisual
+ */
+#ifndef Manager_GRAPHML_IMPORTER_DEF
+#define Manager_GRAPHML_IMPORTER_DEF 1
+
+#include <QMap>
+#include <QString>
+#include <QtXml/QDomDocument>
+#include <QtXml/QDomElement>
+#include <QFile>
+
+#include "Data/Graph.h"
+
+namespace Manager
+{
+    /**
+     * \class GraphMLImporter
+     * \brief Reads nodes, edges and their types from GraphML file into graph.
+     *
+     * Data of nodes and edges are stored in attribute columns of graph, keys declared in the file keep their type.
+     *
+     * Importer does not use database, layout or window, so it can be used by the application and by the headless
+     * batch layout tool.
+     *
+     * \date 18. 10. 2026
+     */
+    class GraphMLImporter
+	{
+	public:
+
+            /**
+             * \class Progress
+             * \brief Receiver of progress of import, the application shows it in progress bar.
+             */
+            class Progress
+            {
+            public:
+                virtual ~Progress() {}
+
+                /**
+                 * \fn public setValue(int value)
+                 * \brief Called after every hundredth of nodes and edges.
+                 * \param value  percentage of read nodes and edges
+                 */
+                virtual void setValue(int value) = 0;
+            };
+
+            /**
+             * \fn public constructor GraphMLImporter(QString filepath)
+             * \brief Opens and parses GraphML file.
+             * \param filepath  path to GraphML file
+             */
+            GraphMLImporter(QString filepath);
+
+            /**
+             * \fn inline public constant isValid
+             * \brief Returns true, if the file is valid GraphML file with graph element.
+             */
+            bool isValid() const { return !rootElement.isNull(); }
+
+            /**
+             * \fn public constant getGraphName
+             * \brief Returns name of graph created from id of graph element.
+             */
+            QString getGraphName() const;
+
+            /**
+             * \fn public import(Data::Graph *graph, Progress *progress)
+             * \brief Adds nodes, edges and types of the file into graph.
+             * \param graph  graph, usually empty
+             * \param progress  receives progress of import, if not NULL
+             * \return bool true, if the file was valid
+             */
+            bool import(Data::Graph *graph, Progress *progress = NULL);
+
+            /**
+             * \fn inline public constant getNodes
+             * \brief Returns imported nodes by their GraphML id.
+             */
+            const QMap<QString, osg::ref_ptr<Data::Node> > &getNodes() const { return readNodes; }
+
+            /**
+             * \fn inline public constant getSkippedEdgeCount
+             * \brief Returns count of edges of the last import, which were skipped because their source or target node does not exist.
+             */
+            int getSkippedEdgeCount() const { return skippedEdges; }
+
+	private:
+
+            /**
+             * QDomDocument doc
+             * \brief parsed GraphML document
+             */
+            QDomDocument doc;
+
+            /**
+             * QDomElement rootElement
+             * \brief graph element, null if the file is not valid
+             */
+            QDomElement rootElement;
+
+            /**
+             * QMap<QString, osg::ref_ptr<Data::Node> > readNodes
+             * \brief imported nodes by their GraphML id
+             */
+            QMap<QString, osg::ref_ptr<Data::Node> > readNodes;
+
+            /**
+             * int skippedEdges
+             * \brief count of skipped edges of the last import
+             */
+            int skippedEdges;
+	};
+}
+
+#endif
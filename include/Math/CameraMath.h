@@ -1,6 +1,7 @@
 #pragma once
 
 #include <osg/Vec3d>
+#include <osg/Camera>
 #include <osg/ref_ptr>
 #include <QVector>
 #include <QLinkedList>
@@ -27,6 +27,7 @@
 #include "Viewer/NodeGroup.h"
 
 #include "Layout/Layout.h"
+#include "Layout/LayoutThread.h"
 #include "Util/ApplicationConfig.h"
 #include "Data/Edge.h"
 #include "Data/Node.h"
@@ -123,13 +124,8 @@ namespace Vwr
 		{ 
 			this->camera = camera; 
 
-			QMapIterator<qlonglong, osg::ref_ptr<Data::Edge> > i(*in_edges);
-
-			while (i.hasNext()) 
-			{
-				i.next();
-				i.value()->setCamera(camera);
-			}
+			edgesGroup->setCamera(camera);
+			qmetaEdgesGroup->setCamera(camera);
 		} 
 
 		osg::ref_ptr<osg::Camera> getCamera() { return camera; }
@@ -165,10 +161,22 @@ namespace Vwr
 		void setNodesFreezed(bool val) 
 		{ 
 			this->nodesFreezed = val; 
+			this->settleFrames = -1;
 			nodesGroup->freezeNodePositions();
 			qmetaNodesGroup->freezeNodePositions();
 		}
 
+		/**
+		*  \fn inline public  setLayoutThread(Layout::LayoutThread * val)
+		*  \brief Sets layout thread, whose positions are shown
+		*  \param      val     layout thread
+		*/
+		void setLayoutThread(Layout::LayoutThread * val)
+		{
+			this->layoutThread = val;
+			this->settleFrames = -1;
+		}
+
 	private:
 
 		/**
@@ -204,28 +212,28 @@ namespace Vwr
 		Data::Graph * graph;
 
 		/**
-		*  QMap<qlonglong,osg::ref_ptr<Data::Node> > * in_nodes
-		*  \brief graph nodes map
+		*  const Data::Graph::NodeStore * in_nodes
+		*  \brief graph nodes store
 		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Node> > *in_nodes;
+		const Data::Graph::NodeStore *in_nodes;
 
 		/**
-		*  QMap<qlonglong,osg::ref_ptr<Data::Edge> > * in_edges
-		*  \brief graph edges map
+		*  const Data::Graph::EdgeStore * in_edges
+		*  \brief graph edges store
 		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Edge> > *in_edges;
+		const Data::Graph::EdgeStore *in_edges;
 
 		/**
-		*  QMap<qlonglong,osg::ref_ptr<Data::Node> > * qmetaNodes
-		*  \brief graph metanodes map
+		*  const Data::Graph::NodeStore * qmetaNodes
+		*  \brief graph metanodes store
 		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Node> > *qmetaNodes;
+		const Data::Graph::NodeStore *qmetaNodes;
 
 		/**
-		*  QMap<qlonglong,osg::ref_ptr<Data::Edge> > * qmetaEdges
-		*  \brief graph metaedges map
+		*  const Data::Graph::EdgeStore * qmetaEdges
+		*  \brief graph metaedges store
 		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Edge> > *qmetaEdges;
+		const Data::Graph::EdgeStore *qmetaEdges;
 		
 
 		/**
@@ -234,6 +242,12 @@ namespace Vwr
 		*/
 		Util::ApplicationConfig* appConf;
 
+		/**
+		*  Layout::LayoutThread * layoutThread
+		*  \brief layout thread, which gives positions of nodes, NULL until it is set
+		*/
+		Layout::LayoutThread * layoutThread;
+
 
 		/**
 		*  \fn private  initEdgeLabels
@@ -277,6 +291,24 @@ namespace Vwr
 		*/
 		bool nodesFreezed;
 
+		/**
+		*  int frameSequence
+		*  \brief sequence number of the last frame of layout applied to nodes
+		*/
+		int frameSequence;
+
+		/**
+		*  int editCount
+		*  \brief count of user edits reported to layout during the last update
+		*/
+		int editCount;
+
+		/**
+		*  int settleFrames
+		*  \brief count of updates until nodes reach their target positions, -1 if it has to be computed
+		*/
+		int settleFrames;
+
 
 		/**
 		*  QLinkedList<osg::ref_ptr<osg::Node> > customNodeList
@@ -75,10 +75,49 @@ namespace Vwr
                 /**
                  * \brief Vygeneruje jednoduhcy graf - Valec so specifikovanymi rozmermi
                  *
+                 * \param graph                 graf, do ktoreho sa valec prida
                  * \param pocetUzlovNaPodstave  pocet uzlov na podstave
                  * \param pocetUzlovNaVysku     pocet uzlov na vysku valca
                  **/
-                static void generateCylinder(QMap<qlonglong, osg::ref_ptr<Data::Node> > *nodes, QMap<qlonglong, osg::ref_ptr<Data::Edge> > *edges,QMap<qlonglong, Data::Type*> *types, int pocetUzlovNaPodstave, int pocetUzlovNaVysku);
+                static void generateCylinder(Data::Graph *graph, int pocetUzlovNaPodstave, int pocetUzlovNaVysku);
+
+		/**
+		*  \fn public static  generateGrid(Data::Graph *graph, int width, int height)
+		*  \brief Adds planar grid of width x height nodes into graph
+		*  \param      graph     graph
+		*  \param      width     count of nodes in row
+		*  \param      height     count of rows
+		*/
+		static void generateGrid(Data::Graph *graph, int width, int height);
+
+		/**
+		*  \fn public static  generateTree(Data::Graph *graph, int count, int branching)
+		*  \brief Adds complete tree into graph, nodes are added level by level
+		*  \param      graph     graph
+		*  \param      count     count of nodes
+		*  \param      branching     count of children of inner node
+		*/
+		static void generateTree(Data::Graph *graph, int count, int branching);
+
+		/**
+		*  \fn public static  generateErdosRenyi(Data::Graph *graph, int count, float averageDegree, unsigned int seed)
+		*  \brief Adds random graph with uniformly chosen edges (Erdos-Renyi G(n, m)) into graph
+		*  \param      graph     graph
+		*  \param      count     count of nodes
+		*  \param      averageDegree     average degree of node, count of edges is count * averageDegree / 2
+		*  \param      seed     seed of random generator
+		*/
+		static void generateErdosRenyi(Data::Graph *graph, int count, float averageDegree, unsigned int seed);
+
+		/**
+		*  \fn public static  generateBarabasiAlbert(Data::Graph *graph, int count, int edgesPerNode, unsigned int seed)
+		*  \brief Adds scale-free graph created by preferential attachment (Barabasi-Albert) into graph
+		*  \param      graph     graph
+		*  \param      count     count of nodes
+		*  \param      edgesPerNode     count of edges of every new node to existing nodes
+		*  \param      seed     seed of random generator
+		*/
+		static void generateBarabasiAlbert(Data::Graph *graph, int count, int edgesPerNode, unsigned int seed);
 
                 /**
                  * \brief Vygeneruje testovaciu scenu pozostavajucu z niekolkych samostatnych grafov
@@ -115,6 +154,16 @@ namespace Vwr
 		*/
 		static int getRandomNumber(int lowest, int highest);
 
+		/**
+		*  \fn public static  getRandomIndex(unsigned int seed, unsigned int position, int count)
+		*  \brief Returns pseudorandom index from 0 .. count - 1 given by seed and position in sequence, does not use rand()
+		*  \param      seed     seed of sequence
+		*  \param      position     position in sequence
+		*  \param      count     count of indices
+		*  \return int random index
+		*/
+		static int getRandomIndex(unsigned int seed, unsigned int position, int count);
+
 
 		/**
 		*  \fn public static  getMassCenter(osg::ref_ptr<osg::Vec3Array> coordinates
@@ -8,11 +8,18 @@
 #include <osg/ref_ptr>
 #include <osg/Group>
 #include <osg/AutoTransform>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/BlendFunc>
+#include <osg/Depth>
+#include <osg/Camera>
 
 #include <QMap>
 
 #include "Data/Edge.h"
+#include "Data/Graph.h"
 #include "Viewer/TextureWrapper.h"
+#include "Viewer/EdgeProxy.h"
 
 namespace Vwr
 {
@@ -27,12 +34,13 @@ namespace Vwr
 	public:
 
 		/**
-		*  \fn public constructor  EdgeGroup(QMap<qlonglong, osg::ref_ptr<Data::Edge> > *edges, float scale)
+		*  \fn public constructor  EdgeGroup(const Data::Graph::EdgeStore *edges, float scale, osg::ref_ptr<osg::Camera> camera = 0)
 		*  \brief Creates edge group
 		*  \param edges     edges to wrap
 		*  \param scale     edges scale
+		*  \param camera    current camera used in viewer
 		*/
-		EdgeGroup(QMap<qlonglong, osg::ref_ptr<Data::Edge> > *edges, float scale);
+		EdgeGroup(const Data::Graph::EdgeStore *edges, float scale, osg::ref_ptr<osg::Camera> camera = 0);
 
 		/**
 		*  \fn public destructor  ~EdgeGroup
@@ -49,10 +57,17 @@ namespace Vwr
 
 		/**
 		*  \fn public  synchronizeEdges
-		*  \brief synchronizes drawn edges with wrapped edge map
+		*  \brief synchronizes drawn edges with wrapped edge store
 		*/
 		void synchronizeEdges();
 
+		/**
+		*  \fn public  setCamera(osg::ref_ptr<osg::Camera> camera)
+		*  \brief Sets current viewing camera to all drawn edges
+		*  \param     camera     current camera
+		*/
+		void setCamera(osg::ref_ptr<osg::Camera> camera);
+
 
 		/**
 		*  \fn inline public  getGroup
@@ -64,10 +79,10 @@ namespace Vwr
 	private:
 
 		/**
-		*  QMap<qlonglong,osg::ref_ptr<Data::Edge> > * edges 
+		*  const Data::Graph::EdgeStore * edges 
 		*  \brief Wrpped edges
 		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Edge> > *edges;
+		const Data::Graph::EdgeStore *edges;
 
 
 		/**
@@ -76,6 +91,12 @@ namespace Vwr
 		*/
 		float scale;
 
+		/**
+		*  osg::ref_ptr camera
+		*  \brief Current camera used in viewer. It is used for billboarding purposes.
+		*/
+		osg::ref_ptr<osg::Camera> camera;
+
 
 		/**
 		*  osg::ref_ptr edgeGroup
@@ -116,7 +137,7 @@ namespace Vwr
 		void initEdges();
 
 		/**
-		*  \fn private  getEdgeCoordinatesAndColors(osg::ref_ptr<Data::Edge> edge, int first, osg::ref_ptr<osg::Vec3Array> coordinates,osg::ref_ptr<osg::Vec2Array> edgeTexCoords,osg::ref_ptr<osg::Vec4Array> colors,osg::ref_ptr<osg::Vec4Array> orientedEdgeColors)
+		*  \fn private  getEdgeCoordinatesAndColors(Data::Edge * edge, int first, osg::ref_ptr<osg::Vec3Array> coordinates,osg::ref_ptr<osg::Vec2Array> edgeTexCoords,osg::ref_ptr<osg::Vec4Array> colors,osg::ref_ptr<osg::Vec4Array> orientedEdgeColors)
 		*  \brief Adds coordinates to coordinates array, texture coordinates and colors for given edge
 		*  \param      edge     edge
 		*  \param      first     first coordinate position in array
@@ -125,7 +146,7 @@ namespace Vwr
 		*  \param      colors    color array
 		*  \param      orientedEdgeColors   oriented edge color array
 		*/
-		void getEdgeCoordinatesAndColors(osg::ref_ptr<Data::Edge> edge, int first, 
+		void getEdgeCoordinatesAndColors(Data::Edge * edge, int first, 
 											osg::ref_ptr<osg::Vec3Array> coordinates, 
 											osg::ref_ptr<osg::Vec2Array> edgeTexCoords,
 											osg::ref_ptr<osg::Vec4Array> colors,
@@ -136,6 +157,14 @@ namespace Vwr
 		*  \brief creates edge statesets
 		*/
 		void createEdgeStateSets();
+
+		/**
+		*  \fn private  wrapEdge(Data::Edge * edge)
+		*  \brief Creates primitive set of the edge, if it does not exist yet
+		*  \param      edge     drawn edge
+		*  \return Vwr::EdgeProxy * primitive set of the edge
+		*/
+		Vwr::EdgeProxy * wrapEdge(Data::Edge * edge);
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,154 @@
+/**
+*  EdgeProxy.h
+*  Projekt 3DVisual
+*/
+#ifndef VIEWER_EDGE_PROXY_DEF
+#define VIEWER_EDGE_PROXY_DEF 1
+
+#include <osg/ref_ptr>
+#include <osg/Array>
+#include <osg/PrimitiveSet>
+#include <osg/Camera>
+#include <osgText/Text>
+#include <osgText/FadeText>
+
+#include <QString>
+
+#include "Util/ApplicationConfig.h"
+#include "Data/Edge.h"
+
+namespace Vwr
+{
+	/**
+	*  \class EdgeProxy
+	*  \brief Primitive set of a Data::Edge in the geometry of EdgeGroup
+	*
+	*	Data::Edge holds only data of the edge, EdgeGroup creates the proxy with EdgeProxy::create when it draws
+	*	the edge. Graphs used only by layout, analysis or export have no proxies.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class EdgeProxy : public osg::DrawArrays, public Data::EdgeView
+	{
+	public:
+
+		/**
+		*  \fn public static  create(Data::Edge * edge)
+		*  \brief Returns proxy of the edge, creates and attaches it, if the edge is not drawn yet
+		*  \param  edge    represented edge
+		*  \return Vwr::EdgeProxy * proxy of the edge
+		*/
+		static EdgeProxy * create(Data::Edge * edge);
+
+		/**
+		*  \fn inline public static  get(const Data::Edge * edge)
+		*  \param  edge    represented edge
+		*  \return Vwr::EdgeProxy * proxy of the edge, NULL if the edge is not drawn
+		*/
+		static EdgeProxy * get(const Data::Edge * edge) { return static_cast<EdgeProxy *>(edge->getView()); }
+
+		/**
+		*  \fn public constructor  EdgeProxy(Data::Edge * edge)
+		*  \brief Creates primitive set of the edge
+		*  \param  edge    represented edge
+		*/
+		EdgeProxy(Data::Edge * edge);
+
+		/**
+		*  \fn inline public constant  getEdge
+		*  \brief Returns represented edge
+		*  \return Data::Edge * represented edge, NULL if the edge was already destroyed
+		*/
+		Data::Edge * getEdge() const { return edge; }
+
+		/**
+		*  \fn inline public  detach
+		*  \brief Unlinks the proxy from the destroyed edge
+		*/
+		void detach() { edge = NULL; }
+
+		/**
+		*  \fn inline public constant  getCoordinates
+		*  \brief Returns coordinates of the Edge
+		*  \return osg::ref_ptr coordinates of the Edge
+		*/
+		osg::ref_ptr<osg::Vec3Array> getCoordinates() const { return coordinates; }
+
+		/**
+		*  \fn inline public constant  getEdgeTexCoords
+		*  \brief Returns Texture coordinates array.
+		*  \return osg::ref_ptr<osg::Vec2Array>
+		*/
+		osg::ref_ptr<osg::Vec2Array> getEdgeTexCoords() const { return edgeTexCoords; }
+
+		/**
+		*  \fn public  updateCoordinates(osg::Vec3 srcPos, osg::Vec3 dstNode)
+		*  \brief Updates coordinates of the Edge
+		*  \param    srcPos    new coordinates of the starting Node
+		*  \param   dstNode    new coordinates of the ending Node
+		*/
+		void updateCoordinates(osg::Vec3 srcPos, osg::Vec3 dstNode);
+
+		/**
+		*  \fn inline public constant  getCamera
+		*  \brief returns current camera looking at edge
+		*  \return osg::ref_ptr<osg::Camera>
+		*/
+		osg::ref_ptr<osg::Camera> getCamera() const { return camera; }
+
+		/**
+		*  \fn inline public  setCamera(osg::ref_ptr<osg::Camera> val)
+		*  \brief sets current camera used in viewer.
+		*  \param       val
+		*/
+		void setCamera(osg::ref_ptr<osg::Camera> val) { camera = val; }
+
+		/**
+		*  \fn public  createLabel(QString name)
+		*  \brief Creates new label
+		*  \param      name     new label
+		*  \return osg::ref_ptr added label
+		*/
+		osg::ref_ptr<osg::Drawable> createLabel(QString name);
+
+	private:
+
+		/**
+		*  Data::Edge * edge
+		*  \brief Represented edge, the edge owns the proxy
+		*/
+		Data::Edge * edge;
+
+		/**
+		*  osg::ref_ptr camera
+		*  \brief Current camera used in viewer. It is used for billboarding purposes.
+		*/
+		osg::ref_ptr<osg::Camera> camera;
+
+		/**
+		*  osg::ref_ptr coordinates
+		*  \brief Coordinates of the Edge
+		*/
+		osg::ref_ptr<osg::Vec3Array> coordinates;
+
+		/**
+		*  osg::ref_ptr<osg::Vec2Array> edgeTexCoords
+		*  \brief Texture coordinates array.
+		*/
+		osg::ref_ptr<osg::Vec2Array> edgeTexCoords;
+
+		/**
+		*  osg::ref_ptr label
+		*  \brief Label of the Edge
+		*/
+		osg::ref_ptr<osgText::FadeText> label;
+
+		/**
+		*  Util::ApplicationConfig * appConf
+		*  \brief ApplicationConfig
+		*/
+		Util::ApplicationConfig * appConf;
+	};
+}
+
+#endif
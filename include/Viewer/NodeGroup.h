@@ -13,6 +13,8 @@
 
 #include "Util/ApplicationConfig.h"
 #include "Data/Node.h"
+#include "Data/Graph.h"
+#include "Viewer/NodeProxy.h"
 
 namespace Vwr
 {
@@ -27,11 +29,11 @@ namespace Vwr
 	public:
 
 		/**
-		*  \fn public constructor  NodeGroup(QMap<qlonglong, osg::ref_ptr<Data::Node> > *nodes)
+		*  \fn public constructor  NodeGroup(const Data::Graph::NodeStore *nodes)
 		*  \brief Creates node group
 		*  \param  nodes    nodes to wrap
 		*/
-		NodeGroup(QMap<qlonglong, osg::ref_ptr<Data::Node> > *nodes);
+		NodeGroup(const Data::Graph::NodeStore *nodes);
 
 		/**
 		*  \fn public destructor  ~NodeGroup
@@ -49,7 +51,7 @@ namespace Vwr
 
 		/**
 		*  \fn public  synchronizeNodes
-		*  \brief Synchronizes all drawn nodes with given node map
+		*  \brief Synchronizes all drawn nodes with given node store
 		*/
 		void synchronizeNodes();
 
@@ -78,10 +80,10 @@ namespace Vwr
 	private:
 
 		/**
-		*  QMap<qlonglong,osg::ref_ptr<Data::Node> > * nodes 
+		*  const Data::Graph::NodeStore * nodes 
 		*  \brief wrapped nodes
 		*/
-		QMap<qlonglong, osg::ref_ptr<Data::Node> > *nodes;
+		const Data::Graph::NodeStore *nodes;
 
 		/**
 		*  QMap<qlonglong,osg::ref_ptr<osg::AutoTransform> > * nodeTransforms
@@ -0,0 +1,174 @@
+/**
+*  NodeProxy.h
+*  Projekt 3DVisual
+*/
+#ifndef VIEWER_NODE_PROXY_DEF
+#define VIEWER_NODE_PROXY_DEF 1
+
+#include <osg/ref_ptr>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/BlendFunc>
+#include <osg/Depth>
+#include <osg/CullFace>
+#include <osgText/Text>
+
+#include <QString>
+
+#include "Data/Node.h"
+
+namespace Data
+{
+	class Type;
+}
+
+namespace Vwr
+{
+	/**
+	*  \class NodeProxy
+	*  \brief Drawable representation of a Data::Node in the scene graph
+	*
+	*	Data::Node holds only data of the node, the viewer creates the proxy with NodeProxy::create when it adds
+	*	the node to scene graph. Graphs used only by layout, analysis or export have no proxies.
+	*
+	*  \date 18. 10. 2026
+	*/
+	class NodeProxy : public osg::Geode, public Data::NodeView
+	{
+	public:
+
+		/**
+		*  \fn public static  create(Data::Node * node)
+		*  \brief Returns proxy of the node, creates and attaches it, if the node is not drawn yet
+		*  \param  node    represented node
+		*  \return Vwr::NodeProxy * proxy of the node
+		*/
+		static NodeProxy * create(Data::Node * node);
+
+		/**
+		*  \fn inline public static  get(const Data::Node * node)
+		*  \param  node    represented node
+		*  \return Vwr::NodeProxy * proxy of the node, NULL if the node is not drawn
+		*/
+		static NodeProxy * get(const Data::Node * node) { return static_cast<NodeProxy *>(node->getView()); }
+
+		/**
+		*  \fn public constructor  NodeProxy(Data::Node * node)
+		*  \brief Creates drawables of the node
+		*  \param  node    represented node
+		*/
+		NodeProxy(Data::Node * node);
+
+		/**
+		*  \fn inline public constant  getNode
+		*  \brief Returns represented node
+		*  \return Data::Node * represented node, NULL if the node was already destroyed
+		*/
+		Data::Node * getNode() const { return node; }
+
+		/**
+		*  \fn inline public  detach
+		*  \brief Unlinks the proxy from the destroyed node
+		*/
+		void detach() { node = NULL; }
+
+		/**
+		*  \fn public  setColor(osg::Vec4 color)
+		*  \brief Sets color of the node drawable
+		*  \param     color     drawn color
+		*/
+		void setColor(osg::Vec4 color);
+
+		/**
+		*  \fn public  setFixed(bool fixed)
+		*  \brief Shows or hides square around fixed node
+		*  \param     fixed     node fixed state
+		*/
+		void setFixed(bool fixed);
+
+		/**
+		*  \fn public  showLabel(bool visible)
+		*  \brief If true, node name will be shown.
+		*  \param     visible     node name shown
+		*/
+		void showLabel(bool visible);
+
+		/**
+		*  \fn public  reloadConfig
+		*  \brief Recreates drawables from current configuration
+		*/
+		void reloadConfig();
+
+	private:
+
+		/**
+		*  Data::Node * node
+		*  \brief Represented node, the node owns the proxy
+		*/
+		Data::Node * node;
+
+		/**
+		*  QString labelText
+		*  \brief Text show in the label
+		*/
+		QString labelText;
+
+		/**
+		*  osg::ref_ptr label
+		*  \brief Label drawable
+		*/
+		osg::ref_ptr<osg::Drawable> label;
+
+		/**
+		*  osg::ref_ptr square
+		*  \brief Square drawable
+		*/
+		osg::ref_ptr<osg::Drawable> square;
+
+
+		/**
+		*  \fn private  setDrawableColor(int pos, osg::Vec4 color)
+		*  \brief Sets drawble color
+		*  \param     pos     drawable position
+		*  \param     color     drawable color
+		*/
+		void setDrawableColor(int pos, osg::Vec4 color);
+
+		/**
+		*  \fn private static  createNode(const float & scale, osg::StateSet* bbState)
+		*  \brief Creates node drawable
+		*  \param      scale    node scale
+		*  \param  bbState    node stateset
+		*  \return osg::ref_ptr node drawable
+		*/
+		static osg::ref_ptr<osg::Drawable> createNode(const float & scale, osg::StateSet* bbState);
+
+		/**
+		*  \fn private static  createStateSet(Data::Type * type = 0)
+		*  \brief Creates node stateset
+		*  \param   type     node type
+		*  \return osg::ref_ptr node stateset
+		*/
+		static osg::ref_ptr<osg::StateSet> createStateSet(Data::Type * type = 0);
+
+		/**
+		*  \fn private static  createLabel(const float & scale, QString name)
+		*  \brief Creates node label from name
+		*  \param      scale     label scale
+		*  \param       name     label text
+		*  \return osg::ref_ptr node label
+		*/
+		static osg::ref_ptr<osg::Drawable> createLabel(const float & scale, QString name);
+
+		/**
+		*  \fn private static  createSquare
+		*  \brief Creates square around node
+		*  \param  scale   square scale
+		*  \param  bbState     square stateset
+		*  \return osg::ref_ptr square drawable
+		*/
+		static osg::ref_ptr<osg::Drawable> createSquare(const float & scale, osg::StateSet* bbState);
+	};
+}
+
+#endif
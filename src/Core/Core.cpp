@@ -13,9 +13,10 @@ AppCore::Core::Core(QApplication * app)
     core = this;
 
     messageWindows = new QOSG::MessageWindows();
-    this->alg = new Layout::FRAlgorithm();
+    this->alg = Layout::LayoutEngine::create(Layout::LayoutEngine::resolve(Util::ApplicationConfig::get()->getValue("Layout.Engine"), NULL));
     this->thr = new Layout::LayoutThread(this->alg);
     this->cg = new Vwr::CoreGraph();
+    this->cg->setLayoutThread(this->thr);
     this->cw = new QOSG::CoreWindow(0, this->cg, app, this->thr);
     this->cw->resize(1024, 768);
     this->cw->show();
@@ -29,18 +30,24 @@ AppCore::Core::~Core()
 
 void AppCore::Core::restartLayout()
 {
-    // neviem preco sa tuto nejak dlho zastavi
-    if(this->thr->isRunning())
-    {
-        this->thr->terminate();
-        this->thr->wait();
-    }
+    // algoritmus skonci po aktualnej iteracii, spiace vlakno sa prebudi hned
+    this->thr->stop();
+    this->thr->wait();
     delete this->thr;
 
+    // engine sa vymeni, ak sa zmenilo nastavenie Layout.Engine alebo auto zvolilo iny engine pre novy graf
+    QString engine = Layout::LayoutEngine::resolve(Util::ApplicationConfig::get()->getValue("Layout.Engine"),
+        Manager::GraphManager::getInstance()->getActiveGraph());
+    if (engine != this->alg->GetName())
+    {
+        delete this->alg;
+        this->alg = Layout::LayoutEngine::create(engine);
+    }
     this->alg->SetGraph(Manager::GraphManager::getInstance()->getActiveGraph());
     this->alg->SetParameters(10,0.7,1,true);
     this->thr = new Layout::LayoutThread(this->alg);
     this->cw->setLayoutThread(thr);
+    this->cg->setLayoutThread(thr);
     this->cg->reload(Manager::GraphManager::getInstance()->getActiveGraph());
     this->thr->start();
 	this->thr->play();
@@ -0,0 +1,89 @@
+/*!
+ * Adjacency.cpp
+ * Projekt 3DVisual
+ */
+#include "Data/Adjacency.h"
+#include "Data/Graph.h"
+
+using namespace Data;
+
+Adjacency::Adjacency()
+{
+	version = -1;
+	nodeCount = 0;
+	plainEdgeCount = 0;
+	outOffsets.assign(1, 0);
+	inOffsets.assign(1, 0);
+}
+
+void Adjacency::build(Data::Graph *graph)
+{
+	version = graph->getTopologyVersion();
+	nodes.clear();
+	edges.clear();
+	index.clear();
+	edgeSrc.clear();
+	edgeDst.clear();
+
+	// rovnake poradie ako snimka layoutu: uzly, potom metauzly
+	const Data::Graph::NodeStore *nodeStores[2] = { &graph->getNodeStore(), &graph->getMetaNodeStore() };
+	int count = nodeStores[0]->size() + nodeStores[1]->size();
+	nodes.reserve(count);
+	index.reserve(count);
+	for (int l = 0; l < 2; l++)
+	{
+		for (int k = 0; k < nodeStores[l]->size(); k++)
+		{
+			Data::Node *node = nodeStores[l]->at(k).get();
+			index.insert(node->getId(), (int) nodes.size());
+			nodes.push_back(node);
+		}
+		if (l == 0)
+			nodeCount = (int) nodes.size();
+	}
+
+	const Data::Graph::EdgeStore *edgeStores[2] = { &graph->getEdgeStore(), &graph->getMetaEdgeStore() };
+	int edgeCount = edgeStores[0]->size() + edgeStores[1]->size();
+	edges.reserve(edgeCount);
+	edgeSrc.reserve(edgeCount);
+	edgeDst.reserve(edgeCount);
+	for (int l = 0; l < 2; l++)
+	{
+		for (int k = 0; k < edgeStores[l]->size(); k++)
+		{
+			Data::Edge *edge = edgeStores[l]->at(k).get();
+			int u = indexOf(edge->getSrcNode()->getId());
+			int v = indexOf(edge->getDstNode()->getId());
+			if (u == -1 || v == -1)
+				continue;
+			edges.push_back(edge);
+			edgeSrc.push_back(u);
+			edgeDst.push_back(v);
+		}
+		if (l == 0)
+			plainEdgeCount = (int) edges.size();
+	}
+
+	fill(count, edgeSrc, edgeDst, outOffsets, outNeighbours, outEdges);
+	fill(count, edgeDst, edgeSrc, inOffsets, inNeighbours, inEdges);
+}
+
+void Adjacency::fill(int count, const std::vector<int> &from, const std::vector<int> &to, std::vector<int> &offsets, std::vector<int> &neighbours, std::vector<int> &edgeIndices)
+{
+	offsets.assign(count + 1, 0);
+	for (size_t e = 0; e < from.size(); e++)
+		offsets[from[e] + 1]++;
+	for (int i = 0; i < count; i++)
+		offsets[i + 1] += offsets[i];
+
+	// hrany v skupine ostanu v poradi ich indexov
+	std::vector<int> next(offsets.begin(), offsets.end() - 1);
+	neighbours.resize(from.size());
+	edgeIndices.resize(from.size());
+	for (size_t e = 0; e < from.size(); e++)
+	{
+		int position = next[from[e]]++;
+		neighbours[position] = to[e];
+		edgeIndices[position] = (int) e;
+	}
+}
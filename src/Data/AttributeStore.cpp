@@ -0,0 +1,194 @@
+/*!
+ * AttributeStore.cpp
+ * Projekt 3DVisual
+ */
+#include "Data/AttributeStore.h"
+
+using namespace Data;
+
+AttributeStore::Type AttributeStore::parseType(const QString &graphMLType)
+{
+	if (graphMLType == "int" || graphMLType == "long")
+		return INTEGER;
+	if (graphMLType == "float" || graphMLType == "double")
+		return REAL;
+	if (graphMLType == "boolean")
+		return BOOLEAN;
+	return STRING;
+}
+
+int AttributeStore::addColumn(const QString &key, const QString &name, Type type, const QString &defaultValue)
+{
+	int index = getColumnIndex(key);
+	if (index != -1)
+		return index;
+
+	index = (int) columns.size();
+	columns.push_back(Column());
+	Column &column = columns.back();
+	column.key = key;
+	column.name = name;
+	column.type = type;
+	column.defaultValue = defaultValue;
+	columnIndex.insert(key, index);
+
+	int rows = getRowCount();
+	resizeColumn(column, rows);
+	if (!defaultValue.isEmpty())
+	{
+		for (int row = 0; row < rows; row++)
+			setValue(index, row, defaultValue);
+	}
+	return index;
+}
+
+int AttributeStore::addRow(qlonglong id)
+{
+	int row = getRow(id);
+	if (row != -1)
+		return row;
+
+	row = (int) ids.size();
+	ids.push_back(id);
+	rowIndex.insert(id, row);
+	for (size_t c = 0; c < columns.size(); c++)
+	{
+		resizeColumn(columns[c], row + 1);
+		if (!columns[c].defaultValue.isEmpty())
+			setValue((int) c, row, columns[c].defaultValue);
+	}
+	return row;
+}
+
+void AttributeStore::removeRow(qlonglong id)
+{
+	int row = getRow(id);
+	if (row == -1)
+		return;
+
+	// posledny riadok presunieme na miesto odstraneneho, stlpce ostanu bez dier
+	int last = (int) ids.size() - 1;
+	for (size_t c = 0; c < columns.size(); c++)
+	{
+		if (row != last)
+			copyRow(columns[c], last, row);
+		resizeColumn(columns[c], last);
+	}
+	rowIndex.remove(id);
+	if (row != last)
+	{
+		ids[row] = ids[last];
+		rowIndex.insert(ids[row], row);
+	}
+	ids.pop_back();
+}
+
+bool AttributeStore::setValue(int column, int row, const QString &text)
+{
+	Column &c = columns[column];
+	bool ok = true;
+	switch (c.type)
+	{
+		case STRING:
+		{
+			QHash<QString, int>::const_iterator code = c.codes.find(text);
+			if (code == c.codes.end())
+			{
+				code = c.codes.insert(text, (int) c.dictionary.size());
+				c.dictionary.push_back(text);
+			}
+			c.integers[row] = code.value();
+			break;
+		}
+		case INTEGER:
+			c.integers[row] = text.trimmed().toLongLong(&ok);
+			break;
+		case REAL:
+			c.reals[row] = text.trimmed().toDouble(&ok);
+			break;
+		case BOOLEAN:
+		{
+			QString value = text.trimmed().toLower();
+			if (value == "true" || value == "1")
+				c.integers[row] = 1;
+			else if (value == "false" || value == "0")
+				c.integers[row] = 0;
+			else
+				ok = false;
+			break;
+		}
+	}
+
+	if (ok)
+		c.nulls[row >> 5] &= ~(1u << (row & 31));
+	else
+		c.nulls[row >> 5] |= 1u << (row & 31);
+	return ok;
+}
+
+void AttributeStore::setNull(int column, int row)
+{
+	columns[column].nulls[row >> 5] |= 1u << (row & 31);
+}
+
+QString AttributeStore::getValue(int column, int row) const
+{
+	const Column &c = columns[column];
+	if (c.isNull(row))
+		return QString();
+
+	switch (c.type)
+	{
+		case STRING:
+			return c.dictionary[c.integers[row]];
+		case INTEGER:
+			return QString::number(c.integers[row]);
+		case REAL:
+			return QString::number(c.reals[row]);
+		case BOOLEAN:
+			return c.integers[row] != 0 ? "true" : "false";
+	}
+	return QString();
+}
+
+void AttributeStore::clear()
+{
+	columns.clear();
+	columnIndex.clear();
+	ids.clear();
+	rowIndex.clear();
+}
+
+void AttributeStore::resizeColumn(Column &column, int rows)
+{
+	// REAL stlpec nepotrebuje pole celych cisel a naopak
+	int old;
+	if (column.type == REAL)
+	{
+		old = (int) column.reals.size();
+		column.reals.resize(rows);
+	}
+	else
+	{
+		old = (int) column.integers.size();
+		column.integers.resize(rows);
+	}
+
+	column.nulls.resize((rows + 31) / 32, 0xffffffffu);
+	// slovo bitmapy moze obsahovat priznaky odstranenych riadkov
+	for (int row = old; row < rows; row++)
+		column.nulls[row >> 5] |= 1u << (row & 31);
+}
+
+void AttributeStore::copyRow(Column &column, int from, int to)
+{
+	if (column.type == REAL)
+		column.reals[to] = column.reals[from];
+	else
+		column.integers[to] = column.integers[from];
+
+	if (column.isNull(from))
+		column.nulls[to >> 5] |= 1u << (to & 31);
+	else
+		column.nulls[to >> 5] &= ~(1u << (to & 31));
+}
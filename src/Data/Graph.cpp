@@ -5,10 +5,46 @@
 #include "Data/Graph.h"
 #include "Data/GraphLayout.h"
 
+#include <QSet>
+
+namespace
+{
+	//pocet prvkov jedneho typu, ktore z indexu odstranujeme po jednom, pri viacerych typ prestavame naraz
+	const int TYPE_INDEX_SINGLE_REMOVALS = 16;
+
+	//z indexu podla typu odstrani vybrane prvky, typ s mnohymi odstranenymi prvkami prejde iba raz
+	template <class T>
+	void removeFromTypeIndex(QMultiMap<qlonglong, osg::ref_ptr<T> > &byType, const QMultiHash<qlonglong, T*> &removedByType, const QSet<T*> &removed)
+	{
+		foreach(qlonglong typeId, removedByType.uniqueKeys()) {
+			if(removedByType.count(typeId)<=TYPE_INDEX_SINGLE_REMOVALS) {
+				foreach(T* value, removedByType.values(typeId)) {
+					byType.remove(typeId,osg::ref_ptr<T>(value));
+				}
+				continue;
+			}
+
+			QList<osg::ref_ptr<T> > values = byType.values(typeId);
+			QList<osg::ref_ptr<T> > kept;
+			for(int i=0;i<values.size();i++) {
+				if(!removed.contains(values.at(i).get())) kept.append(values.at(i));
+			}
+			if(kept.size()==values.size()) continue;
+
+			//values vracia najnovsie prvky prve, vkladame odzadu aby poradie ostalo
+			byType.remove(typeId);
+			for(int i=kept.size()-1;i>=0;i--) {
+				byType.insert(typeId,kept.at(i));
+			}
+		}
+	}
+}
+
 Data::Graph::Graph(qlonglong graph_id, QString name, QSqlDatabase* conn, QMap<qlonglong,osg::ref_ptr<Data::Node> > *nodes, QMap<qlonglong,osg::ref_ptr<Data::Edge> > *edges,QMap<qlonglong,osg::ref_ptr<Data::Node> > *metaNodes, QMap<qlonglong,osg::ref_ptr<Data::Edge> > *metaEdges, QMap<qlonglong,Data::Type*> *types)
 {
     //tento konstruktor je uz zastaraly a neda sa realne pouzit - uzly musia mat priradeny graph, ktory sa prave vytvarat, rovnako edge, type, metatype (ten musi mat naviac aj layout, ktory opat musi mat graph)
     this->inDB = false;
+    this->topologyVersion = 0;
 
     this->graph_id = graph_id;
     this->name = name;
@@ -18,27 +54,32 @@ Data::Graph::Graph(qlonglong graph_id, QString name, QSqlDatabase* conn, QMap<ql
         qDebug() << layouts.value(i)->toString();
     }*/
 
-	this->nodes = nodes;
+	//prvky z map presunieme do store, mapy Graph preberal do vlastnictva
 	foreach(qlonglong i,nodes->keys()) {
 	    this->nodesByType.insert(nodes->value(i)->getType()->getId(),nodes->value(i));
+	    this->storeNode(nodes->value(i),false);
 	}
+	delete nodes;
 	
-	this->edges = edges;
     foreach(qlonglong i,edges->keys()) {
         this->edgesByType.insert(edges->value(i)->getType()->getId(),edges->value(i));
+        this->storeEdge(edges->value(i),false);
     }
+    delete edges;
     
 	this->types = types;
 	
-	this->metaEdges = metaEdges;
     foreach(qlonglong i,metaEdges->keys()) {
         this->metaEdgesByType.insert(metaEdges->value(i)->getType()->getId(),metaEdges->value(i));
+        this->storeEdge(metaEdges->value(i),true);
     }
+    delete metaEdges;
     
-	this->metaNodes = metaNodes;
     foreach(qlonglong i,metaNodes->keys()) {
         this->metaNodesByType.insert(metaNodes->value(i)->getType()->getId(),metaNodes->value(i));
+        this->storeNode(metaNodes->value(i),true);
     }
+    delete metaNodes;
     
 	this->selectedLayout = NULL;
 	this->ele_id_counter = this->getMaxEleIdFromElements();
@@ -58,6 +99,7 @@ Data::Graph::Graph(qlonglong graph_id, QString name, QSqlDatabase* conn, QMap<ql
 Data::Graph::Graph(qlonglong graph_id, QString name, qlonglong layout_id_counter, qlonglong ele_id_counter, QSqlDatabase* conn)
 {
     this->inDB = false;
+    this->topologyVersion = 0;
 
     this->graph_id = graph_id;
     this->name = name;
@@ -67,34 +109,13 @@ Data::Graph::Graph(qlonglong graph_id, QString name, qlonglong layout_id_counter
     this->selectedLayout = NULL;
     
     //pre Misa
-    this->nodes = new QMap<qlonglong,osg::ref_ptr<Data::Node> >();
-    this->edges = new QMap<qlonglong,osg::ref_ptr<Data::Edge> >();
     this->types = new QMap<qlonglong,Data::Type*>();
-    this->metaEdges = new QMap<qlonglong,osg::ref_ptr<Data::Edge> >();
-    this->metaNodes = new QMap<qlonglong,osg::ref_ptr<Data::Node> >();
     this->frozen = false;
     this->typesByName = new QMultiMap<QString, Data::Type*>();
 }
 
 Data::Graph::~Graph(void)
 {
-	//uvolnime vsetky Nodes, Edges, metaNodes, metaEdges... su cez osg::ref_ptr takze staci clearnut
-	this->nodes->clear();
-	delete this->nodes;
-	this->nodes = NULL;
-
-	this->metaNodes->clear();
-	delete this->metaNodes;
-	this->metaNodes = NULL;
-
-	this->edges->clear();
-	delete this->edges;
-	this->edges = NULL;
-
-	this->metaEdges->clear();
-	delete this->metaEdges;
-	this->metaEdges = NULL;
-
     //tieto zatial iba vyprazdnime - tu bude treba spavit logiku, ktora deletne tie, ktore nie su v nodes, metanodes, metaedges, edges a types  TODO!!!
     //v zasade, ak nam funguje DB pripojenie, tak tu nebudu ziadne uzly ktore uz mame v nodes, edges, metanodes ... treba ich deletnut
     //ak nam db nefunguje, tak uzly ktore su tu budu aj v nodes, metatypes, edges...
@@ -105,6 +126,17 @@ Data::Graph::~Graph(void)
     this->metaNodesByType.clear();
     this->nodesByType.clear();
     this->edgesByType.clear();
+    //uvolnime vsetky Nodes, Edges, metaNodes, metaEdges... su cez osg::ref_ptr takze staci clearnut
+    this->nodeStore.clear();
+    this->edgeStore.clear();
+    this->metaNodeStore.clear();
+    this->metaEdgeStore.clear();
+    this->nodeHandles.clear();
+    this->edgeHandles.clear();
+    this->metaNodeHandles.clear();
+    this->metaEdgeHandles.clear();
+    this->nodeAttributes.clear();
+    this->edgeAttributes.clear();
     
     this->typesByName->clear(); 
     delete this->typesByName;
@@ -212,11 +244,11 @@ osg::ref_ptr<Data::Node> Data::Graph::addNode(QString name, Data::Type* type, os
 
     this->newNodes.insert(node->getId(),node);
     if(type!=NULL && type->isMeta()) {
-        this->metaNodes->insert(node->getId(),node);
         this->metaNodesByType.insert(type->getId(),node);
+        this->storeNode(node,true);
     } else { 
-        this->nodes->insert(node->getId(),node);
         this->nodesByType.insert(type->getId(),node);
+        this->storeNode(node,false);
     }
     
     return node;
@@ -229,11 +261,11 @@ osg::ref_ptr<Data::Edge> Data::Graph::addEdge(QString name, osg::ref_ptr<Data::N
 	edge->linkNodes(&this->newEdges);
     if((type!=NULL && type->isMeta()) || ((srcNode->getType()!=NULL && srcNode->getType()->isMeta()) || (dstNode->getType()!=NULL && dstNode->getType()->isMeta()))) {
         //ak je type meta, alebo je meta jeden z uzlov (ma type meta)
-        edge->linkNodes(this->metaEdges);
         this->metaEdgesByType.insert(type->getId(),edge);
+        this->storeEdge(edge,true);
     } else {
-        edge->linkNodes(this->edges);
         this->edgesByType.insert(type->getId(),edge);
+        this->storeEdge(edge,false);
     }
 
     return edge;
@@ -294,39 +326,26 @@ qlonglong Data::Graph::getMaxEleIdFromElements()
 {
     qlonglong max = 0;
 
-    if(this->nodes!=NULL && !this->nodes->isEmpty()) {
-        QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator iNodes =  this->nodes->end();
-        iNodes--;
-
-        if(iNodes.key()>max) max = iNodes.key();
+    //store nie su zoradene podla ID, prejdeme vsetky prvky
+    const NodeStore *nodeStores[2] = { &this->nodeStore, &this->metaNodeStore };
+    for(int l=0;l<2;l++) {
+        for(int i=0;i<nodeStores[l]->size();i++) {
+            if(nodeStores[l]->at(i)->getId()>max) max = nodeStores[l]->at(i)->getId();
+        }
     }
     
-    if(this->nodes!=NULL && !this->types->isEmpty()) {
+    if(this->types!=NULL && !this->types->isEmpty()) {
         QMap<qlonglong, Data::Type*>::iterator iTypes =  this->types->end();
         iTypes--;
 
         if(iTypes.key()>max) max = iTypes.key();
     }
     
-    if(this->nodes!=NULL && !this->edges->isEmpty()) {
-        QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator iEdges =  this->edges->end();
-        iEdges--;
-
-        if(iEdges.key()>max) max = iEdges.key();
-    }
-    
-    if(this->nodes!=NULL && !this->metaNodes->isEmpty()) {
-        QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator iMetaNodes =  this->metaNodes->end();
-        iMetaNodes--;
-
-        if(iMetaNodes.key()>max) max = iMetaNodes.key();
-    }    
-    
-    if(this->nodes!=NULL && !this->metaEdges->isEmpty()) {
-        QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator iMetaEdges =  this->metaEdges->end();
-        iMetaEdges--;
-
-        if(iMetaEdges.key()>max) max = iMetaEdges.key();
+    const EdgeStore *edgeStores[2] = { &this->edgeStore, &this->metaEdgeStore };
+    for(int l=0;l<2;l++) {
+        for(int i=0;i<edgeStores[l]->size();i++) {
+            if(edgeStores[l]->at(i)->getId()>max) max = edgeStores[l]->at(i)->getId();
+        }
     }
     
     return max;
@@ -412,64 +431,227 @@ void Data::Graph::removeType( Data::Type* type )
 
 void Data::Graph::removeAllEdgesOfType(Data::Type* type )
 {
-	QList<osg::ref_ptr<Data::Edge> > edgesToKill;
-	if(type->isMeta()) edgesToKill = this->metaEdgesByType.values(type->getId());
-	else edgesToKill = this->edgesByType.values(type->getId());
-    if(!edgesToKill.isEmpty()) {
-        for(qlonglong i=0;i<edgesToKill.size();i++) {
-			this->removeEdge(edgesToKill.at(i));
-        }
-
-        edgesToKill.clear();
-    }
+	if(type->isMeta()) this->removeEdges(this->metaEdgesByType.values(type->getId()));
+	else this->removeEdges(this->edgesByType.values(type->getId()));
 }
 
 void Data::Graph::removeAllNodesOfType( Data::Type* type )
 {
-	QList<osg::ref_ptr<Data::Node> > nodesToKill;
-	if(type->isMeta()) nodesToKill = this->metaNodesByType.values(type->getId()); //vyberieme vsetky uzly daneho typu
-	else nodesToKill = this->nodesByType.values(type->getId());
-
-    if(!nodesToKill.isEmpty()) {
-        for(qlonglong i=0;i<nodesToKill.size();i++) { //prejdeme kazdy jeden uzol
-			this->removeNode(nodesToKill.at(i));
-        }
-        
-		nodesToKill.clear();
-    }
+	//vyberieme vsetky uzly daneho typu a odstranime ich naraz
+	if(type->isMeta()) this->removeNodes(this->metaNodesByType.values(type->getId()));
+	else this->removeNodes(this->nodesByType.values(type->getId()));
 }
 
 void Data::Graph::removeEdge( osg::ref_ptr<Data::Edge> edge)
 {
-	if(edge!=NULL && edge->getGraph()==this) {
-		if(!edge->isInDB() || Model::EdgeDAO::removeEdge(edge, this->conn)) {
-			this->edges->remove(edge->getId());
-			this->metaEdges->remove(edge->getId());
-			this->newEdges.remove(edge->getId());
-			this->edgesByType.remove(edge->getType()->getId(),edge);
-			this->metaEdgesByType.remove(edge->getType()->getId(),edge);
+	this->removeEdges(QList<osg::ref_ptr<Data::Edge> >() << edge);
+}
+
+void Data::Graph::removeNode( osg::ref_ptr<Data::Node> node )
+{
+	this->removeNodes(QList<osg::ref_ptr<Data::Node> >() << node);
+}
 
-			edge->unlinkNodes();
+QList<osg::ref_ptr<Data::Node> > Data::Graph::addNodes(const QList<NodeSpec> &specs)
+{
+	QList<osg::ref_ptr<Data::Node> > added;
+	added.reserve(specs.size());
+
+	int metaCount = 0;
+	for(int i=0;i<specs.size();i++) {
+		if(specs.at(i).type!=NULL && specs.at(i).type->isMeta()) metaCount++;
+	}
+	this->nodeStore.reserve(this->nodeStore.size()+specs.size()-metaCount);
+	this->nodeHandles.reserve(this->nodeHandles.size()+specs.size()-metaCount);
+	this->metaNodeStore.reserve(this->metaNodeStore.size()+metaCount);
+	this->metaNodeHandles.reserve(this->metaNodeHandles.size()+metaCount);
+
+	for(int i=0;i<specs.size();i++) {
+		const NodeSpec &spec = specs.at(i);
+		osg::ref_ptr<Data::Node> node = new Data::Node(this->incEleIdCounter(), spec.name, spec.type, this, spec.position);
+
+		this->newNodes.insert(node->getId(),node);
+		if(spec.type!=NULL && spec.type->isMeta()) {
+			this->storeNode(node,true);
+		} else {
+			this->storeNode(node,false);
 		}
+		added.append(node);
+	}
+
+	//index podla typu doplnime az po vytvoreni vsetkych uzlov
+	for(int i=0;i<added.size();i++) {
+		Data::Type* type = specs.at(i).type;
+		if(type!=NULL && type->isMeta()) this->metaNodesByType.insert(type->getId(),added.at(i));
+		else this->nodesByType.insert(type->getId(),added.at(i));
 	}
+
+	return added;
 }
 
-void Data::Graph::removeNode( osg::ref_ptr<Data::Node> node )
+QList<osg::ref_ptr<Data::Edge> > Data::Graph::addEdges(const QList<EdgeSpec> &specs)
+{
+	QList<osg::ref_ptr<Data::Edge> > added;
+	added.reserve(specs.size());
+
+	QList<bool> meta;
+	int metaCount = 0;
+	for(int i=0;i<specs.size();i++) {
+		const EdgeSpec &spec = specs.at(i);
+		//ak je type meta, alebo je meta jeden z uzlov (ma type meta)
+		bool isMeta = (spec.type!=NULL && spec.type->isMeta()) || (spec.srcNode->getType()!=NULL && spec.srcNode->getType()->isMeta()) || (spec.dstNode->getType()!=NULL && spec.dstNode->getType()->isMeta());
+		meta.append(isMeta);
+		if(isMeta) metaCount++;
+	}
+	this->edgeStore.reserve(this->edgeStore.size()+specs.size()-metaCount);
+	this->edgeHandles.reserve(this->edgeHandles.size()+specs.size()-metaCount);
+	this->metaEdgeStore.reserve(this->metaEdgeStore.size()+metaCount);
+	this->metaEdgeHandles.reserve(this->metaEdgeHandles.size()+metaCount);
+
+	for(int i=0;i<specs.size();i++) {
+		const EdgeSpec &spec = specs.at(i);
+		osg::ref_ptr<Data::Edge> edge = new Data::Edge(this->incEleIdCounter(), spec.name, this, spec.srcNode, spec.dstNode, spec.type, spec.isOriented);
+
+		edge->linkNodes(&this->newEdges);
+		this->storeEdge(edge,meta.at(i));
+		added.append(edge);
+	}
+
+	for(int i=0;i<added.size();i++) {
+		if(meta.at(i)) this->metaEdgesByType.insert(specs.at(i).type->getId(),added.at(i));
+		else this->edgesByType.insert(specs.at(i).type->getId(),added.at(i));
+	}
+
+	return added;
+}
+
+void Data::Graph::removeEdges(const QList<osg::ref_ptr<Data::Edge> > &edges)
+{
+	QList<osg::ref_ptr<Data::Edge> > killed;
+	QSet<Data::Edge*> removed;
+	QMultiHash<qlonglong, Data::Edge*> removedByType;
+
+	for(int i=0;i<edges.size();i++) {
+		osg::ref_ptr<Data::Edge> edge = edges.at(i);
+		if(edge==NULL || edge->getGraph()!=this || removed.contains(edge.get())) continue;
+		if(edge->isInDB() && !Model::EdgeDAO::removeEdge(edge, this->conn)) continue;
+
+		this->newEdges.remove(edge->getId());
+		this->unstoreEdge(edge->getId());
+		this->edgeAttributes.removeRow(edge->getId());
+
+		removed.insert(edge.get());
+		removedByType.insert(edge->getType()->getId(),edge.get());
+		killed.append(edge);
+	}
+
+	removeFromTypeIndex(this->edgesByType, removedByType, removed);
+	removeFromTypeIndex(this->metaEdgesByType, removedByType, removed);
+
+	for(int i=0;i<killed.size();i++) {
+		killed.at(i)->unlinkNodes();
+	}
+}
+
+void Data::Graph::removeNodes(const QList<osg::ref_ptr<Data::Node> > &nodes)
 {
-	if(node!=NULL && node->getGraph()==this) {
-		if(!node->isInDB() || Model::NodeDAO::removeNode(node, this->conn)) {
-			this->nodes->remove(node->getId());
-			this->metaNodes->remove(node->getId());
-			this->newNodes.remove(node->getId());
-			this->nodesByType.remove(node->getType()->getId(),node);
-			this->metaNodesByType.remove(node->getType()->getId(),node);
+	QList<osg::ref_ptr<Data::Node> > killed;
+	QSet<Data::Node*> removed;
+	QMultiHash<qlonglong, Data::Node*> removedByType;
+
+	for(int i=0;i<nodes.size();i++) {
+		osg::ref_ptr<Data::Node> node = nodes.at(i);
+		if(node==NULL || node->getGraph()!=this || removed.contains(node.get())) continue;
+		if(node->isInDB() && !Model::NodeDAO::removeNode(node, this->conn)) continue;
+
+		this->newNodes.remove(node->getId());
+		this->unstoreNode(node->getId());
+		this->nodeAttributes.removeRow(node->getId());
+
+		removed.insert(node.get());
+		removedByType.insert(node->getType()->getId(),node.get());
+		killed.append(node);
+	}
 
-			node->removeAllEdges();
+	removeFromTypeIndex(this->nodesByType, removedByType, removed);
+	removeFromTypeIndex(this->metaNodesByType, removedByType, removed);
 
-			//zistime ci nahodou dany uzol nie je aj typom a osetrime specialny pripad ked uzol je sam sebe typom (v DB to znamena, ze uzol je ROOT uzlom/typom, teda uz nemoze mat ziaden iny typ)
-			if(this->types->contains(node->getId())) {
-				this->removeType(this->types->value(node->getId()));
+	//hrany vsetkych odstranenych uzlov odstranime naraz, hrana medzi dvoma z nich iba raz
+	QList<osg::ref_ptr<Data::Edge> > edgesToKill;
+	QSet<Data::Edge*> seen;
+	for(int i=0;i<killed.size();i++) {
+		QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator e;
+		for(e = killed.at(i)->getEdges()->constBegin(); e != killed.at(i)->getEdges()->constEnd(); ++e) {
+			if(!seen.contains(e.value().get())) {
+				seen.insert(e.value().get());
+				edgesToKill.append(e.value());
 			}
 		}
 	}
+	this->removeEdges(edgesToKill);
+
+	for(int i=0;i<killed.size();i++) {
+		//hrany, ktore sa nepodarilo odstranit z DB
+		killed.at(i)->removeAllEdges();
+
+		//zistime ci nahodou dany uzol nie je aj typom a osetrime specialny pripad ked uzol je sam sebe typom (v DB to znamena, ze uzol je ROOT uzlom/typom, teda uz nemoze mat ziaden iny typ)
+		if(this->types->contains(killed.at(i)->getId())) {
+			this->removeType(this->types->value(killed.at(i)->getId()));
+		}
+	}
+}
+
+osg::ref_ptr<Data::Node> Data::Graph::findNode(qlonglong id) const
+{
+	const osg::ref_ptr<Data::Node> *node = this->nodeStore.get(this->nodeHandles.value(id));
+	if(node==NULL) node = this->metaNodeStore.get(this->metaNodeHandles.value(id));
+	return node!=NULL ? *node : osg::ref_ptr<Data::Node>();
+}
+
+osg::ref_ptr<Data::Edge> Data::Graph::findEdge(qlonglong id) const
+{
+	const osg::ref_ptr<Data::Edge> *edge = this->edgeStore.get(this->edgeHandles.value(id));
+	if(edge==NULL) edge = this->metaEdgeStore.get(this->metaEdgeHandles.value(id));
+	return edge!=NULL ? *edge : osg::ref_ptr<Data::Edge>();
+}
+
+const Data::Adjacency & Data::Graph::getAdjacency()
+{
+	QMutexLocker locker(&this->adjacencyMutex);
+	if(this->adjacency.getVersion()!=this->topologyVersion) {
+		this->adjacency.build(this);
+	}
+	return this->adjacency;
+}
+
+void Data::Graph::storeNode(osg::ref_ptr<Data::Node> node, bool meta)
+{
+	//uzol s rovnakym ID nahradzame, rovnako ako v QMap
+	this->unstoreNode(node->getId());
+	if(meta) this->metaNodeHandles.insert(node->getId(),this->metaNodeStore.insert(node));
+	else this->nodeHandles.insert(node->getId(),this->nodeStore.insert(node));
+	this->topologyVersion++;
+}
+
+void Data::Graph::storeEdge(osg::ref_ptr<Data::Edge> edge, bool meta)
+{
+	this->unstoreEdge(edge->getId());
+	if(meta) this->metaEdgeHandles.insert(edge->getId(),this->metaEdgeStore.insert(edge));
+	else this->edgeHandles.insert(edge->getId(),this->edgeStore.insert(edge));
+	this->topologyVersion++;
+}
+
+void Data::Graph::unstoreNode(qlonglong id)
+{
+	//neplatny handle (uzol nie je v danom store) remove ignoruje
+	this->nodeStore.remove(this->nodeHandles.take(id));
+	this->metaNodeStore.remove(this->metaNodeHandles.take(id));
+	this->topologyVersion++;
+}
+
+void Data::Graph::unstoreEdge(qlonglong id)
+{
+	this->edgeStore.remove(this->edgeHandles.take(id));
+	this->metaEdgeStore.remove(this->metaEdgeHandles.take(id));
+	this->topologyVersion++;
 }
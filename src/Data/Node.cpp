@@ -7,11 +7,6 @@
  */
 #include "Data/Node.h"
 #include "Util/ApplicationConfig.h"
-#include "Viewer/TextureWrapper.h"
-
-#include <osgText/FadeText>
-
-typedef osg::TemplateIndexArray<unsigned int, osg::Array::UIntArrayType,4,1> ColorIndexArray;
 
 Data::Node::Node(qlonglong id, QString name, Data::Type* type, Data::Graph* graph, osg::Vec3f position) 
 {
@@ -24,35 +19,18 @@ Data::Node::Node(qlonglong id, QString name, Data::Type* type, Data::Graph* grap
 	this->inDB = false;
 	this->edges = new QMap<qlonglong, osg::ref_ptr<Data::Edge> >;
 
-	settings = new QMap<QString, QString>();
-	//APA
-
-	settings->insert("Velkost","4242");
-	settings->insert("Farba","ruzova");
-	//APA
-
-	int pos = 0;
-	int cnt = 0;
-
-	labelText = this->name;
-
-	while ((pos = labelText.indexOf(QString(" "), pos + 1)) != -1)
-	{
-		if (++cnt % 3 == 0)
-			labelText = labelText.replace(pos, 1, "\n");
-	}
-
-	this->addDrawable(createNode(this->type->getScale(), Node::createStateSet(this->type)));
-	
-	this->square = createSquare(this->type->getScale(), Node::createStateSet());
-	this->label = createLabel(this->type->getScale(), labelText);
+	//atributy z GraphML su v Graph::getNodeAttributes, mapu vytvarame az na ziadost
+	settings = NULL;
 
+	//proxy s drawables vytvara az viewer, uzly pre layout a export ju nemaju
 	this->force = osg::Vec3f();
 	this->velocity = osg::Vec3f(0,0,0);
 	this->fixed = false;
 	this->ignore = false;
 	this->selected = false;
+	this->labelVisible = false;
 	this->usingInterpolation = true;
+	this->view = NULL;
 
 	float r = type->getSettings()->value("color.R").toFloat();
 	float g = type->getSettings()->value("color.G").toFloat();
@@ -70,6 +48,10 @@ Data::Node::~Node(void)
     edges->clear(); //staci to ?? netreba spravit delete/remove ??
 
 	delete edges;
+	delete settings;
+
+	if (view != NULL)
+		view->detach();
 }
 
 void Data::Node::addEdge(osg::ref_ptr<Data::Edge> edge) { 
@@ -91,152 +73,6 @@ void Data::Node::removeAllEdges()
 	edges->clear();
 }
 
-/*!
- * 
- * \param scale
- * Koeficient velkosti uzlov.
- * 
- * \param bbState
- * Zoznam stavov pre dany uzol. 
- * 
- * \returns
- * Uzol.
- * 
- * 
- * Vytvori konkretny uzol a priradi mu stav.
- * 
- */
-osg::ref_ptr<osg::Drawable> Data::Node::createNode(const float & scale, osg::StateSet* bbState) 
-{
-	float width = 2.0f;
-	float height = 2.0f;
-
-	width *= scale;
-	height *= scale;
-
-	osg::ref_ptr<osg::Geometry> nodeQuad = new osg::Geometry;
-	osg::ref_ptr<osg::Vec3Array> nodeVerts = new osg::Vec3Array(4);
-
-	(*nodeVerts)[0] = osg::Vec3(-width / 2.0f, -height / 2.0f, 0);
-	(*nodeVerts)[1] = osg::Vec3( width / 2.0f, -height / 2.0f, 0);
-	(*nodeVerts)[2] = osg::Vec3( width / 2.0f,	height / 2.0f, 0);
-	(*nodeVerts)[3] = osg::Vec3(-width / 2.0f,  height / 2.0f, 0);
-
-	nodeQuad->setUseDisplayList(false);
-
-	nodeQuad->setVertexArray(nodeVerts);
-	nodeQuad->addPrimitiveSet(new osg::DrawArrays(osg::PrimitiveSet::QUADS,0,4));
-
-	osg::ref_ptr<osg::Vec2Array> nodeTexCoords = new osg::Vec2Array(4);
-	(*nodeTexCoords)[0].set(0.0f,0.0f);
-	(*nodeTexCoords)[1].set(1.0f,0.0f);
-	(*nodeTexCoords)[2].set(1.0f,1.0f);
-	(*nodeTexCoords)[3].set(0.0f,1.0f);
-
-	nodeQuad->setTexCoordArray(0, nodeTexCoords);
-
-	osg::ref_ptr<osg::Vec4Array> colorArray = new osg::Vec4Array;
-	colorArray->push_back(osg::Vec4(1.0f, 1.0f, 1.0f, 1.0f));
-
-	osg::ref_ptr<ColorIndexArray> colorIndexArray = new osg::TemplateIndexArray<unsigned int, osg::Array::UIntArrayType, 4, 1>;
-	colorIndexArray->push_back(0);
-
-	nodeQuad->setColorArray( colorArray);
-	nodeQuad->setColorIndices(colorIndexArray);
-	nodeQuad->setColorBinding(osg::Geometry::BIND_OVERALL);	
-	nodeQuad->setStateSet(bbState); 
-
-	return nodeQuad;
-}
-
-osg::ref_ptr<osg::Drawable> Data::Node::createSquare(const float & scale, osg::StateSet* bbState)
-{
-	float width = 2.0f;
-	float height = 2.0f;
-
-	width *= scale;
-	height *= scale;
-
-	osg::ref_ptr<osg::Geometry> nodeRect = new osg::Geometry;
-	osg::ref_ptr<osg::Vec3Array> nodeVerts = new osg::Vec3Array(5);
-
-	(*nodeVerts)[0] = osg::Vec3(-width / 2.0f, -height / 2.0f, 0);
-	(*nodeVerts)[1] = osg::Vec3( width / 2.0f, -height / 2.0f, 0);
-	(*nodeVerts)[2] = osg::Vec3( width / 2.0f,	height / 2.0f, 0);
-	(*nodeVerts)[3] = osg::Vec3(-width / 2.0f,  height / 2.0f, 0);
-	(*nodeVerts)[4] = osg::Vec3(-width / 2.0f, -height / 2.0f, 0);
-
-	nodeRect->setVertexArray(nodeVerts);
-	nodeRect->addPrimitiveSet(new osg::DrawArrays(osg::PrimitiveSet::LINE_STRIP,0,5));
-
-	osg::ref_ptr<ColorIndexArray> colorIndexArray = new osg::TemplateIndexArray<unsigned int, osg::Array::UIntArrayType, 4, 1>;
-	colorIndexArray->push_back(0);
-
-	osg::ref_ptr<osg::Vec4Array> colorArray = new osg::Vec4Array;
-	colorArray->push_back(osg::Vec4(1.0f, 0.0f, 0.0f, 0.5f));
-
-	nodeRect->setColorArray(colorArray);
-	nodeRect->setColorIndices(colorIndexArray);
-
-	nodeRect->setColorArray( colorArray);
-	nodeRect->setColorBinding(osg::Geometry::BIND_OVERALL);	
-
-	nodeRect->setStateSet(bbState);
-
-	return nodeRect;
-}
-
-osg::ref_ptr<osg::Drawable> Data::Node::createLabel(const float & scale, QString name)
-{
-	osg::ref_ptr<osgText::FadeText> label = new osgText::FadeText;
-	label->setFadeSpeed(0.03);
-
-	QString fontPath = Util::ApplicationConfig::get()->getValue("Viewer.Labels.Font");
-	
-	// experimental value
-	float newScale = 1.375f * scale;
-
-	if(fontPath != NULL && !fontPath.isEmpty())
-		label->setFont(fontPath.toStdString());
-
-	label->setText(name.toStdString());
-	label->setLineSpacing(0);
-	label->setAxisAlignment(osgText::Text::SCREEN);
-	label->setCharacterSize(newScale);
-	label->setDrawMode(osgText::Text::TEXT);
-	label->setAlignment(osgText::Text::CENTER_BOTTOM_BASE_LINE);
-	label->setPosition( osg::Vec3(0, newScale, 0) );
-	label->setColor( osg::Vec4(1.0f, 1.0f, 1.0f, 1.0f) );
-
-	return label;
-}
-
-osg::ref_ptr<osg::StateSet> Data::Node::createStateSet(Data::Type * type)
-{
-	osg::ref_ptr<osg::StateSet> stateSet = new osg::StateSet;
-
-	stateSet->setDataVariance(osg::Object::DYNAMIC);
-	stateSet->setMode(GL_LIGHTING, osg::StateAttribute::OFF);
-
-	if(type != 0)
-		stateSet->setTextureAttributeAndModes(0, type->getTypeTexture(), osg::StateAttribute::ON);
-
-	stateSet->setMode(GL_BLEND, osg::StateAttribute::ON);
-	stateSet->setMode(GL_DEPTH_TEST, osg::StateAttribute::OFF);
-
-	stateSet->setRenderingHint(osg::StateSet::TRANSPARENT_BIN); 
- 
- 	osg::ref_ptr<osg::Depth> depth = new osg::Depth;
- 	depth->setWriteMask(false);
- 	stateSet->setAttributeAndModes(depth, osg::StateAttribute::ON);
-
-	osg::ref_ptr<osg::CullFace> cull = new osg::CullFace();
-	cull->setMode(osg::CullFace::BACK);
-	stateSet->setAttributeAndModes(cull, osg::StateAttribute::ON); 
-
-	return stateSet;
-}
-
 bool Data::Node::equals(Node* node) 
 {
 	if (this == node)
@@ -263,47 +99,43 @@ bool Data::Node::equals(Node* node)
 	return true;
 }
 
-void Data::Node::setDrawableColor(int pos, osg::Vec4 color)
+void Data::Node::setFixed(bool fixed)
 {
-	osg::Geometry * geometry  = dynamic_cast<osg::Geometry *>(this->getDrawable(pos)); 
-
-	if (geometry != NULL)
-	{
-		osg::Vec4Array * colorArray =  dynamic_cast<osg::Vec4Array *>(geometry->getColorArray());
+	this->fixed = fixed;
 
-		colorArray->pop_back();
-		colorArray->push_back(color);
-	}
+	if (view != NULL)
+		view->setFixed(fixed);
 }
 
-void Data::Node::showLabel(bool visible)
+void Data::Node::setSelected(bool selected)
 {
-	if (visible && !this->containsDrawable(label))
-		this->addDrawable(label);
-	else if (!visible)
-		this->removeDrawable(label);
+	this->selected = selected;
+
+	if (view != NULL)
+		view->setColor(selected ? osg::Vec4(0.0f, 0.0f, 0.0f, 1.0f) : color);
 }
 
-void Data::Node::reloadConfig()
+void Data::Node::setColor(osg::Vec4 color)
 {
-	this->setDrawable(0, createNode(this->type->getScale(), Node::createStateSet(this->type)));
-	setSelected(selected);
+	this->color = color;
 
-	osg::ref_ptr<osg::Drawable> newRect = createSquare(this->type->getScale(), Node::createStateSet());
-	osg::ref_ptr<osg::Drawable> newLabel = createLabel(this->type->getScale(), labelText);
+	if (view != NULL && !selected)
+		view->setColor(color);
+}
 
-	if (this->containsDrawable(label))
-	{
-		this->setDrawable(this->getDrawableIndex(label), newLabel);
-	}
+void Data::Node::showLabel(bool visible)
+{
+	//proxy vytvorena neskor zobrazi popis podla labelVisible
+	this->labelVisible = visible;
 
-	if (this->containsDrawable(square))
-	{
-		this->setDrawable(this->getDrawableIndex(square), newRect);
-	}
+	if (view != NULL)
+		view->showLabel(visible);
+}
 
-	label = newLabel;
-	square = newRect;
+void Data::Node::reloadConfig()
+{
+	if (view != NULL)
+		view->reloadConfig();
 }
 
 osg::Vec3f Data::Node::getCurrentPosition(bool calculateNew, float interpolationSpeed)  
@@ -0,0 +1,201 @@
+#include "Layout/ActiveSet.h"
+
+#include <algorithm>
+
+using namespace Layout;
+
+ActiveSet::ActiveSet()
+{
+	wakeDistance = 1;
+	edgeOffsets.push_back(0);
+	metaOffsets.push_back(0);
+}
+
+void ActiveSet::clear()
+{
+	edgeOffsets.assign(1, 0);
+	edgeNeighbours.clear();
+	metaOffsets.assign(1, 0);
+	metaNeighbours.clear();
+	still.clear();
+	drift.clear();
+	active.clear();
+	activeList.clear();
+	activated.clear();
+	grid.clear();
+}
+
+void ActiveSet::reset(const Layout::LayoutState &state, float radius, float wakeDistance)
+{
+	int count = state.getCount();
+	this->wakeDistance = wakeDistance;
+	state.buildNeighbours(count, Layout::LayoutState::NEIGHBOURS_EDGES, false, edgeOffsets, edgeNeighbours);
+	state.buildNeighbours(count, Layout::LayoutState::NEIGHBOURS_META_EDGES, false, metaOffsets, metaNeighbours);
+
+	grid.setCellSize(radius);
+	grid.clear();
+	if (count > 0)
+	{
+		grid.update(&state.x[0], &state.y[0], &state.z[0], count);
+	}
+
+	// na zaciatku su aktivne vsetky uzly
+	still.assign(count, 0);
+	drift.assign(count, 0);
+	active.assign(count, 1);
+	activeList.resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		activeList[i] = i;
+	}
+	activated.clear();
+}
+
+void ActiveSet::activate(int node)
+{
+	still[node] = 0;
+	if (!active[node])
+	{
+		active[node] = 1;
+		activated.push_back(node);
+	}
+}
+
+void ActiveSet::activateNeighbours(int node)
+{
+	for (int n = edgeOffsets[node]; n < edgeOffsets[node + 1]; n++)
+	{
+		activate(edgeNeighbours[n]);
+	}
+	for (int n = metaOffsets[node]; n < metaOffsets[node + 1]; n++)
+	{
+		activate(metaNeighbours[n]);
+	}
+}
+
+void ActiveSet::activateNear(const Layout::LayoutState &state, int node)
+{
+	near.clear();
+	grid.collectNear(state.x[node], state.y[node], state.z[node], near);
+	for (size_t n = 0; n < near.size(); n++)
+	{
+		activate(near[n]);
+	}
+	drift[node] = 0;
+}
+
+void ActiveSet::disturb(const Layout::LayoutState &state, int node)
+{
+	grid.move(node, state.x[node], state.y[node], state.z[node]);
+	activate(node);
+	activateNeighbours(node);
+	activateNear(state, node);
+}
+
+void ActiveSet::record(const Layout::LayoutState &state, int node, float distance)
+{
+	if (distance <= 0)
+	{
+		still[node]++;
+		return;
+	}
+	still[node] = 0;
+	grid.move(node, state.x[node], state.y[node], state.z[node]);
+	// posun meni pritazlive sily susedov
+	activateNeighbours(node);
+	// vzdialenejsie uzly budime az po vacsom posune, odpudiva sila s vzdialenostou rychlo slabne
+	drift[node] += distance;
+	if (drift[node] > wakeDistance)
+	{
+		activateNear(state, node);
+	}
+}
+
+void ActiveSet::update()
+{
+	// odstavime uzly, ktore sa nehybu a nehybu sa ani ich susedia
+	size_t kept = 0;
+	for (size_t k = 0; k < activeList.size(); k++)
+	{
+		int node = activeList[k];
+		bool park = still[node] >= STILL_ITERATIONS;
+		for (int n = edgeOffsets[node]; park && n < edgeOffsets[node + 1]; n++)
+		{
+			park = still[edgeNeighbours[n]] >= STILL_ITERATIONS;
+		}
+		for (int n = metaOffsets[node]; park && n < metaOffsets[node + 1]; n++)
+		{
+			park = still[metaNeighbours[n]] >= STILL_ITERATIONS;
+		}
+		if (park)
+		{
+			active[node] = 0;
+		}
+		else
+		{
+			activeList[kept++] = node;
+		}
+	}
+	activeList.resize(kept);
+
+	// pridame aktivovane uzly, zoradene poradie setri cache
+	for (size_t k = 0; k < activated.size(); k++)
+	{
+		if (active[activated[k]])
+			activeList.push_back(activated[k]);
+	}
+	activated.clear();
+	std::sort(activeList.begin(), activeList.end());
+	activeList.erase(std::unique(activeList.begin(), activeList.end()), activeList.end());
+}
+
+void ActiveSet::parkAll()
+{
+	int count = (int) still.size();
+	still.assign(count, (int) STILL_ITERATIONS);
+	active.assign(count, 0);
+	activeList.clear();
+	activated.clear();
+}
+
+void ActiveSet::collectNeighbourhood(const std::vector<int> &seeds, int hops, int maxCount, std::vector<int> &region) const
+{
+	region.clear();
+	std::vector<unsigned char> visited(still.size(), 0);
+	for (size_t k = 0; k < seeds.size() && (int) region.size() < maxCount; k++)
+	{
+		if (!visited[seeds[k]])
+		{
+			visited[seeds[k]] = 1;
+			region.push_back(seeds[k]);
+		}
+	}
+	// prehladavanie do sirky po vrstvach, region je zaroven fronta
+	size_t layerBegin = 0;
+	for (int hop = 0; hop < hops && (int) region.size() < maxCount; hop++)
+	{
+		size_t layerEnd = region.size();
+		for (size_t k = layerBegin; k < layerEnd && (int) region.size() < maxCount; k++)
+		{
+			int node = region[k];
+			for (int n = edgeOffsets[node]; n < edgeOffsets[node + 1] && (int) region.size() < maxCount; n++)
+			{
+				if (!visited[edgeNeighbours[n]])
+				{
+					visited[edgeNeighbours[n]] = 1;
+					region.push_back(edgeNeighbours[n]);
+				}
+			}
+			for (int n = metaOffsets[node]; n < metaOffsets[node + 1] && (int) region.size() < maxCount; n++)
+			{
+				if (!visited[metaNeighbours[n]])
+				{
+					visited[metaNeighbours[n]] = 1;
+					region.push_back(metaNeighbours[n]);
+				}
+			}
+		}
+		layerBegin = layerEnd;
+	}
+	std::sort(region.begin(), region.end());
+}
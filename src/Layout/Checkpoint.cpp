@@ -0,0 +1,196 @@
+#include "Layout/Checkpoint.h"
+
+#include <algorithm>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+
+using namespace Layout;
+
+namespace
+{
+	/* FNV-1a po bajtoch hodnoty od najnizsieho */
+	void mix(quint64 &hash, quint32 value)
+	{
+		for (int b = 0; b < 4; b++)
+		{
+			hash ^= (value >> (8 * b)) & 0xff;
+			hash *= Q_UINT64_C(1099511628211);
+		}
+	}
+
+	/* float zapisujeme ako jeho 32 bitov, QDataStream by ho rozsiril na double */
+	quint32 floatBits(float value)
+	{
+		union { float f; quint32 u; } bits;
+		bits.f = value;
+		return bits.u;
+	}
+
+	float bitsFloat(quint32 value)
+	{
+		union { float f; quint32 u; } bits;
+		bits.u = value;
+		return bits.f;
+	}
+}
+
+void Checkpoint::getOrder(const Layout::LayoutState &state, std::vector<int> &order)
+{
+	int count = state.getCount();
+	std::vector<std::pair<qlonglong, int> > keys(count);
+	for (int i = 0; i < count; i++)
+	{
+		keys[i] = std::make_pair(state.ids[i], i);
+	}
+	// uzly a metauzly radime zvlast, metauzly su vzdy za uzlami
+	std::sort(keys.begin(), keys.begin() + state.getNodeCount());
+	std::sort(keys.begin() + state.getNodeCount(), keys.end());
+	order.resize(count);
+	for (int k = 0; k < count; k++)
+	{
+		order[k] = keys[k].second;
+	}
+}
+
+quint64 Checkpoint::hashTopology(const Layout::LayoutState &state)
+{
+	std::vector<int> order;
+	getOrder(state, order);
+	std::vector<int> rank(order.size());
+	for (size_t k = 0; k < order.size(); k++)
+	{
+		rank[order[k]] = (int) k;
+	}
+
+	quint64 hash = Q_UINT64_C(14695981039346656037);
+	mix(hash, (quint32) state.getNodeCount());
+	mix(hash, (quint32) state.getCount());
+	// uzly hran nahradime ich poradim a hrany zoradime, poradie hran v snimke sa meni odstranovanim
+	const std::vector<int> *src[2] = { &state.edgeSrc, &state.metaEdgeSrc };
+	const std::vector<int> *dst[2] = { &state.edgeDst, &state.metaEdgeDst };
+	std::vector<std::pair<int, int> > edges;
+	for (int l = 0; l < 2; l++)
+	{
+		edges.resize(src[l]->size());
+		for (size_t e = 0; e < src[l]->size(); e++)
+		{
+			edges[e] = std::make_pair(rank[(*src[l])[e]], rank[(*dst[l])[e]]);
+		}
+		std::sort(edges.begin(), edges.end());
+		mix(hash, (quint32) edges.size());
+		for (size_t e = 0; e < edges.size(); e++)
+		{
+			mix(hash, (quint32) edges[e].first);
+			mix(hash, (quint32) edges[e].second);
+		}
+	}
+	return hash;
+}
+
+QString Checkpoint::getPath(const QString &directory, quint64 topology)
+{
+	return QDir(directory).filePath(QString("%1.layout").arg(topology, 16, 16, QChar('0')));
+}
+
+bool Checkpoint::save(const QString &directory, const Layout::LayoutState &state, const Header &header)
+{
+	if (!QDir().mkpath(directory))
+	{
+		return false;
+	}
+	quint64 topology = hashTopology(state);
+	QString path = getPath(directory, topology);
+
+	// zapisujeme do docasneho suboru, prerusenie zapisu nepokazi predchadzajuci checkpoint
+	QFile file(path + ".tmp");
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+	QDataStream out(&file);
+	out.setByteOrder(QDataStream::LittleEndian);
+	out << MAGIC << VERSION << topology;
+	out << header.engine << floatBits(header.sizeFactor) << floatBits(header.flexibility);
+	out << (quint8) header.useMaxDistance << (qint32) header.iterations << (quint8) header.converged;
+
+	std::vector<int> order;
+	getOrder(state, order);
+	out << (quint32) order.size();
+	for (size_t k = 0; k < order.size(); k++)
+	{
+		int i = order[k];
+		out << floatBits(state.x[i]) << floatBits(state.y[i]) << floatBits(state.z[i]);
+		out << floatBits(state.vx[i]) << floatBits(state.vy[i]) << floatBits(state.vz[i]);
+		out << (quint8) state.fixed[i];
+	}
+	file.close();
+	if (out.status() != QDataStream::Ok || file.error() != QFile::NoError)
+	{
+		file.remove();
+		return false;
+	}
+	QFile::remove(path);
+	return file.rename(path);
+}
+
+bool Checkpoint::load(const QString &directory, Layout::LayoutState &state, Header &header)
+{
+	quint64 topology = hashTopology(state);
+	QFile file(getPath(directory, topology));
+	if (!file.open(QIODevice::ReadOnly))
+	{ // graf este nebol ulozeny
+		return false;
+	}
+	QDataStream in(&file);
+	in.setByteOrder(QDataStream::LittleEndian);
+	quint32 magic, count, sizeFactor, flexibility;
+	quint16 version;
+	quint64 savedTopology;
+	quint8 useMaxDistance, converged;
+	qint32 iterations;
+	in >> magic >> version >> savedTopology;
+	if (in.status() != QDataStream::Ok || magic != MAGIC || version != VERSION || savedTopology != topology)
+	{
+		return false;
+	}
+	Header read;
+	in >> read.engine >> sizeFactor >> flexibility >> useMaxDistance >> iterations >> converged >> count;
+	if (in.status() != QDataStream::Ok || (int) count != state.getCount())
+	{
+		return false;
+	}
+	read.sizeFactor = bitsFloat(sizeFactor);
+	read.flexibility = bitsFloat(flexibility);
+	read.useMaxDistance = useMaxDistance != 0;
+	read.iterations = iterations;
+	read.converged = converged != 0;
+
+	// snimku menime az po precitani celeho suboru
+	std::vector<quint32> values(6 * count);
+	std::vector<quint8> flags(count);
+	for (quint32 k = 0; k < count; k++)
+	{
+		for (int v = 0; v < 6; v++)
+		{
+			in >> values[6 * k + v];
+		}
+		in >> flags[k];
+	}
+	if (in.status() != QDataStream::Ok)
+	{ // skrateny subor
+		return false;
+	}
+	std::vector<int> order;
+	getOrder(state, order);
+	for (quint32 k = 0; k < count; k++)
+	{
+		int i = order[k];
+		const quint32 *v = &values[6 * k];
+		state.x[i] = bitsFloat(v[0]); state.y[i] = bitsFloat(v[1]); state.z[i] = bitsFloat(v[2]);
+		state.vx[i] = bitsFloat(v[3]); state.vy[i] = bitsFloat(v[4]); state.vz[i] = bitsFloat(v[5]);
+		state.fixed[i] = flags[k] != 0 ? 1 : 0;
+	}
+	header = read;
+	return true;
+}
@@ -0,0 +1,219 @@
+#include "Layout/ConeTreeAlgorithm.h"
+
+#include <math.h>
+#include <algorithm>
+
+using namespace Layout;
+
+namespace
+{
+	const double PI = 3.14159265358979323846;
+
+	/* polomer kruznice deti uzla v a polomer kuzela jeho podstromu */
+	void measure(int v, const std::vector<int> &childStart, const std::vector<int> &children, float nodeRadius,
+		std::vector<float> &radius, std::vector<float> &ring, std::vector<float> &diameters)
+	{
+		float widest = 0;
+		diameters[v] = 0;
+		for (int c = childStart[v]; c < childStart[v + 1]; c++)
+		{
+			diameters[v] += 2 * radius[children[c]];
+			widest = std::max(widest, radius[children[c]]);
+		}
+		// jedno dieta lezi priamo pod rodicom
+		ring[v] = childStart[v + 1] - childStart[v] > 1 ? std::max((float) (diameters[v] / (2 * PI)), widest) : 0;
+		radius[v] = std::max(nodeRadius, ring[v] + widest);
+	}
+}
+
+const float ConeTreeAlgorithm::HIERARCHY_EDGE_RATIO = 1.25f;
+const float ConeTreeAlgorithm::LEVEL_DISTANCE = 2;
+
+bool ConeTreeAlgorithm::isHierarchy(Data::Graph *graph)
+{
+	if (graph == NULL)
+	{
+		return false;
+	}
+	const Data::Adjacency &adjacency = graph->getAdjacency();
+	int count = adjacency.getCount();
+	int edgeCount = adjacency.getEdgeCount();
+	if (count == 0 || edgeCount > HIERARCHY_EDGE_RATIO * count)
+	{
+		return false;
+	}
+
+	bool directed = true;
+	for (int e = 0; e < edgeCount && directed; e++)
+	{
+		directed = adjacency.getEdge(e)->isOriented();
+	}
+	if (!directed)
+	{ // neorientovany graf je hierarchia, len ak je to les
+		return edgeCount < count && isForest(adjacency);
+	}
+
+	// topologicke usporiadanie, ak ostane neusporiadany uzol, hrany tvoria cyklus
+	std::vector<int> indegree(count);
+	std::vector<int> queue;
+	queue.reserve(count);
+	for (int i = 0; i < count; i++)
+	{
+		indegree[i] = adjacency.getInDegree(i);
+		if (indegree[i] == 0)
+		{
+			queue.push_back(i);
+		}
+	}
+	for (size_t head = 0; head < queue.size(); head++)
+	{
+		int u = queue[head];
+		for (int k = adjacency.outOffsets[u]; k < adjacency.outOffsets[u + 1]; k++)
+		{
+			if (--indegree[adjacency.outNeighbours[k]] == 0)
+			{
+				queue.push_back(adjacency.outNeighbours[k]);
+			}
+		}
+	}
+	return (int) queue.size() == count;
+}
+
+bool ConeTreeAlgorithm::isForest(const Data::Adjacency &adjacency)
+{
+	// union-find, hrana medzi uzlami tej istej mnoziny uzatvara cyklus
+	std::vector<int> parent(adjacency.getCount());
+	for (size_t i = 0; i < parent.size(); i++)
+	{
+		parent[i] = (int) i;
+	}
+	for (int e = 0; e < adjacency.getEdgeCount(); e++)
+	{
+		int u = adjacency.edgeSrc[e], v = adjacency.edgeDst[e];
+		while (parent[u] != u)
+		{
+			u = parent[u] = parent[parent[u]];
+		}
+		while (parent[v] != v)
+		{
+			v = parent[v] = parent[parent[v]];
+		}
+		if (u == v)
+		{
+			return false;
+		}
+		parent[u] = v;
+	}
+	return true;
+}
+
+void ConeTreeAlgorithm::grow(std::vector<int> &order, int head, std::vector<int> &parent, bool directed) const
+{
+	for (size_t k = head; k < order.size(); k++)
+	{
+		int u = order[k];
+		for (int e = offsets[u]; e < offsets[u + 1]; e++)
+		{
+			int v = neighbours[e];
+			if (v < 0)
+			{ // vstupna hrana
+				if (directed)
+				{
+					continue;
+				}
+				v = -1 - v;
+			}
+			if (parent[v] == -2)
+			{
+				parent[v] = u;
+				order.push_back(v);
+			}
+		}
+	}
+}
+
+void ConeTreeAlgorithm::place(Layout::LayoutState &state)
+{
+	int count = state.getCount();
+	// zoznam hran uzla, prichadzajuca hrana z uzla j je -1 - j
+	state.buildNeighbours(state.getCount(), Layout::LayoutState::NEIGHBOURS_ALL, true, offsets, neighbours);
+
+	// kostra: najprv v smere hran z uzlov bez vstupnych hran, potom zvysok grafu bez ohladu na smer
+	std::vector<int> parent(count, -2);
+	std::vector<int> order;
+	order.reserve(count);
+	for (int i = 0; i < count; i++)
+	{
+		bool root = offsets[i] < offsets[i + 1];
+		for (int e = offsets[i]; e < offsets[i + 1] && root; e++)
+		{
+			root = neighbours[e] >= 0;
+		}
+		if (root)
+		{
+			parent[i] = -1;
+			order.push_back(i);
+		}
+	}
+	grow(order, 0, parent, true);
+	grow(order, 0, parent, false);
+	for (int i = 0; i < count; i++)
+	{
+		if (parent[i] == -2)
+		{ // cyklus bez korena alebo osamoteny uzol
+			parent[i] = -1;
+			int head = (int) order.size();
+			order.push_back(i);
+			grow(order, head, parent, false);
+		}
+	}
+
+	// deti v poradi prehladavania, korene su detmi virtualneho uzla count
+	std::vector<int> childStart(count + 2, 0);
+	for (int i = 0; i < count; i++)
+	{
+		childStart[(parent[i] == -1 ? count : parent[i]) + 1]++;
+	}
+	for (int i = 0; i <= count; i++)
+	{
+		childStart[i + 1] += childStart[i];
+	}
+	std::vector<int> children(count);
+	std::vector<int> fill(childStart.begin(), childStart.end() - 1);
+	for (int k = 0; k < count; k++)
+	{
+		int v = order[k];
+		children[fill[parent[v] == -1 ? count : parent[v]]++] = v;
+	}
+
+	// polomery kuzelov zdola nahor, rodicia su v poradi pred detmi
+	float nodeRadius = sizeFactor / 2;
+	std::vector<float> radius(count + 1), ring(count + 1), diameters(count + 1);
+	for (int k = count - 1; k >= 0; k--)
+	{
+		measure(order[k], childStart, children, nodeRadius, radius, ring, diameters);
+	}
+	measure(count, childStart, children, nodeRadius, radius, ring, diameters);
+
+	// pozicie zhora nadol, deti dostanu usek kruznice umerny priemeru ich kuzela
+	float levelDistance = LEVEL_DISTANCE * sizeFactor;
+	for (int k = -1; k < count; k++)
+	{
+		int v = k == -1 ? count : order[k];
+		osg::Vec3f center = v == count ? osg::Vec3f(0, 0, levelDistance) : state.getPosition(v);
+		float angle = 0;
+		for (int c = childStart[v]; c < childStart[v + 1]; c++)
+		{
+			int child = children[c];
+			float span = diameters[v] > 0 ? (float) (2 * PI * 2 * radius[child] / diameters[v]) : 0;
+			float theta = angle + span / 2;
+			angle += span;
+			if (state.fixed[child])
+			{ // fixovany uzol ostava, jeho usek kruznice ostane volny
+				continue;
+			}
+			state.setPosition(child, center + osg::Vec3f(ring[v] * cos(theta), ring[v] * sin(theta), -levelDistance));
+			state.vx[child] = state.vy[child] = state.vz[child] = 0;
+		}
+	}
+}
@@ -0,0 +1,349 @@
+#include "Layout/Embedding.h"
+
+#include <math.h>
+#include <algorithm>
+
+using namespace Layout;
+
+namespace
+{
+	/* pocet rozmerov vysledneho rozmiestnenia */
+	const int DIMENSIONS = 3;
+
+	/* maximalny pocet iteracii mocninovej metody a jej presnost */
+	const int POWER_ITERATIONS = 300;
+	const double POWER_EPSILON = 1e-9;
+}
+
+Embedding::Embedding(Layout::WorkerPool *pool)
+{
+	this->pool = pool;
+	count = 0;
+}
+
+void Embedding::build(const Layout::LayoutState &state, int pivotCount, unsigned int seed, Embedding::PivotChoice choice)
+{
+	count = state.getCount();
+	pivots.clear();
+	distances.clear();
+	if (count == 0)
+	{
+		return;
+	}
+	state.buildNeighbours(count, Layout::LayoutState::NEIGHBOURS_ALL, false, offsets, neighbours);
+
+	int m = std::min(pivotCount, count);
+	distances.resize((size_t) m * count);
+	if (choice == PIVOTS_RANDOM)
+	{ // rozne nahodne pivoty ciastocnym premiesanim, prehladavania su nezavisle
+		std::vector<int> order(count);
+		for (int i = 0; i < count; i++)
+		{
+			order[i] = i;
+		}
+		for (int p = 0; p < m; p++)
+		{
+			std::swap(order[p], order[p + LayoutState::hash(seed, (unsigned int) p) % (unsigned int) (count - p)]);
+			pivots.push_back(order[p]);
+		}
+		int workers = pool != NULL ? pool->getThreadCount() : 1;
+		queues.resize(workers);
+		for (int w = 0; w < workers; w++)
+		{
+			queues[w].resize(count);
+		}
+		if (pool != NULL)
+		{
+			Layout::MemberTask<Embedding> searchTask(this, &Embedding::searchPivots);
+			pool->run(&searchTask, m);
+		}
+		else
+		{
+			searchPivots(0, 0, m);
+		}
+		queues.clear();
+		return;
+	}
+
+	std::vector<float> nearest(count, -1);
+	std::vector<int> queue(count);
+	int pivot = (int) (LayoutState::hash(seed, 0) % (unsigned int) count);
+	for (int p = 0; p < m; p++)
+	{
+		pivots.push_back(pivot);
+		float *distance = &distances[(size_t) p * count];
+		search(pivot, distance, queue);
+
+		// dalsi pivot je uzol najvzdialenejsi od vsetkych doterajsich
+		int farthest = 0;
+		for (int i = 0; i < count; i++)
+		{
+			if (nearest[i] < 0 || distance[i] < nearest[i])
+			{
+				nearest[i] = distance[i];
+			}
+			if (nearest[i] > nearest[farthest])
+			{
+				farthest = i;
+			}
+		}
+		pivot = farthest;
+	}
+}
+
+void Embedding::search(int source, float *distance, std::vector<int> &queue) const
+{
+	std::fill(distance, distance + count, -1.0f);
+	distance[source] = 0;
+	int head = 0, tail = 0;
+	queue[tail++] = source;
+	while (head < tail)
+	{
+		int u = queue[head++];
+		for (int k = offsets[u]; k < offsets[u + 1]; k++)
+		{
+			int v = neighbours[k];
+			if (distance[v] < 0)
+			{
+				distance[v] = distance[u] + 1;
+				queue[tail++] = v;
+			}
+		}
+	}
+	// nedosiahnutelne komponenty lezia tesne za najvzdialenejsim uzlom
+	float unreachable = distance[queue[tail - 1]] + 1;
+	for (int i = 0; i < count; i++)
+	{
+		if (distance[i] < 0)
+		{
+			distance[i] = unreachable;
+		}
+	}
+}
+
+void Embedding::searchPivots(int worker, int begin, int end)
+{
+	for (int p = begin; p < end; p++)
+	{
+		search(pivots[p], &distances[(size_t) p * count], queues[worker]);
+	}
+}
+
+bool Embedding::place(Layout::LayoutState &state, double edgeLength)
+{
+	int m = getPivotCount();
+	if (m == 0 || neighbours.empty())
+	{ // bez hran nie je co zachovat
+		return false;
+	}
+
+	// vycentrujeme stlpce
+	for (int p = 0; p < m; p++)
+	{
+		float *column = &distances[(size_t) p * count];
+		double mean = 0;
+		for (int i = 0; i < count; i++)
+		{
+			mean += column[i];
+		}
+		mean /= count;
+		for (int i = 0; i < count; i++)
+		{
+			column[i] = (float) (column[i] - mean);
+		}
+	}
+	return project(state, edgeLength);
+}
+
+bool Embedding::placeMds(Layout::LayoutState &state, double edgeLength)
+{
+	int m = getPivotCount();
+	if (m == 0 || neighbours.empty())
+	{ // bez hran nie je co zachovat
+		return false;
+	}
+
+	// stvorce vzdialenosti dvojito vycentrujeme: c = -(d^2 - priemer stlpca - priemer riadku + celkovy priemer) / 2
+	std::vector<float> rowMean(count, 0);
+	std::vector<double> columnMean(m, 0);
+	double mean = 0;
+	for (int p = 0; p < m; p++)
+	{
+		float *column = &distances[(size_t) p * count];
+		double sum = 0;
+		for (int i = 0; i < count; i++)
+		{
+			column[i] *= column[i];
+			sum += column[i];
+			rowMean[i] += column[i] / m;
+		}
+		columnMean[p] = sum / count;
+		mean += columnMean[p] / m;
+	}
+	for (int p = 0; p < m; p++)
+	{
+		float *column = &distances[(size_t) p * count];
+		float shift = (float) (mean - columnMean[p]);
+		for (int i = 0; i < count; i++)
+		{
+			column[i] = -0.5f * (column[i] - rowMean[i] + shift);
+		}
+	}
+	return project(state, edgeLength);
+}
+
+void Embedding::computeCovariance(int worker, int begin, int end)
+{
+	int m = getPivotCount();
+	for (int k = begin; k < end; k++)
+	{
+		int a = pairA[k], b = pairB[k];
+		const float *ca = &distances[(size_t) a * count];
+		const float *cb = &distances[(size_t) b * count];
+		double sum = 0;
+		for (int i = 0; i < count; i++)
+		{
+			sum += ca[i] * cb[i];
+		}
+		covariance[a * m + b] = covariance[b * m + a] = sum;
+	}
+}
+
+bool Embedding::project(Layout::LayoutState &state, double edgeLength)
+{
+	// kovariancia stlpcov m x m, stlpce su vycentrovane
+	int m = getPivotCount();
+	covariance.assign((size_t) m * m, 0);
+	pairA.clear();
+	pairB.clear();
+	for (int a = 0; a < m; a++)
+	{
+		for (int b = a; b < m; b++)
+		{
+			pairA.push_back(a);
+			pairB.push_back(b);
+		}
+	}
+	if (pool != NULL)
+	{
+		Layout::MemberTask<Embedding> covarianceTask(this, &Embedding::computeCovariance);
+		pool->run(&covarianceTask, (int) pairA.size());
+	}
+	else
+	{
+		computeCovariance(0, 0, (int) pairA.size());
+	}
+
+	// hlavne komponenty mocninovou metodou, dalsie su kolme na predchadzajuce
+	std::vector<std::vector<double> > components;
+	std::vector<double> next(m);
+	for (int d = 0; d < DIMENSIONS && d < m; d++)
+	{
+		std::vector<double> v(m);
+		for (int p = 0; p < m; p++)
+		{
+			v[p] = (double) (LayoutState::hash((unsigned int) d + 1, (unsigned int) p) % 1000) / 1000 - 0.5;
+		}
+		double norm = 0;
+		for (int it = 0; it < POWER_ITERATIONS; it++)
+		{
+			for (int a = 0; a < m; a++)
+			{
+				double sum = 0;
+				for (int b = 0; b < m; b++)
+				{
+					sum += covariance[a * m + b] * v[b];
+				}
+				next[a] = sum;
+			}
+			for (size_t c = 0; c < components.size(); c++)
+			{
+				double dot = 0;
+				for (int p = 0; p < m; p++)
+				{
+					dot += next[p] * components[c][p];
+				}
+				for (int p = 0; p < m; p++)
+				{
+					next[p] -= dot * components[c][p];
+				}
+			}
+			norm = 0;
+			for (int p = 0; p < m; p++)
+			{
+				norm += next[p] * next[p];
+			}
+			norm = sqrt(norm);
+			if (norm == 0)
+			{
+				break;
+			}
+			double change = 0;
+			for (int p = 0; p < m; p++)
+			{
+				next[p] /= norm;
+				change += (next[p] - v[p]) * (next[p] - v[p]);
+			}
+			v.swap(next);
+			if (change < POWER_EPSILON)
+			{
+				break;
+			}
+		}
+		if (norm == 0)
+		{ // embedding ma menej rozmerov, zvysne osi ostanu nulove
+			break;
+		}
+		components.push_back(v);
+	}
+
+	std::vector<float> coordinates[DIMENSIONS];
+	for (int d = 0; d < DIMENSIONS; d++)
+	{
+		coordinates[d].assign(count, 0);
+		if (d >= (int) components.size())
+		{
+			continue;
+		}
+		for (int p = 0; p < m; p++)
+		{
+			const float *column = &distances[(size_t) p * count];
+			double weight = components[d][p];
+			for (int i = 0; i < count; i++)
+			{
+				coordinates[d][i] += (float) (column[i] * weight);
+			}
+		}
+	}
+
+	// mierka podla priemernej dlzky hrany
+	double length = 0;
+	for (int u = 0; u < count; u++)
+	{
+		for (int k = offsets[u]; k < offsets[u + 1]; k++)
+		{
+			int v = neighbours[k];
+			double dx = coordinates[0][u] - coordinates[0][v];
+			double dy = coordinates[1][u] - coordinates[1][v];
+			double dz = coordinates[2][u] - coordinates[2][v];
+			length += sqrt(dx * dx + dy * dy + dz * dz);
+		}
+	}
+	length /= neighbours.size();
+	if (length <= 0)
+	{
+		return false;
+	}
+	float scale = (float) (edgeLength / length);
+	for (int i = 0; i < count; i++)
+	{
+		if (!state.fixed[i])
+		{
+			state.x[i] = coordinates[0][i] * scale;
+			state.y[i] = coordinates[1][i] * scale;
+			state.z[i] = coordinates[2][i] * scale;
+			state.vx[i] = state.vy[i] = state.vz[i] = 0;
+		}
+	}
+	return true;
+}
@@ -3,6 +3,9 @@
 using namespace Layout;
 using namespace Vwr;	
 
+const float FRAlgorithm::MULTILEVEL_START_TEMPERATURE = 1.0f;
+const float FRAlgorithm::MULTILEVEL_END_TEMPERATURE = 0.05f;
+
 
 
  //Konstruktor pre vlakno s algoritmom 
@@ -16,15 +19,22 @@ FRAlgorithm::FRAlgorithm()
 	state = RUNNING;
 	notEnd = true;	
 	center = osg::Vec3f (0,0,0);
-	fv = osg::Vec3f();
-	last = osg::Vec3f();
-	newLoc = osg::Vec3f();
-	up = osg::Vec3f();
-	vp = osg::Vec3f();	
 	
-	/* moznost odpudiveho posobenia limitovaneho vzdialenostou*/
-	useMaxDistance = false;
+	loadConfig();
+	slicePhase = SLICE_IDLE;
+	sliceNext = 0;
+	displacementSum = 0;
+	appliedCount = 0;
+	localPending = false;
+	localLeft = 0;
+	localParked = false;
+	temperature = 0;
 	isIterating = false;
+	placement = PLACEMENT_RANDOM;
+	placementPending = true;
+	packPending = false;
+	current = &layoutState;
+	pulledEdits = 0;
 	this->graph = NULL;
 }
 FRAlgorithm::FRAlgorithm(Data::Graph *graph) 
@@ -38,24 +48,84 @@ FRAlgorithm::FRAlgorithm(Data::Graph *graph)
 	notEnd = true;
 	osg::Vec3f p(0,0,0);	
 	center = p;	
-	fv = osg::Vec3f();
-	last = osg::Vec3f();
-	newLoc = osg::Vec3f();
-	up = osg::Vec3f();
-	vp = osg::Vec3f();	
 	
-	/* moznost odpudiveho posobenia limitovaneho vzdialenostou*/
-	useMaxDistance = false;
+	loadConfig();
+	slicePhase = SLICE_IDLE;
+	sliceNext = 0;
+	displacementSum = 0;
+	appliedCount = 0;
+	localPending = false;
+	localLeft = 0;
+	localParked = false;
+	temperature = 0;
 	isIterating = false;
+	placement = PLACEMENT_RANDOM;
+	placementPending = true;
+	packPending = false;
+	current = &layoutState;
+	pulledEdits = 0;
 	this->graph = graph;
 	this->Randomize();
 }
 
+void FRAlgorithm::loadConfig()
+{
+	/* moznost odpudiveho posobenia limitovaneho vzdialenostou*/
+	useMaxDistance = false;
+	/* aproximacia odpudivych sil oktalovym stromom (Barnes-Hut) alebo mriezkou s bunkami velkosti dosahu odpudivej sily */
+	Util::ApplicationConfig* appConf = Util::ApplicationConfig::get();
+	QString mode = appConf->getValue("Layout.FR.RepulsionMode");
+	repulsionMode = mode == "barneshut" ? REPULSION_BARNES_HUT : (mode == "grid" ? REPULSION_GRID : REPULSION_EXACT);
+	theta = appConf->getValue("Layout.FR.OpeningAngle").isEmpty() ? 0.8 : appConf->getValue("Layout.FR.OpeningAngle").toFloat();
+	/* vypocet sil vo viacerych vlaknach, 0 = pocet hardverovych vlakien */
+	pool = new Layout::WorkerPool(appConf->getValue("Layout.FR.ThreadCount").toInt());
+	/* instrukcna sada vektorovych kernelov sil, auto = najlepsia podporovana procesorom */
+	Layout::ForceKernels::setLevel(Layout::ForceKernels::parseLevel(appConf->getValue("Layout.FR.Kernels").toStdString().c_str()));
+	seed = appConf->getValue("Layout.FR.Seed").isEmpty() ? 1 : appConf->getValue("Layout.FR.Seed").toUInt();
+	/* obmedzenie poctu iteracii za sekundu, 0 = bez obmedzenia */
+	SetMaxIterationsPerSecond(appConf->getValue("Layout.Thread.MaxIterationsPerSecond").toInt());
+	/* sily sa pocitaju len pre uzly, ktore sa hybu alebo ich okolie sa hybe */
+	useActiveSet = appConf->getValue("Layout.FR.ActiveSet").toInt() != 0;
+	/* komponenty sa rozmiestnuju nezavisle, odpudzuju sa len uzly toho isteho komponentu */
+	useComponents = appConf->getValue("Layout.FR.Components").toInt() != 0;
+	/* ustalene rozmiestnenie sa uklada a pri dalsom otvoreni grafu sa v nom pokracuje */
+	checkpointDirectory = appConf->getValue("Layout.Checkpoint.Directory");
+	if (!checkpointDirectory.isEmpty() && QFileInfo(checkpointDirectory).isRelative())
+	{ // relativny adresar patri k datam pouzivatela, nie k pracovnemu adresaru
+		checkpointDirectory = QDir(QDesktopServices::storageLocation(QDesktopServices::DataLocation)).filePath(checkpointDirectory);
+	}
+	checkpointDirty = false;
+	/* cas vypoctu v jednej snimke prehliadaca, iteracia sa rozdeli na viac snimok, 0 = bez rozdelenia */
+	sliceMs = appConf->getValue("Layout.FR.SliceMs").toInt();
+}
+
+FRAlgorithm::~FRAlgorithm()
+{
+	delete pool;
+	pool = NULL;
+}
+
 void FRAlgorithm::SetGraph(Data::Graph *graph)
 {	
+	QMutexLocker locker(&schedulerMutex);
 	notEnd = true;
 	this->graph = graph;
-	this->Randomize();
+	layoutState.invalidate();
+	placementPending = true;
+	resetStats();
+	if (!resume())
+	{ // graf este nebol rozmiestneny
+		this->Randomize();
+	}
+	editCount.ref();
+	schedulerCondition.wakeAll();
+}
+
+void FRAlgorithm::SetMaxIterationsPerSecond(int val)
+{
+	QMutexLocker locker(&schedulerMutex);
+	minInterval = val > 0 ? 1000 / val : 0;
+	schedulerCondition.wakeAll();
 }
 void FRAlgorithm::SetParameters(float sizeFactor,float flexibility,int animationSpeed,bool useMaxDistance) 
 {
@@ -66,7 +136,9 @@ void FRAlgorithm::SetParameters(float sizeFactor,float flexibility,int animation
 	if(this->graph != NULL)
 	{
 		K = computeCalm();
+		QMutexLocker locker(&schedulerMutex);
 		graph->setFrozen(false);
+		schedulerCondition.wakeAll();
 	}
 	else
 	{
@@ -77,21 +149,21 @@ void FRAlgorithm::SetParameters(float sizeFactor,float flexibility,int animation
 /* Urci pokojovu dlzku strun */
 double FRAlgorithm::computeCalm() {
 	double R = 300;
-	float n = graph->getNodes()->count();
+	float n = graph->getNodeStore().size();
 	return sizeFactor* pow((4*R*R*R*PI)/(n*3), 1/3);
 }
 /* Rozmiestni uzly na nahodne pozicie */
 void FRAlgorithm::Randomize() 
 {
-    QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
-	j = graph->getNodes()->begin();
+	srand(seed);
+	const Data::Graph::NodeStore &nodes = graph->getNodeStore();
 
-	for (int i = 0; i < graph->getNodes()->count(); i++,++j)
+	for (int i = 0; i < nodes.size(); i++)
 	{		
-		if(!j.value()->isFixed())
+		if(!nodes.at(i)->isFixed())
 		{
 			osg::Vec3f randPos = getRandomLocation();
-			j.value()->setTargetPosition(randPos);
+			nodes.at(i)->setTargetPosition(randPos);
 		}
 	}	
 	graph->setFrozen(false);
@@ -114,25 +186,35 @@ double FRAlgorithm::getRandomDouble()
 
 void FRAlgorithm::PauseAlg() 
 {	
+	QMutexLocker locker(&schedulerMutex);
 	state = PAUSED;
+	schedulerCondition.wakeAll();
 }
 
 void FRAlgorithm::WakeUpAlg() 
 {
+	QMutexLocker locker(&schedulerMutex);
+	// pouzivatel zmenil pozicie alebo fixovanie uzlov
+	editCount.ref();
 	if(graph != NULL && state == RUNNING && graph->isFrozen())
 	{
 		graph->setFrozen(false);
+		schedulerCondition.wakeAll();
 	}
 }
 
 void FRAlgorithm::RunAlg() 
 {
+	QMutexLocker locker(&schedulerMutex);
 	if(graph != NULL)
 	{
 		K = computeCalm();
+		layoutState.invalidate();
+		editCount.ref();
 		graph->setFrozen(false);
 		state = RUNNING;
 		notEnd = true;
+		schedulerCondition.wakeAll();
 	}
 }
 
@@ -141,9 +223,11 @@ bool FRAlgorithm::IsRunning()
 	return isIterating;
 }
 
-void FRAlgorithm::terminate() 
+void FRAlgorithm::StopAlg() 
 {
+	QMutexLocker locker(&schedulerMutex);
 	notEnd = false;
+	schedulerCondition.wakeAll();
 }
 
 void FRAlgorithm::Run() 
@@ -151,29 +235,63 @@ void FRAlgorithm::Run()
 	if(this->graph != NULL)
 	{
 		isIterating = true;
+		QTime timer;
+		int iterationMs = 0;
+		QMutexLocker locker(&schedulerMutex);
 		while (notEnd) 
 		{			
-			// slucka pozastavenia - ak je pauza
-			// alebo je graf zmrazeny (spravidla pocas editacie)
-			while (state != RUNNING || graph->isFrozen()) 
+			// spime, kym nepride spustenie, prebudenie, zmena grafu alebo koniec
+			// pocas pauzy alebo ak je graf zmrazeny (spravidla pocas editacie)
+			if (state != RUNNING || graph->isFrozen()) 
 			{				
-				QThread::msleep(100);				
 				if(state == PAUSED)
 				{
-					if(isIterating)
-					{
-						isIterating = false;
-					}					
-				}							
+					isIterating = false;
+				}
+				schedulerCondition.wait(&schedulerMutex);
+				continue;
 			}
-			if(!isIterating)
+			isIterating = true;
+
+			// iteracia bezi bez zamku, riadiace metody ju neblokuju
+			timer.start();
+			locker.unlock();
+			bool changed = iterate();
+			iterationMs += timer.elapsed();
+			bool finished = slicePhase == SLICE_IDLE;
+			if (finished)
 			{
-				isIterating = true;
+				recordIteration(iterationMs, changed);
+				iterationMs = 0;
+				if (changed)
+				{
+					checkpointDirty = true;
+				}
+				else if (checkpointDirty)
+				{ // ustalene rozmiestnenie ulozime
+					saveCheckpoint(true);
+				}
 			}
-			if (!iterate()) {
+			locker.relock();
+
+			// uprava pocas iteracie graf znova rozhybala, nezmrazime ho
+			if (finished && !changed && (int) editCount == pulledEdits) {
 				graph->setFrozen(true);	
-			}			
+			}
+			// dodrzime maximalny pocet iteracii za sekundu, pri budenom krokovani zvysok snimky patri vykreslovaniu
+			int interval = sliceMs > 0 ? std::max((int) FRAME_INTERVAL, finished ? minInterval : 0) : minInterval;
+			int rest;
+			while (notEnd && state == RUNNING && (rest = interval - timer.elapsed()) > 0)
+			{
+				schedulerCondition.wait(&schedulerMutex, rest);
+			}
 		}
+		locker.unlock();
+		if (checkpointDirty)
+		{ // rozmiestnenie prerusene pred ustalenim ulozime tiez, dalsie spustenie v nom pokracuje
+			saveCheckpoint(false);
+		}
+		isIterating = false;
 	}
 	else
 	{
@@ -182,214 +300,1198 @@ void FRAlgorithm::Run()
 	}
 }
 
+bool FRAlgorithm::Step()
+{
+	if (graph == NULL)
+	{
+		cout << "Nenastaveny graf. Pouzi metodu SetGraph(Data::Graph graph).";
+		return false;
+	}
+	QTime timer;
+	timer.start();
+	bool changed;
+	do
+	{ // krok vzdy dokonci celu iteraciu
+		changed = iterate();
+	}
+	while (slicePhase != SLICE_IDLE);
+	recordIteration(timer.elapsed(), changed);
+	return changed;
+}
+
 bool FRAlgorithm::iterate()
 {	
 	bool changed = false;  		
-	{			
-        QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
-		j = graph->getNodes()->begin();
-		for (int i = 0; i < graph->getNodes()->count(); i++,++j)
-		{ // pre vsetky uzly..
-			Data::Node* node = j.value();
-			node->resetForce(); // vynulovanie posobiacej sily			
-		}		
-	}
-	{//meta uzly
-		
-		QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
-		QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator k;	
-		j = graph->getMetaNodes()->begin();
-		for (int i = 0; i < graph->getMetaNodes()->count(); i++,++j)
-		{ // pre vsetky metauzly..
-			j.value()->resetForce(); // vynulovanie posobiacej sily
-			k = graph->getMetaNodes()->begin();
-			for (int h = 0; h < graph->getMetaNodes()->count(); h++,++k)
-			{ // pre vsetky metauzly..
-				if (!j.value()->equals(k.value())) 
-				{
-					// odpudiva sila medzi metauzlami
-					addRepulsive(j.value(), k.value(), Data::Graph::getMetaStrength());
-				}
+	if (slicePhase == SLICE_IDLE && !startIteration(changed))
+	{ // iteracia skoncila bez vypoctu sil
+		return changed;
+	}
+	// rozpracovanu iteraciu budeneho krokovania dopocitame, pozicie sa medzitym nemenia
+	int updates = 0;
+	bool finished = continueForces(sliceMs, updates);
+	recordSlice(updates);
+	if (!finished || state == PAUSED)
+	{
+		return true;
+	}
+
+	// aplikuj sily na uzly a metauzly, applyForces meria posuny
+	QElapsedTimer timer;
+	timer.start();
+	sample.energy = 0;
+	sample.maxDisplacement = 0;
+	sample.moved = 0;
+	displacementSum = 0;
+	appliedCount = 0;
+	changed = usesActiveSet() ? moveActiveNodes() : moveNodes(layoutState);
+	if (layoutState.getComponentCount() > 1 && (packPending || !changed))
+	{ // komponenty zbalime po prvom rozmiestneni a po ustaleni, medzitym sa neposuvaju
+		packPending = false;
+		changed = packComponents() || changed;
+	}
+	sample.applyMs = timer.nsecsElapsed() / 1e6f;
+	sample.meanDisplacement = appliedCount > 0 ? (float) (displacementSum / appliedCount) : 0;
+	sample.iteration = GetStats().iterations + 1;
+	telemetry.record(sample);
+	// nove pozicie zverejnime naraz, uzly aktualizuje vlakno vykreslovania
+	layoutState.publish(positionBuffer, pulledEdits);
+	// vracia true ak sa ma pokracovat dalsou iteraciou
+
+	return changed;
+}
+
+bool FRAlgorithm::startIteration(bool &changed)
+{
+	prepareIteration();
+
+	if (layoutState.getCount() == 0)
+	{ // prazdny graf
+		changed = false;
+		return false;
+	}
+	if (placementPending)
+	{ // prve rozmiestnenie noveho grafu
+		placementPending = false;
+		if (resumeState.getCount() > 0)
+		{ // pokracujeme v ulozenom rozmiestneni
+			if (applyResumed())
+			{ // ulozene rozmiestnenie je ustalene, graf sa zmrazi
+				layoutState.publish(positionBuffer, pulledEdits);
+				changed = false;
+				return false;
 			}
-		}		
+		}
+		else if (placement == PLACEMENT_MULTILEVEL)
+		{
+			placeMultilevel();
+		}
+		else if (placement == PLACEMENT_SPECTRAL || placement == PLACEMENT_PIVOT_MDS)
+		{
+			placeSpectral();
+		}
 	}
-	{//meta hrany
-		
-		QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator j;
-		j = graph->getMetaEdges()->begin();
-		for (int i = 0; i < graph->getMetaEdges()->count(); i++,++j)
-		{ // pre vsetky metahrany..
-			Data::Node *u = j.value()->getSrcNode();
-			Data::Node *v = j.value()->getDstNode();
-			// uzly nikdy nebudu ignorovane
-			u->setIgnored(false);
-			v->setIgnored(false);
-			if (graph->getMetaNodes()->contains(u->getId())) {
-				// pritazliva sila, posobi na v
-				addMetaAttractive(v, u, Data::Graph::getMetaStrength());
+
+	std::vector<qlonglong> seeds;
+	int hops, iterations;
+	if (takeLocalRequest(seeds, hops, iterations))
+	{ // upraveny graf rozmiestnime najprv len v okoli uprav
+		startLocal(seeds, hops, iterations);
+	}
+	if (localLeft > 0)
+	{
+		changed = true;
+		computeLocalForces();
+		if(state == PAUSED)
+		{
+			return false;
+		}
+		bool moved = moveLocalNodes();
+		localLeft--;
+		if (localLeft == 0 || !moved)
+		{ // okolie je ustalene, zvysok grafu sa mu prisposobi v dalsich iteraciach
+			finishLocal();
+		}
+		layoutState.publish(positionBuffer, pulledEdits);
+		return false;
+	}
+
+	if (usesActiveSet())
+	{
+		if (!activeSet.isValid(layoutState.getCount()))
+		{ // novy graf alebo nove rozmiestnenie, aktivne su vsetky uzly
+			activeSet.reset(layoutState, (float) (ACTIVE_RADIUS_FACTOR * K), (float) K);
+		}
+		activeSet.update();
+		if (activeSet.getActive().empty())
+		{ // vsetky uzly su odstavene, graf je v rovnovahe, ustalene komponenty este zbalime
+			changed = layoutState.getComponentCount() > 1 && packComponents();
+			if (changed)
+			{
+				layoutState.publish(positionBuffer, pulledEdits);
+			}
+			return false;
+		}
+	}
+	// casy faz meria aj rozpracovana iteracia budeneho krokovania
+	sample.repulsionMs = sample.attractionMs = sample.applyMs = 0;
+	QElapsedTimer timer;
+	timer.start();
+	startForces(layoutState, usesActiveSet());
+	sample.repulsionMs += timer.nsecsElapsed() / 1e6f;
+	return true;
+}
+
+void FRAlgorithm::prepareIteration()
+{
+	// pocet uprav citame pred frontom uprav, neskorsia uprava sa nacita v dalsom kroku
+	int edits = (int) editCount;
+	QHash<qlonglong, Layout::LayoutState::Edit> queued;
+	takeEdits(queued);
+	if (layoutState.isStale(graph))
+	{
+		// zmenila sa topologia grafu, snimku vytvorime znova aj s upravami z frontu
+		layoutState.capture(graph);
+		if (useComponents)
+		{
+			layoutState.sortComponents();
+			packPending = true;
+		}
+		activeSet.clear();
+		localParked = false;
+		localRegion.clear();
+		localLeft = 0;
+	}
+	else if (edits != pulledEdits || !queued.isEmpty())
+	{
+		// nacitame presuny a fixovanie uzlov pouzivatelom
+		if (usesActiveSet() && activeSet.isValid(layoutState.getCount()))
+		{ // upravene uzly a ich okolie sa znova hybu
+			std::vector<int> changed;
+			layoutState.pull(queued, &changed);
+			for (size_t k = 0; k < changed.size(); k++)
+			{
+				activeSet.disturb(layoutState, changed[k]);
 			}
-			if (graph->getMetaNodes()->contains(v->getId())) {
-				// pritazliva sila, posobi na u
-				addMetaAttractive(u, v, Data::Graph::getMetaStrength());
+		}
+		else
+		{
+			layoutState.pull(queued);
+		}
+	}
+	pulledEdits = edits;
+}
+
+void FRAlgorithm::computeForces(Layout::LayoutState &snapshot)
+{
+	int updates = 0;
+	startForces(snapshot, false);
+	continueForces(0, updates);
+}
+
+void FRAlgorithm::startForces(Layout::LayoutState &snapshot, bool active)
+{
+	current = &snapshot;
+	int count = snapshot.getCount();
+	if (!active)
+	{
+		workerForces.resize(pool->getThreadCount());
+		for (size_t w = 0; w < workerForces.size(); w++)
+		{
+			if ((int) workerForces[w].size() != count)
+			{
+				workerForces[w].assign(count, osg::Vec3f(0,0,0));
 			}
 		}
 	}
-	{//uzly
-        QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
-        QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator k;
-		j = graph->getNodes()->begin();
-		for (int i = 0; i < graph->getNodes()->count(); i++,++j) 
-		{ // pre vsetky uzly..
-			k = graph->getNodes()->begin();
-			for (int h = 0; h < graph->getNodes()->count(); h++,++k) { // pre vsetky uzly..
-				if (!j.value()->equals(k.value())) {
-					// odpudiva sila beznej velkosti
-					addRepulsive(j.value(), k.value(), 1);
-				}
+	// stromy a mriezka obsahuju aj odstavene uzly, tie stale odpudzuju aktivne uzly
+	prepareRepulsion(snapshot);
+	slicePhase = active ? SLICE_ACTIVE : SLICE_META_REPULSION;
+	sliceNext = 0;
+}
+
+bool FRAlgorithm::continueForces(int budget, int &updates)
+{
+	QTime timer;
+	timer.start();
+	int count = current->getCount();
+	int nodeCount = current->getNodeCount();
+
+	Layout::MemberTask<FRAlgorithm> repulsiveTask(this, &FRAlgorithm::computeRepulsive);
+	Layout::MemberTask<FRAlgorithm> metaRepulsiveTask(this, &FRAlgorithm::computeMetaRepulsive);
+	Layout::MemberTask<FRAlgorithm> attractiveTask(this, &FRAlgorithm::computeAttractive);
+	Layout::MemberTask<FRAlgorithm> metaAttractiveTask(this, &FRAlgorithm::computeMetaAttractive);
+	Layout::MemberTask<FRAlgorithm> reduceTask(this, &FRAlgorithm::reduceForces);
+	Layout::MemberTask<FRAlgorithm> activeTask(this, &FRAlgorithm::computeActive);
+
+	// bez rozpoctu spracujeme kazdu fazu naraz, inak po castiach a po kazdej casti skontrolujeme cas
+	int chunk = budget > 0 ? SLICE_CHUNK * pool->getThreadCount() : INT_MAX;
+	while (slicePhase != SLICE_IDLE)
+	{
+		Layout::ParallelTask *task;
+		int size;
+		SlicePhase next;
+		switch (slicePhase)
+		{
+		case SLICE_META_REPULSION: // odpudiva sila medzi metauzlami, indexy su od prveho metauzla
+			task = &metaRepulsiveTask; size = count - nodeCount; next = SLICE_REPULSION; break;
+		case SLICE_REPULSION: // odpudiva sila beznej velkosti
+			task = &repulsiveTask; size = nodeCount; next = SLICE_EDGES; break;
+		case SLICE_EDGES: // kazdy pracovnik scitava pritazlive sily do vlastneho pola
+			task = &attractiveTask; size = (int) current->edgeSrc.size(); next = SLICE_META_EDGES; break;
+		case SLICE_META_EDGES:
+			task = &metaAttractiveTask; size = (int) current->metaEdgeSrc.size(); next = SLICE_REDUCE; break;
+		case SLICE_REDUCE: // polia pracovnikov scitame vzdy v rovnakom poradi
+			task = &reduceTask; size = count; next = SLICE_IDLE; break;
+		default: // aktivne uzly, pritazlive sily scitaju samy
+			task = &activeTask; size = (int) activeSet.getActive().size(); next = SLICE_IDLE; break;
+		}
+		int end = size - sliceNext > chunk ? sliceNext + chunk : size;
+		QElapsedTimer phaseTimer;
+		phaseTimer.start();
+		pool->run(task, sliceNext, end);
+		if (slicePhase == SLICE_META_REPULSION || slicePhase == SLICE_REPULSION || slicePhase == SLICE_ACTIVE)
+		{
+			updates += end - sliceNext;
+			sample.repulsionMs += phaseTimer.nsecsElapsed() / 1e6f;
+		}
+		else
+		{
+			sample.attractionMs += phaseTimer.nsecsElapsed() / 1e6f;
+		}
+		sliceNext = end;
+		if (sliceNext == size)
+		{
+			slicePhase = next;
+			sliceNext = 0;
+		}
+		if (budget > 0 && slicePhase != SLICE_IDLE && timer.elapsed() >= budget)
+		{ // zvysok iteracie dopocitame v dalsej snimke
+			return false;
+		}
+	}
+	return true;
+}
+
+void FRAlgorithm::prepareRepulsion(Layout::LayoutState &snapshot)
+{
+	int count = snapshot.getCount();
+	int nodeCount = snapshot.getNodeCount();
+	if (repulsionMode == REPULSION_BARNES_HUT)
+	{
+		metaNodeTree.build(&snapshot.x[0] + nodeCount, &snapshot.y[0] + nodeCount, &snapshot.z[0] + nodeCount, count - nodeCount);
+		if (snapshot.component.empty())
+		{
+			nodeTree.build(&snapshot.x[0], &snapshot.y[0], &snapshot.z[0], nodeCount);
+		}
+		else
+		{ // kazdy komponent ma vlastny strom, stromy stavaju pracovnici naraz
+			current = &snapshot;
+			componentTrees.resize(snapshot.getComponentCount());
+			Layout::MemberTask<FRAlgorithm> treeTask(this, &FRAlgorithm::buildComponentTrees);
+			pool->run(&treeTask, snapshot.getComponentCount());
+		}
+	}
+	else if (repulsionMode == REPULSION_GRID)
+	{
+		// mriezka sa aktualizuje len pre uzly, ktore zmenili bunku
+		nodeGrid.setCellSize(gridDistance());
+		nodeGrid.update(&snapshot.x[0], &snapshot.y[0], &snapshot.z[0], nodeCount);
+	}
+}
+
+void FRAlgorithm::buildComponentTrees(int worker, int begin, int end)
+{
+	for (int c = begin; c < end; c++)
+	{
+		int first = current->componentStart[c];
+		componentTrees[c].build(&current->x[first], &current->y[first], &current->z[first], current->componentStart[c + 1] - first);
+	}
+}
+
+bool FRAlgorithm::moveActiveNodes()
+{
+	bool changed = false;
+	current = &layoutState;
+	const std::vector<int> &active = activeSet.getActive();
+	for (size_t k = 0; k < active.size(); k++)
+	{ // pre vsetky aktivne uzly..
+		int i = active[k];
+		float distance = 0;
+		if (!layoutState.fixed[i])
+		{
+			float ox = layoutState.x[i], oy = layoutState.y[i], oz = layoutState.z[i];
+			if (applyForces(i))
+			{
+				float dx = layoutState.x[i] - ox, dy = layoutState.y[i] - oy, dz = layoutState.z[i] - oz;
+				distance = sqrtf(dx * dx + dy * dy + dz * dz);
+				changed = true;
 			}
 		}
+		activeSet.record(layoutState, i, distance);
+	}
+	return changed;
+}
+
+void FRAlgorithm::RelayoutLocal(const QLinkedList<osg::ref_ptr<Data::Node> > &seeds, int hops, int iterations)
+{
+	QMutexLocker locker(&schedulerMutex);
+	// poziadavky, ktore vlakno layoutu este neprevzalo, zlucime
+	QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator i;
+	for (i = seeds.constBegin(); i != seeds.constEnd(); ++i)
+	{
+		localSeeds.push_back((*i)->getId());
+	}
+	localHops = localPending ? std::max(localHops, hops) : hops;
+	localIterations = localPending ? std::max(localIterations, iterations) : iterations;
+	localPending = true;
+	editCount.ref();
+	if(graph != NULL && state == RUNNING)
+	{
+		graph->setFrozen(false);
+		schedulerCondition.wakeAll();
+	}
+}
+
+bool FRAlgorithm::takeLocalRequest(std::vector<qlonglong> &seeds, int &hops, int &iterations)
+{
+	QMutexLocker locker(&schedulerMutex);
+	if (!localPending)
+		return false;
+	seeds.swap(localSeeds);
+	localSeeds.clear();
+	hops = localHops;
+	iterations = localIterations;
+	localPending = false;
+	return true;
+}
+
+void FRAlgorithm::startLocal(const std::vector<qlonglong> &seeds, int hops, int iterations)
+{
+	int count = layoutState.getCount();
+	int nodeCount = layoutState.getNodeCount();
+	if (!activeSet.isValid(count))
+	{ // snimka bola prave vytvorena, zvysok grafu je uz rozmiestneny
+		activeSet.reset(layoutState, (float) (ACTIVE_RADIUS_FACTOR * K), (float) K);
+		activeSet.parkAll();
+	}
+	// zvysok grafu ostava odstaveny aj po lokalnom rozmiestneni, hybu sa len uzly, ktore okolie posunie
+	localParked = true;
+
+	std::vector<int> indices;
+	for (size_t k = 0; k < seeds.size(); k++)
+	{
+		int i = layoutState.indexOf(seeds[k]);
+		if (i != -1)
+			indices.push_back(i);
+	}
+	activeSet.collectNeighbourhood(indices, hops, LOCAL_MAX_COUNT, localRegion);
+	if (localRegion.empty())
+	{ // upravene uzly uz neexistuju
+		localLeft = 0;
+		return;
+	}
+
+	// strom kotiev, uzly mimo okolia sa pocas lokalneho rozmiestnenia nehybu
+	std::vector<unsigned char> inRegion(count, 0);
+	localSlot.assign(localRegion.size(), -1);
+	int slots = 0;
+	for (size_t k = 0; k < localRegion.size(); k++)
+	{
+		inRegion[localRegion[k]] = 1;
+		if (localRegion[k] < nodeCount)
+			localSlot[k] = slots++;
+	}
+	localX.resize(slots); localY.resize(slots); localZ.resize(slots);
+	localLeft = iterations;
+
+	// pri tahani uzla prichadza poziadavka s rovnakym okolim a nehybnymi kotvami, strom potom staviame len raz
+	int anchors = (int) anchorX.size();
+	bool reuse = localRegion == anchorRegion;
+	for (int i = 0, a = 0; i < nodeCount && reuse; i++)
+	{
+		if (!inRegion[i])
+		{
+			reuse = a < anchors && anchorX[a] == layoutState.x[i] && anchorY[a] == layoutState.y[i] && anchorZ[a] == layoutState.z[i];
+			a++;
+		}
+	}
+	if (reuse && nodeCount - slots == anchors)
+	{
+		return;
 	}
-	{//hrany
-        QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator j;
-		j = graph->getEdges()->begin();
-		for (int i = 0; i < graph->getEdges()->count(); i++,++j)
-		{ // pre vsetky hrany..
-			// pritazliva sila beznej velkosti
-			addAttractive(j.value(), 1);
+	anchorX.clear(); anchorY.clear(); anchorZ.clear();
+	for (int i = 0; i < nodeCount; i++)
+	{
+		if (!inRegion[i])
+		{
+			anchorX.push_back(layoutState.x[i]);
+			anchorY.push_back(layoutState.y[i]);
+			anchorZ.push_back(layoutState.z[i]);
 		}
-	}	
-	if(state == PAUSED) 
+	}
+	anchors = (int) anchorX.size();
+	anchorTree.build(anchors > 0 ? &anchorX[0] : NULL, anchors > 0 ? &anchorY[0] : NULL, anchors > 0 ? &anchorZ[0] : NULL, anchors);
+	anchorRegion = localRegion;
+}
+
+void FRAlgorithm::computeLocalForces()
+{
+	current = &layoutState;
+	for (size_t k = 0; k < localRegion.size(); k++)
 	{
-		return true;
+		if (localSlot[k] != -1)
+		{
+			localX[localSlot[k]] = layoutState.x[localRegion[k]];
+			localY[localSlot[k]] = layoutState.y[localRegion[k]];
+			localZ[localSlot[k]] = layoutState.z[localRegion[k]];
+		}
 	}
-	
-	// aplikuj sily na uzly
-	{	
-        QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
-		j = graph->getNodes()->begin();
-		for (int i = 0; i < graph->getNodes()->count(); i++,++j)
-		{ // pre vsetky uzly..
-			if (!j.value()->isFixed()) {
-				last = j.value()->getTargetPosition();
-				bool fo = applyForces(j.value());
-				changed = changed || fo;
+	int slots = (int) localX.size();
+	localTree.build(slots > 0 ? &localX[0] : NULL, slots > 0 ? &localY[0] : NULL, slots > 0 ? &localZ[0] : NULL, slots);
+	Layout::MemberTask<FRAlgorithm> localTask(this, &FRAlgorithm::computeLocal);
+	pool->run(&localTask, (int) localRegion.size());
+}
+
+bool FRAlgorithm::moveLocalNodes()
+{
+	bool changed = false;
+	current = &layoutState;
+	for (size_t k = 0; k < localRegion.size(); k++)
+	{ // pre vsetky uzly okolia..
+		int i = localRegion[k];
+		if (!layoutState.fixed[i])
+		{
+			bool fo = applyForces(i);
+			changed = changed || fo;
+		}
+	}
+	return changed;
+}
+
+void FRAlgorithm::finishLocal()
+{
+	// hranica okolia a blizke uzly sa prisposobia v mnozine aktivnych uzlov
+	for (size_t k = 0; k < localRegion.size(); k++)
+	{
+		activeSet.disturb(layoutState, localRegion[k]);
+	}
+	localRegion.clear();
+	localLeft = 0;
+}
+
+bool FRAlgorithm::moveNodes(Layout::LayoutState &snapshot)
+{
+	bool changed = false;
+	current = &snapshot;
+	int count = snapshot.getCount();
+	for (int i = 0; i < count; i++)
+	{ // pre vsetky uzly..
+		if (!snapshot.fixed[i]) {
+			bool fo = applyForces(i);
+			changed = changed || fo;
+		}
+	}
+	return changed;
+}
+
+bool FRAlgorithm::packComponents()
+{
+	int components = layoutState.getComponentCount();
+	int nodeCount = layoutState.getNodeCount();
+	int count = layoutState.getCount();
+	std::vector<osg::Vec3f> centers(components, osg::Vec3f(0,0,0));
+	std::vector<float> radii(components, 0);
+	std::vector<unsigned char> anchored(components, 0);
+	std::vector<std::pair<int, int> > order(components);
+	for (int c = 0; c < components; c++)
+	{
+		int begin = layoutState.componentStart[c];
+		int end = layoutState.componentStart[c + 1];
+		for (int i = begin; i < end; i++)
+		{
+			centers[c] += layoutState.getPosition(i);
+		}
+		centers[c] /= (float) (end - begin);
+		// poradie podla poctu uzlov sa pocas rozmiestnovania nemeni, komponenty neprehadzuju miesta
+		order[c] = std::make_pair(begin - end, c);
+	}
+	// metauzol patri ku komponentu svojich uzlov, jeho fixovanie drzi komponent tiez
+	for (int i = 0; i < count; i++)
+	{
+		int c = layoutState.component[i];
+		if (c != -1)
+		{
+			radii[c] = std::max(radii[c], (layoutState.getPosition(i) - centers[c]).length());
+			anchored[c] |= layoutState.fixed[i];
+		}
+	}
+	// medzi gulami ostane medzera dlzky hrany, mriezka odpudzuje uzly az do svojho dosahu
+	float volume = 0;
+	for (int c = 0; c < components; c++)
+	{
+		radii[c] += (repulsionMode == REPULSION_GRID ? gridDistance() : (float) K) / 2;
+		if (!anchored[c])
+		{
+			volume += pow(2 * radii[c], 3);
+		}
+	}
+	std::sort(order.begin(), order.end());
+	int largest = -1;
+	for (int k = 0; k < components && largest == -1; k++)
+	{
+		largest = anchored[order[k].second] ? -1 : order[k].second;
+	}
+	if (largest == -1)
+	{ // vsetky komponenty su fixovane
+		return false;
+	}
+
+	// gule ukladame do radov pozdlz x, rady pozdlz y do vrstiev, vrstvy nad seba, sirka priblizne zodpoveda kocke
+	// prvy prechod urci rozmery balika, druhy ho vycentruje do stredu grafu a vynecha miesta fixovanych komponentov
+	float width = std::max((float) pow(volume, 1.0f / 3), 2 * radii[largest]);
+	std::vector<osg::Vec3f> targets(components);
+	osg::Vec3f shift(0,0,0);
+	for (int pass = 0; pass < 2; pass++)
+	{
+		osg::Vec3f low(0,0,0), high(0,0,0);
+		float px = 0, py = 0, pz = 0, rowDepth = 0, layerHeight = 0;
+		for (int k = 0; k < components; k++)
+		{
+			int c = order[k].second;
+			if (anchored[c])
+			{
+				continue;
 			}
-			else
+			float size = 2 * radii[c];
+			bool vacant = false;
+			while (!vacant)
 			{
-				changed = false;
+				if (px > 0 && px + size > width)
+				{ // novy rad
+					px = 0;
+					py += rowDepth;
+					rowDepth = 0;
+				}
+				if (py > 0 && py + size > width)
+				{ // nova vrstva
+					py = 0;
+					pz += layerHeight;
+					layerHeight = 0;
+				}
+				targets[c].set(px + size / 2, py + size / 2, pz + size / 2);
+				vacant = true;
+				for (int a = 0; a < components && pass == 1 && vacant; a++)
+				{
+					vacant = !anchored[a] || (targets[c] + shift - centers[a]).length() >= radii[c] + radii[a];
+				}
+				high.set(std::max(high.x(), px + size), std::max(high.y(), py + size), std::max(high.z(), pz + size));
+				px += size;
+				rowDepth = std::max(rowDepth, size);
+				layerHeight = std::max(layerHeight, size);
 			}
 		}
+		if (pass == 0)
+		{
+			shift = center - (low + high) / 2;
+		}
+	}
+
+	// komponenty posunieme naraz aj s ich metauzlami
+	std::vector<osg::Vec3f> deltas(components);
+	std::vector<float> distances(components, 0);
+	bool moved = false;
+	for (int c = 0; c < components; c++)
+	{
+		deltas[c] = targets[c] + shift - centers[c];
+		if (!anchored[c] && deltas[c].length() >= MIN_MOVEMENT)
+		{ // fixovany uzol drzi komponent na mieste
+			distances[c] = deltas[c].length();
+			moved = true;
+		}
 	}
-	// aplikuj sily na metauzly
+	bool record = usesActiveSet() && activeSet.isValid(count);
+	for (int i = 0; i < count && moved; i++)
 	{
-		QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
-		j = graph->getMetaNodes()->begin();
-		for (int i = 0; i < graph->getMetaNodes()->count(); i++,++j) 
-		{ // pre vsetky metauzly..
-			if (!j.value()->isFixed()) {
-				bool fo = applyForces(j.value());
-				changed = changed || fo;
+		int c = layoutState.component[i];
+		if (c == -1 || distances[c] == 0)
+		{
+			continue;
+		}
+		layoutState.setPosition(i, layoutState.getPosition(i) + deltas[c]);
+		if (record)
+		{
+			activeSet.record(layoutState, i, distances[c]);
+		}
+	}
+	return moved;
+}
+
+void FRAlgorithm::placeMultilevel()
+{
+	Layout::Multilevel hierarchy;
+	hierarchy.build(layoutState, MULTILEVEL_MIN_COUNT, seed);
+	int levels = hierarchy.getLevelCount();
+	if (levels == 0)
+	{ // graf je maly alebo sa neda zhrubit
+		return;
+	}
+
+	double fineK = K;
+	int fineCount = layoutState.getNodeCount();
+	srand(seed);
+	for (int level = levels; level >= 0 && notEnd; level--)
+	{ // uroven 0 je povodny graf, jeho ochladenie dokonci bezne iteracie
+		Layout::LayoutState &coarse = level > 0 ? hierarchy.getLevel(level) : layoutState;
+		// pokojova dlzka rastie s objemom, ktory pripada na jeden uzol urovne
+		K = fineK * pow((double) fineCount / coarse.getCount(), 1.0 / 3);
+
+		if (level == levels)
+		{ // najhrubsiu uroven rozmiestnime nahodne
+			for (int i = 0; i < coarse.getCount(); i++)
+			{
+				if (!coarse.fixed[i])
+				{
+					coarse.setPosition(i, getRandomLocation());
+				}
 			}
 		}
+		// mensie urovne maju viac iteracii, teplota klesa geometricky pocas rozpoctu urovne
+		int iterations = MULTILEVEL_LEVEL_WORK / coarse.getCount();
+		if (iterations < MULTILEVEL_LEVEL_ITERATIONS)
+			iterations = MULTILEVEL_LEVEL_ITERATIONS;
+		if (iterations > MULTILEVEL_COARSEST_ITERATIONS)
+			iterations = MULTILEVEL_COARSEST_ITERATIONS;
+		double cooling = pow((double) MULTILEVEL_END_TEMPERATURE / MULTILEVEL_START_TEMPERATURE, 1.0 / iterations);
+		temperature = (float) (MULTILEVEL_START_TEMPERATURE * K);
+		for (int i = 0; i < iterations && notEnd; i++)
+		{
+			computeForces(coarse);
+			if (!moveNodes(coarse))
+				break;
+			temperature *= (float) cooling;
+		}
+		temperature = 0;
+
+		if (level > 0)
+		{ // uzly jemnejsej urovne umiestnime do pozicie ich skupiny
+			hierarchy.prolong(level, level > 1 ? hierarchy.getLevel(level - 1) : layoutState, (float) (K / 4));
+		}
 	}
-	// vracia true ak sa ma pokracovat dalsou iteraciou
+	K = fineK;
+	current = &layoutState;
+	activeSet.clear();
+	localParked = false;
 
-	return changed;
+	// rozmiestnenie zverejnime, dalsie iteracie ho uz len doladuju
+	layoutState.publish(positionBuffer, pulledEdits);
+}
+
+const char *FRAlgorithm::GetName() const
+{
+	switch (placement)
+	{
+	case PLACEMENT_MULTILEVEL:
+		return "multilevel";
+	case PLACEMENT_SPECTRAL:
+		return "spectral";
+	case PLACEMENT_PIVOT_MDS:
+		return "pivotmds-fr";
+	default:
+		return "fr";
+	}
+}
+
+void FRAlgorithm::placeSpectral()
+{
+	Layout::Embedding embedding(pool);
+	bool placed;
+	if (placement == PLACEMENT_PIVOT_MDS)
+	{
+		embedding.build(layoutState, EMBEDDING_PIVOTS, seed, Layout::Embedding::PIVOTS_RANDOM);
+		placed = embedding.placeMds(layoutState, K);
+	}
+	else
+	{
+		embedding.build(layoutState, EMBEDDING_PIVOTS, seed);
+		placed = embedding.place(layoutState, K);
+	}
+	if (!placed)
+	{ // graf bez hran ostane nahodne rozmiestneny
+		return;
+	}
+	activeSet.clear();
+	localParked = false;
+
+	// rozmiestnenie zverejnime, dalsie iteracie ho uz len doladuju
+	layoutState.publish(positionBuffer, pulledEdits);
+}
+
+bool FRAlgorithm::resume()
+{
+	resumeState.clear();
+	if (checkpointDirectory.isEmpty())
+	{
+		return false;
+	}
+	resumeState.capture(graph);
+	if (resumeState.getCount() == 0 || !Layout::Checkpoint::load(checkpointDirectory, resumeState, resumeHeader))
+	{
+		resumeState.clear();
+		return false;
+	}
+	// pozicie a fixovanie zapiseme do uzlov ako Randomize, rychlosti prevezme prva iteracia
+	for (int i = 0; i < resumeState.getCount(); i++)
+	{
+		Data::Node *node = resumeState.nodes[i].get();
+		node->setTargetPosition(resumeState.getPosition(i));
+		if (node->isFixed() != (resumeState.fixed[i] != 0))
+		{
+			node->setFixed(resumeState.fixed[i] != 0);
+		}
+	}
+	restoreStats(resumeHeader.iterations, resumeHeader.converged);
+	graph->setFrozen(false);
+	return true;
+}
+
+bool FRAlgorithm::applyResumed()
+{
+	for (int i = 0; i < layoutState.getCount(); i++)
+	{
+		int j = resumeState.indexOf(layoutState.ids[i]);
+		if (j != -1)
+		{
+			layoutState.vx[i] = resumeState.vx[j];
+			layoutState.vy[i] = resumeState.vy[j];
+			layoutState.vz[i] = resumeState.vz[j];
+		}
+	}
+	resumeState.clear();
+	// s inymi parametrami sa rozmiestnenie z ulozenych pozicii len doladi
+	bool converged = resumeHeader.converged && resumeHeader.engine == GetName()
+		&& resumeHeader.sizeFactor == sizeFactor && resumeHeader.flexibility == flexibility
+		&& resumeHeader.useMaxDistance == useMaxDistance;
+	checkpointDirty = !converged;
+	return converged;
+}
+
+void FRAlgorithm::saveCheckpoint(bool converged)
+{
+	checkpointDirty = false;
+	if (checkpointDirectory.isEmpty() || layoutState.getCount() == 0)
+	{
+		return;
+	}
+	Layout::Checkpoint::Header header;
+	header.engine = GetName();
+	header.sizeFactor = sizeFactor;
+	header.flexibility = flexibility;
+	header.useMaxDistance = useMaxDistance;
+	header.iterations = GetStats().iterations;
+	header.converged = converged;
+	if (!Layout::Checkpoint::save(checkpointDirectory, layoutState, header))
+	{
+		qWarning() << "Rozmiestnenie sa nepodarilo ulozit do" << checkpointDirectory;
+	}
+}
+
+void FRAlgorithm::computeRepulsive(int worker, int begin, int end)
+{
+	for (int i = begin; i < end; i++)
+	{ // pre vsetky uzly..
+		float fx = 0, fy = 0, fz = 0;
+		addNodeRepulsive(i, fx, fy, fz);
+		current->fx[i] = fx;
+		current->fy[i] = fy;
+		current->fz[i] = fz;
+	}
+}
+
+void FRAlgorithm::computeMetaRepulsive(int worker, int begin, int end)
+{
+	int nodeCount = current->getNodeCount();
+	for (int i = nodeCount + begin; i < nodeCount + end; i++)
+	{ // pre vsetky metauzly..
+		float fx = 0, fy = 0, fz = 0;
+		addMetaNodeRepulsive(i, fx, fy, fz);
+		current->fx[i] = fx;
+		current->fy[i] = fy;
+		current->fz[i] = fz;
+	}
+}
+
+void FRAlgorithm::computeActive(int worker, int begin, int end)
+{
+	const int *active = &activeSet.getActive()[0];
+	int nodeCount = current->getNodeCount();
+	for (int k = begin; k < end; k++)
+	{ // pre vsetky aktivne uzly..
+		int i = active[k];
+		float fx = 0, fy = 0, fz = 0;
+		if (i < nodeCount)
+		{
+			addNodeRepulsive(i, fx, fy, fz);
+		}
+		else
+		{
+			addMetaNodeRepulsive(i, fx, fy, fz);
+		}
+		// pritazlive sily scita uzol sam, jeho susedia mozu byt odstaveni
+		addNeighbourAttractive(i, fx, fy, fz);
+		current->fx[i] = fx;
+		current->fy[i] = fy;
+		current->fz[i] = fz;
+	}
+}
+
+void FRAlgorithm::computeLocal(int worker, int begin, int end)
+{
+	int nodeCount = current->getNodeCount();
+	int count = current->getCount();
+	const float *x = &current->x[0], *y = &current->y[0], *z = &current->z[0];
+	float metaFactor = Data::Graph::getMetaStrength();
+	for (int k = begin; k < end; k++)
+	{ // pre vsetky uzly okolia..
+		int i = localRegion[k];
+		float fx = 0, fy = 0, fz = 0;
+		if (i < nodeCount)
+		{
+			// kotvy sa nehybu, ich strom je postaveny raz, strom okolia v kazdej iteracii
+			addRepulsive(x[i], y[i], z[i], -1, anchorTree, 1, fx, fy, fz);
+			addRepulsive(x[i], y[i], z[i], localSlot[k], localTree, 1, fx, fy, fz);
+		}
+		else
+		{
+			// metauzlov je malo, odpudzuju sa presne
+			int zeros = Layout::ForceKernels::repulsive(x[i], y[i], z[i], x, y, z, nodeCount, count, repulsiveStrength(metaFactor), maxDistance2(), fx, fy, fz);
+			if (zeros > 1)
+			{
+				addCoincident(i, nodeCount, count, metaFactor, fx, fy, fz);
+			}
+		}
+		addNeighbourAttractive(i, fx, fy, fz);
+		current->fx[i] = fx;
+		current->fy[i] = fy;
+		current->fz[i] = fz;
+	}
+}
+
+void FRAlgorithm::addNeighbourAttractive(int i, float &fx, float &fy, float &fz) const
+{
+	const int *edgeNeighbours = activeSet.getEdgeNeighbours();
+	const int *metaNeighbours = activeSet.getMetaNeighbours();
+	int nodeCount = current->getNodeCount();
+	const float *x = &current->x[0], *y = &current->y[0], *z = &current->z[0];
+	float factor = (float) (1 / K);
+	float metaFactor = (float) (Data::Graph::getMetaStrength() / K);
+	for (int n = activeSet.getEdgeBegin(i); n < activeSet.getEdgeEnd(i); n++)
+	{
+		int j = edgeNeighbours[n];
+		Layout::ForceKernels::attractivePair(x[j] - x[i], y[j] - y[i], z[j] - z[i], factor, fx, fy, fz);
+	}
+	for (int n = activeSet.getMetaBegin(i); n < activeSet.getMetaEnd(i); n++)
+	{
+		int j = metaNeighbours[n];
+		if (j >= nodeCount)
+		{ // metauzol pritahuje uzol
+			Layout::ForceKernels::attractivePair(x[j] - x[i], y[j] - y[i], z[j] - z[i], metaFactor, fx, fy, fz);
+		}
+	}
+}
+
+void FRAlgorithm::addNodeRepulsive(int i, float &fx, float &fy, float &fz) const
+{
+	int nodeCount = current->getNodeCount();
+	const float *x = &current->x[0], *y = &current->y[0], *z = &current->z[0];
+	if (repulsionMode == REPULSION_BARNES_HUT)
+	{
+		// odpudiva sila aproximovana stromom, pri komponentoch stromom komponentu
+		if (current->component.empty())
+		{
+			addRepulsive(x[i], y[i], z[i], i, nodeTree, 1, fx, fy, fz);
+		}
+		else
+		{
+			int c = current->component[i];
+			addRepulsive(x[i], y[i], z[i], i - current->componentStart[c], componentTrees[c], 1, fx, fy, fz);
+		}
+	}
+	else if (repulsionMode == REPULSION_GRID)
+	{
+		// odpudiva sila len od uzlov v susednych bunkach
+		addRepulsive(i, nodeGrid, 1, fx, fy, fz);
+	}
+	else
+	{
+		// vsetky uzly naraz vektorovym kernelom, pri komponentoch len uzly komponentu
+		int begin = 0, end = nodeCount;
+		if (!current->component.empty())
+		{
+			begin = current->componentStart[current->component[i]];
+			end = current->componentStart[current->component[i] + 1];
+		}
+		int zeros = Layout::ForceKernels::repulsive(x[i], y[i], z[i], x, y, z, begin, end, repulsiveStrength(1), maxDistance2(), fx, fy, fz);
+		if (zeros > 1)
+		{ // okrem samotneho uzla s nim splyvaju dalsie uzly
+			addCoincident(i, begin, end, 1, fx, fy, fz);
+		}
+	}
+}
+
+void FRAlgorithm::addMetaNodeRepulsive(int i, float &fx, float &fy, float &fz) const
+{
+	int nodeCount = current->getNodeCount();
+	int count = current->getCount();
+	const float *x = &current->x[0], *y = &current->y[0], *z = &current->z[0];
+	float factor = Data::Graph::getMetaStrength();
+	if (repulsionMode == REPULSION_BARNES_HUT)
+	{
+		addRepulsive(x[i], y[i], z[i], i - nodeCount, metaNodeTree, factor, fx, fy, fz);
+	}
+	else
+	{
+		int zeros = Layout::ForceKernels::repulsive(x[i], y[i], z[i], x, y, z, nodeCount, count, repulsiveStrength(factor), maxDistance2(), fx, fy, fz);
+		if (zeros > 1)
+		{
+			addCoincident(i, nodeCount, count, factor, fx, fy, fz);
+		}
+	}
+}
+
+void FRAlgorithm::computeAttractive(int worker, int begin, int end)
+{
+	if (begin >= end)
+		return;
+	std::vector<osg::Vec3f> &buffer = workerForces[worker];
+	const int *edgeSrc = &current->edgeSrc[0];
+	const int *edgeDst = &current->edgeDst[0];
+	// sily hran pocitame vektorovym kernelom po blokoch a az potom ich rozdelime uzlom
+	float fx[256], fy[256], fz[256];
+	for (int block = begin; block < end; block += 256)
+	{ // pre vsetky hrany..
+		int count = end - block < 256 ? end - block : 256;
+		// pritazliva sila beznej velkosti
+		Layout::ForceKernels::attractive(edgeSrc + block, edgeDst + block, count,
+			&current->x[0], &current->y[0], &current->z[0], (float) (1 / K), fx, fy, fz);
+		for (int i = 0; i < count; i++)
+		{
+			osg::Vec3f force(fx[i], fy[i], fz[i]);
+			buffer[edgeSrc[block + i]] += force;
+			buffer[edgeDst[block + i]] -= force;
+		}
+	}
+}
+
+void FRAlgorithm::computeMetaAttractive(int worker, int begin, int end)
+{
+	std::vector<osg::Vec3f> &buffer = workerForces[worker];
+	int nodeCount = current->getNodeCount();
+	const float *x = &current->x[0], *y = &current->y[0], *z = &current->z[0];
+	float factor = (float) (Data::Graph::getMetaStrength() / K);
+	for (int i = begin; i < end; i++)
+	{ // pre vsetky metahrany..
+		int u = current->metaEdgeSrc[i];
+		int v = current->metaEdgeDst[i];
+		if (u >= nodeCount) {
+			// pritazliva sila, posobi na v
+			addAttractive(x[u] - x[v], y[u] - y[v], z[u] - z[v], factor, buffer[v]);
+		}
+		if (v >= nodeCount) {
+			// pritazliva sila, posobi na u
+			addAttractive(x[v] - x[u], y[v] - y[u], z[v] - z[u], factor, buffer[u]);
+		}
+	}
+}
+
+void FRAlgorithm::reduceForces(int worker, int begin, int end)
+{
+	for (size_t w = 0; w < workerForces.size(); w++)
+	{
+		std::vector<osg::Vec3f> &buffer = workerForces[w];
+		for (int i = begin; i < end; i++)
+		{
+			current->fx[i] += buffer[i].x();
+			current->fy[i] += buffer[i].y();
+			current->fz[i] += buffer[i].z();
+			buffer[i] = osg::Vec3f(0,0,0);
+		}
+	}
 }
 
-bool FRAlgorithm::applyForces(Data::Node* node) 
+bool FRAlgorithm::applyForces(int i) 
 {
 	// nakumulovana sila
-	osg::Vec3f fv = node->getForce();
+	osg::Vec3f fv(current->fx[i], current->fy[i], current->fz[i]);
 	// zmensenie
 	fv *= ALPHA;
 	float l = fv.length();
+	appliedCount++;
 	if (l > MIN_MOVEMENT)
 	{ // nie je sila primala?
-		if (l > MAX_MOVEMENT)
+		if (l > MAX_MOVEMENT && temperature == 0)
 		{ // je sila privelka?			
 			fv.normalize();
 			fv *= 5;
 		}
 		// pricitame aktualnu rychlost
-		fv += node->getVelocity();
+		fv += osg::Vec3f(current->vx[i], current->vy[i], current->vz[i]);
+		if (temperature > 0 && fv.length() > temperature)
+		{ // pri viacurovnovom rozmiestneni posun obmedzuje teplota urovne
+			fv *= temperature / fv.length();
+		}
 		// ulozime novu polohu
-		node->setTargetPosition(node->getTargetPosition() + fv);
+		current->x[i] += fv.x();
+		current->y[i] += fv.y();
+		current->z[i] += fv.z();
+		float distance = fv.length();
+		sample.moved++;
+		sample.maxDisplacement = std::max(sample.maxDisplacement, distance);
+		displacementSum += distance;
 		
 		// energeticka strata = 1-flexibilita
 		fv *= flexibility;
-		node->setVelocity(fv); // ulozime novu rychlost
-		//node->setForce(*fv);
+		// ulozime novu rychlost
+		current->vx[i] = fv.x();
+		current->vy[i] = fv.y();
+		current->vz[i] = fv.z();
+		sample.energy += fv.length2() / 2;
 		return true;
 	} else {
-		node->resetVelocity(); // vynulovanie rychlosti
+		// vynulovanie rychlosti
+		current->vx[i] = current->vy[i] = current->vz[i] = 0;
 		return false;
 	}
 }
 
 /* Pricitanie pritazlivych sil */
-void FRAlgorithm::addAttractive(Data::Edge* edge, float factor) {
-	up = edge->getSrcNode()->getTargetPosition();
-	vp = edge->getDstNode()->getTargetPosition();
-	dist = distance(up,vp);
-	if (dist == 0)
-		return;
-	fv = vp - up; // smer sily
-	fv.normalize();
-	fv *= attr(dist) * factor;// velkost sily
-	edge->getSrcNode()->addForce(fv);
-	fv = center - fv;
-	edge->getDstNode()->addForce(fv);
-}
-
-/* Pricitanie pritazlivych sil od metazla */
-void FRAlgorithm::addMetaAttractive(Data::Node* u, Data::Node* meta, float factor) {
-	up = u->getTargetPosition();
-	vp = meta->getTargetPosition();
-	dist = distance(up,vp);
-	if (dist == 0)
-		return;
-	fv = vp - up;// smer sily
-	fv.normalize();
-	fv *= attr(dist) * factor;// velkost sily
-	u->addForce(fv);
+void FRAlgorithm::addAttractive(float dx, float dy, float dz, float factor, osg::Vec3f &force) const {
+	float fx = 0, fy = 0, fz = 0;
+	Layout::ForceKernels::attractivePair(dx, dy, dz, factor, fx, fy, fz);
+	force += osg::Vec3f(fx, fy, fz);
 }
 
 /* Pricitanie odpudivych sil */
-void FRAlgorithm::addRepulsive(Data::Node* u, Data::Node* v, float factor) {
-	up = u->getTargetPosition();
-	vp = v->getTargetPosition();
-	dist = distance(up,vp);
-	if (useMaxDistance && dist > MAX_DISTANCE) {
+void FRAlgorithm::addRepulsive(float ux, float uy, float uz, float vx, float vy, float vz, float factor, unsigned int pair, float &fx, float &fy, float &fz) const {
+	float dx = vx - ux, dy = vy - uy, dz = vz - uz;
+	float d2 = dx * dx + dy * dy + dz * dz;
+	if (d2 > maxDistance2()) {
 		return;
 	}
-	if (dist == 0) {
-		// pri splynuti uzlov medzi nimi vytvorime malu vzdialenost
-		vp.set(vp.x() + (rand() % 10), vp.y() + (rand() % 10), vp.z() + (rand() % 10));
-		dist = distance(up,vp);
+	if (d2 == 0) {
+		// pri splynuti uzlov medzi nimi vytvorime malu vzdialenost, pre kazdu dvojicu inu
+		dx = (float) (1 + pair % 9);
+		dy = (float) (1 + (pair / 9) % 9);
+		dz = (float) (1 + (pair / 81) % 9);
 	}
-	fv = (vp - up);// smer sily
-	fv.normalize();
-	fv *= rep(dist) * factor;// velkost sily
-	u->addForce(fv);
+	Layout::ForceKernels::repulsivePair(dx, dy, dz, repulsiveStrength(factor), fx, fy, fz);
 }
-/* Vzorec na vypocet odpudivej sily */
-float FRAlgorithm::rep(double distance) {
-	return (float) (-(K * K) / distance);
+
+/* Pricitanie odpudivych sil uzlov zo susednych buniek mriezky */
+void FRAlgorithm::addRepulsive(int i, const Layout::SpatialGrid &grid, float factor, float &fx, float &fy, float &fz) const {
+	const float *x = &current->x[0], *y = &current->y[0], *z = &current->z[0];
+	const float *gx = grid.getX(), *gy = grid.getY(), *gz = grid.getZ();
+	const int *neighbours = grid.getNeighbours();
+	float strength = repulsiveStrength(factor);
+	float max2 = gridDistance() * gridDistance();
+
+	int cell = grid.getCellOf(i);
+	int zeros = 0;
+	for (int n = grid.getNeighbourBegin(cell); n < grid.getNeighbourEnd(cell); n++)
+	{ // bunky su v poliach mriezky suvisle, kernel ich spracuje vektorovo
+		int c = neighbours[n];
+		zeros += Layout::ForceKernels::repulsive(x[i], y[i], z[i], gx, gy, gz, grid.getBegin(c), grid.getEnd(c), strength, max2, fx, fy, fz);
+	}
+	if (zeros > 1)
+	{ // splyvajuce uzly su vzdy v rovnakej bunke
+		const int *nodes = grid.getNodes();
+		for (int s = grid.getBegin(cell); s < grid.getEnd(cell); s++)
+		{
+			int h = nodes[s];
+			if (h != i && x[h] == x[i] && y[h] == y[i] && z[h] == z[i])
+			{
+				addRepulsive(x[i], y[i], z[i], x[h], y[h], z[h], factor, pairHash(i, h), fx, fy, fz);
+			}
+		}
+	}
 }
 
-/* Vzorec na vypocet pritazlivej sily */
-float FRAlgorithm::attr(double distance) {
-	return (float) ((distance * distance) / K);
+/* Odpudive sily splyvajucich uzlov, ktore kernel preskocil */
+void FRAlgorithm::addCoincident(int i, int begin, int end, float factor, float &fx, float &fy, float &fz) const {
+	const float *x = &current->x[0], *y = &current->y[0], *z = &current->z[0];
+	for (int h = begin; h < end; h++)
+	{
+		if (h != i && x[h] == x[i] && y[h] == y[i] && z[h] == z[i])
+		{
+			addRepulsive(x[i], y[i], z[i], x[h], y[h], z[h], factor, pairHash(i, h), fx, fy, fz);
+		}
+	}
 }
 
-/* Vzorec na vypocet dostredivej sily */
-float FRAlgorithm::centr(double distance) {
-	return (float) distance;
+/* Pricitanie odpudivych sil vsetkych uzlov stromu, vzdialene bunky nahradime ich taziskom */
+void FRAlgorithm::addRepulsive(float ux, float uy, float uz, int self, const Layout::Octree &tree, float factor, float &fx, float &fy, float &fz) const {
+	if (tree.isEmpty())
+		return;
+
+	const std::vector<Layout::Octree::Cell> &cells = tree.getCells();
+	float theta2 = theta * theta;
+
+	// zasobnik prehladavania do hlbky, na kazdej urovni zostane najviac 7 surodencov
+	int stack[8 * (Layout::Octree::MAX_DEPTH + 1)];
+	int top = 0;
+	stack[top++] = 0;
+
+	while (top > 0)
+	{
+		int index = stack[--top];
+		const Layout::Octree::Cell &cell = cells[index];
+		float mass = cell.mass;
+		if (mass == 0)
+			continue;
+		const osg::Vec3f &mc = cell.massCenter;
+
+		if (cell.leaf)
+		{
+			if (cell.point == self)
+			{ // uzol neodpudzuje sam seba, zvysne splyvajuce uzly ano
+				mass -= 1;
+				if (mass <= 0)
+					continue;
+			}
+			addRepulsive(ux, uy, uz, mc.x(), mc.y(), mc.z(), mass * factor, pairHash(self, cell.point == self ? -index : cell.point), fx, fy, fz);
+			continue;
+		}
+
+		float dx = mc.x() - ux, dy = mc.y() - uy, dz = mc.z() - uz;
+		float d2 = dx * dx + dy * dy + dz * dz;
+		if (useMaxDistance)
+		{ // cela bunka je mimo dosahu odpudivej sily
+			float reach = MAX_DISTANCE + 1.7320508f * cell.halfSize;
+			if (d2 > reach * reach)
+				continue;
+		}
+		if (d2 > 0 && 4 * cell.halfSize * cell.halfSize < theta2 * d2)
+		{ // bunka je dost daleko, nahradime ju taziskom
+			addRepulsive(ux, uy, uz, mc.x(), mc.y(), mc.z(), mass * factor, pairHash(self, -index), fx, fy, fz);
+			continue;
+		}
+		for (int i = 0; i < 8; i++)
+		{
+			if (cell.children[i] != -1)
+				stack[top++] = cell.children[i];
+		}
+	}
 }
 
-double FRAlgorithm::distance(osg::Vec3f u,osg::Vec3f v)
+unsigned int FRAlgorithm::pairHash(int u, int v) const
 {
-	osg::Vec3f x = u - v;
-	return (double) x.length();
+	unsigned int h = seed ^ ((unsigned int) u * 73856093u) ^ ((unsigned int) v * 19349663u);
+	h ^= h >> 13;
+	h *= 0x5bd1e995u;
+	h ^= h >> 15;
+	return h;
+}
+
+/* Vzorec na vypocet dostredivej sily */
+float FRAlgorithm::centr(double distance) const {
+	return (float) distance;
 }
@@ -0,0 +1,323 @@
+#include "Layout/ForceKernels.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define LAYOUT_KERNELS_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(LAYOUT_KERNELS_X86) && defined(__GNUC__)
+#define LAYOUT_TARGET_SSE2 __attribute__((target("sse2")))
+#define LAYOUT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LAYOUT_TARGET_SSE2
+#define LAYOUT_TARGET_AVX2
+#endif
+
+using namespace Layout;
+
+int ForceKernels::level = -1;
+
+namespace
+{
+	int bitCount(int bits)
+	{
+		int count = 0;
+		while (bits)
+		{
+			bits &= bits - 1;
+			count++;
+		}
+		return count;
+	}
+
+	int repulsiveScalar(float ux, float uy, float uz, const float *x, const float *y, const float *z,
+		int begin, int end, float strength, float maxDistance2, float &fx, float &fy, float &fz)
+	{
+		int zeros = 0;
+		float sx = 0, sy = 0, sz = 0;
+		for (int h = begin; h < end; h++)
+		{
+			float dx = x[h] - ux;
+			float dy = y[h] - uy;
+			float dz = z[h] - uz;
+			float d2 = dx * dx + dy * dy + dz * dz;
+			if (d2 == 0)
+			{
+				zeros++;
+				continue;
+			}
+			if (d2 > maxDistance2)
+				continue;
+			float s = -strength / d2;
+			sx += dx * s;
+			sy += dy * s;
+			sz += dz * s;
+		}
+		fx += sx;
+		fy += sy;
+		fz += sz;
+		return zeros;
+	}
+
+	void attractiveScalar(const int *src, const int *dst, int count, const float *x, const float *y, const float *z,
+		float factor, float *fx, float *fy, float *fz)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			fx[i] = fy[i] = fz[i] = 0;
+			ForceKernels::attractivePair(x[dst[i]] - x[src[i]], y[dst[i]] - y[src[i]], z[dst[i]] - z[src[i]], factor, fx[i], fy[i], fz[i]);
+		}
+	}
+
+#ifdef LAYOUT_KERNELS_X86
+
+	LAYOUT_TARGET_SSE2
+	float horizontalSum(__m128 v)
+	{
+		float lanes[4];
+		_mm_storeu_ps(lanes, v);
+		return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	}
+
+	LAYOUT_TARGET_SSE2
+	int repulsiveSSE2(float ux, float uy, float uz, const float *x, const float *y, const float *z,
+		int begin, int end, float strength, float maxDistance2, float &fx, float &fy, float &fz)
+	{
+		__m128 vux = _mm_set1_ps(ux), vuy = _mm_set1_ps(uy), vuz = _mm_set1_ps(uz);
+		__m128 vstrength = _mm_set1_ps(-strength);
+		__m128 vmax = _mm_set1_ps(maxDistance2);
+		__m128 zero = _mm_setzero_ps();
+		__m128 sx = zero, sy = zero, sz = zero;
+		int zeros = 0;
+
+		int h = begin;
+		for (; h + 4 <= end; h += 4)
+		{
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(x + h), vux);
+			__m128 dy = _mm_sub_ps(_mm_loadu_ps(y + h), vuy);
+			__m128 dz = _mm_sub_ps(_mm_loadu_ps(z + h), vuz);
+			__m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+			int same = _mm_movemask_ps(_mm_cmpeq_ps(d2, zero));
+			if (same)
+				zeros += bitCount(same);
+			// dvojice v nulovej a privelkej vzdialenosti vynulujeme maskou
+			__m128 mask = _mm_and_ps(_mm_cmpgt_ps(d2, zero), _mm_cmple_ps(d2, vmax));
+			__m128 s = _mm_and_ps(mask, _mm_div_ps(vstrength, d2));
+			sx = _mm_add_ps(sx, _mm_mul_ps(dx, s));
+			sy = _mm_add_ps(sy, _mm_mul_ps(dy, s));
+			sz = _mm_add_ps(sz, _mm_mul_ps(dz, s));
+		}
+
+		float tx = horizontalSum(sx), ty = horizontalSum(sy), tz = horizontalSum(sz);
+		zeros += repulsiveScalar(ux, uy, uz, x, y, z, h, end, strength, maxDistance2, tx, ty, tz);
+		fx += tx;
+		fy += ty;
+		fz += tz;
+		return zeros;
+	}
+
+	LAYOUT_TARGET_SSE2
+	void attractiveSSE2(const int *src, const int *dst, int count, const float *x, const float *y, const float *z,
+		float factor, float *fx, float *fy, float *fz)
+	{
+		__m128 vfactor = _mm_set1_ps(factor);
+		int i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			const int *s = src + i;
+			const int *d = dst + i;
+			__m128 dx = _mm_sub_ps(_mm_setr_ps(x[d[0]], x[d[1]], x[d[2]], x[d[3]]), _mm_setr_ps(x[s[0]], x[s[1]], x[s[2]], x[s[3]]));
+			__m128 dy = _mm_sub_ps(_mm_setr_ps(y[d[0]], y[d[1]], y[d[2]], y[d[3]]), _mm_setr_ps(y[s[0]], y[s[1]], y[s[2]], y[s[3]]));
+			__m128 dz = _mm_sub_ps(_mm_setr_ps(z[d[0]], z[d[1]], z[d[2]], z[d[3]]), _mm_setr_ps(z[s[0]], z[s[1]], z[s[2]], z[s[3]]));
+			__m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			__m128 k = _mm_mul_ps(_mm_sqrt_ps(d2), vfactor);
+			_mm_storeu_ps(fx + i, _mm_mul_ps(dx, k));
+			_mm_storeu_ps(fy + i, _mm_mul_ps(dy, k));
+			_mm_storeu_ps(fz + i, _mm_mul_ps(dz, k));
+		}
+		attractiveScalar(src + i, dst + i, count - i, x, y, z, factor, fx + i, fy + i, fz + i);
+	}
+
+	LAYOUT_TARGET_AVX2
+	float horizontalSum(__m256 v)
+	{
+		float lanes[8];
+		_mm256_storeu_ps(lanes, v);
+		return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+	}
+
+	LAYOUT_TARGET_AVX2
+	int repulsiveAVX2(float ux, float uy, float uz, const float *x, const float *y, const float *z,
+		int begin, int end, float strength, float maxDistance2, float &fx, float &fy, float &fz)
+	{
+		__m256 vux = _mm256_set1_ps(ux), vuy = _mm256_set1_ps(uy), vuz = _mm256_set1_ps(uz);
+		__m256 vstrength = _mm256_set1_ps(-strength);
+		__m256 vmax = _mm256_set1_ps(maxDistance2);
+		__m256 zero = _mm256_setzero_ps();
+		__m256 sx = zero, sy = zero, sz = zero;
+		int zeros = 0;
+
+		int h = begin;
+		for (; h + 8 <= end; h += 8)
+		{
+			__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + h), vux);
+			__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + h), vuy);
+			__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + h), vuz);
+			__m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+
+			int same = _mm256_movemask_ps(_mm256_cmp_ps(d2, zero, _CMP_EQ_OQ));
+			if (same)
+				zeros += bitCount(same);
+			// dvojice v nulovej a privelkej vzdialenosti vynulujeme maskou
+			__m256 mask = _mm256_and_ps(_mm256_cmp_ps(d2, zero, _CMP_GT_OQ), _mm256_cmp_ps(d2, vmax, _CMP_LE_OQ));
+			__m256 s = _mm256_and_ps(mask, _mm256_div_ps(vstrength, d2));
+			sx = _mm256_add_ps(sx, _mm256_mul_ps(dx, s));
+			sy = _mm256_add_ps(sy, _mm256_mul_ps(dy, s));
+			sz = _mm256_add_ps(sz, _mm256_mul_ps(dz, s));
+		}
+
+		float tx = horizontalSum(sx), ty = horizontalSum(sy), tz = horizontalSum(sz);
+		// zvysok pocita kod bez AVX, horne polovice registrov treba vynulovat, inak kazdy prechod medzi
+		// AVX a SSE instrukciami stoji desiatky taktov
+		_mm256_zeroupper();
+		zeros += repulsiveScalar(ux, uy, uz, x, y, z, h, end, strength, maxDistance2, tx, ty, tz);
+		fx += tx;
+		fy += ty;
+		fz += tz;
+		return zeros;
+	}
+
+	LAYOUT_TARGET_AVX2
+	void attractiveAVX2(const int *src, const int *dst, int count, const float *x, const float *y, const float *z,
+		float factor, float *fx, float *fy, float *fz)
+	{
+		__m256 vfactor = _mm256_set1_ps(factor);
+		int i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+			__m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+			__m256 dx = _mm256_sub_ps(_mm256_i32gather_ps(x, d, 4), _mm256_i32gather_ps(x, s, 4));
+			__m256 dy = _mm256_sub_ps(_mm256_i32gather_ps(y, d, 4), _mm256_i32gather_ps(y, s, 4));
+			__m256 dz = _mm256_sub_ps(_mm256_i32gather_ps(z, d, 4), _mm256_i32gather_ps(z, s, 4));
+			__m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+			__m256 k = _mm256_mul_ps(_mm256_sqrt_ps(d2), vfactor);
+			_mm256_storeu_ps(fx + i, _mm256_mul_ps(dx, k));
+			_mm256_storeu_ps(fy + i, _mm256_mul_ps(dy, k));
+			_mm256_storeu_ps(fz + i, _mm256_mul_ps(dz, k));
+		}
+		_mm256_zeroupper();
+		attractiveScalar(src + i, dst + i, count - i, x, y, z, factor, fx + i, fy + i, fz + i);
+	}
+
+#endif
+}
+
+ForceKernels::Level ForceKernels::getSupportedLevel()
+{
+#if defined(LAYOUT_KERNELS_X86) && defined(__GNUC__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return AVX2;
+	if (__builtin_cpu_supports("sse2"))
+		return SSE2;
+#elif defined(LAYOUT_KERNELS_X86) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	int ids = info[0];
+	__cpuid(info, 1);
+	bool sse2 = (info[3] & (1 << 26)) != 0;
+	// AVX vyzaduje podporu ukladania registrov operacnym systemom
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	if (ids >= 7 && osxsave && (_xgetbv(0) & 6) == 6)
+	{
+		__cpuidex(info, 7, 0);
+		if (info[1] & (1 << 5))
+			return AVX2;
+	}
+	if (sse2)
+		return SSE2;
+#endif
+	return SCALAR;
+}
+
+ForceKernels::Level ForceKernels::getLevel()
+{
+	if (level < 0)
+	{
+		level = getSupportedLevel();
+	}
+	return (Level) level;
+}
+
+void ForceKernels::setLevel(ForceKernels::Level level)
+{
+	Level supported = getSupportedLevel();
+	ForceKernels::level = level > supported ? supported : level;
+}
+
+const char *ForceKernels::getLevelName(ForceKernels::Level level)
+{
+	switch (level)
+	{
+	case AVX2:
+		return "avx2";
+	case SSE2:
+		return "sse2";
+	default:
+		return "scalar";
+	}
+}
+
+ForceKernels::Level ForceKernels::parseLevel(const char *name)
+{
+	if (strcmp(name, "scalar") == 0)
+		return SCALAR;
+	if (strcmp(name, "sse2") == 0)
+		return SSE2;
+	if (strcmp(name, "avx2") == 0)
+		return AVX2;
+	return getSupportedLevel();
+}
+
+int ForceKernels::repulsive(float ux, float uy, float uz, const float *x, const float *y, const float *z,
+	int begin, int end, float strength, float maxDistance2, float &fx, float &fy, float &fz)
+{
+	switch (getLevel())
+	{
+#ifdef LAYOUT_KERNELS_X86
+	case AVX2:
+		return repulsiveAVX2(ux, uy, uz, x, y, z, begin, end, strength, maxDistance2, fx, fy, fz);
+	case SSE2:
+		return repulsiveSSE2(ux, uy, uz, x, y, z, begin, end, strength, maxDistance2, fx, fy, fz);
+#endif
+	default:
+		return repulsiveScalar(ux, uy, uz, x, y, z, begin, end, strength, maxDistance2, fx, fy, fz);
+	}
+}
+
+void ForceKernels::attractive(const int *src, const int *dst, int count, const float *x, const float *y, const float *z,
+	float factor, float *fx, float *fy, float *fz)
+{
+	switch (getLevel())
+	{
+#ifdef LAYOUT_KERNELS_X86
+	case AVX2:
+		attractiveAVX2(src, dst, count, x, y, z, factor, fx, fy, fz);
+		break;
+	case SSE2:
+		attractiveSSE2(src, dst, count, x, y, z, factor, fx, fy, fz);
+		break;
+#endif
+	default:
+		attractiveScalar(src, dst, count, x, y, z, factor, fx, fy, fz);
+		break;
+	}
+}
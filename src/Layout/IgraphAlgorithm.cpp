@@ -0,0 +1,281 @@
+#include "Layout/IgraphAlgorithm.h"
+
+#include <math.h>
+#include <iostream>
+
+using namespace Layout;
+using namespace std;
+
+const double IgraphAlgorithm::COOLING_EXPONENT = 1.5;
+
+IgraphAlgorithm::IgraphAlgorithm()
+{
+	graph = NULL;
+	built = false;
+	builtTopology = -1;
+	builtGraph = NULL;
+	seeded = false;
+	version = 0;
+	stepIndex = 0;
+	sizeFactor = 10;
+	pulledEdits = 0;
+	state = RUNNING;
+	notEnd = true;
+	isIterating = false;
+	igraph_matrix_init(&layout, 0, 0);
+}
+
+IgraphAlgorithm::~IgraphAlgorithm()
+{
+	release();
+	igraph_matrix_destroy(&layout);
+}
+
+void IgraphAlgorithm::SetGraph(Data::Graph *graph)
+{
+	QMutexLocker locker(&schedulerMutex);
+	notEnd = true;
+	this->graph = graph;
+	// struktury iGraph sa postavia v dalsom kroku vo vlakne layoutu, prestavbu vynuti iny graf alebo verzia topologie
+	seeded = false;
+	stepIndex = 0;
+	resetStats();
+	editCount.ref();
+	schedulerCondition.wakeAll();
+}
+
+void IgraphAlgorithm::SetParameters(float sizeFactor, float flexibility, int animationSpeed, bool useMaxDistance)
+{
+	QMutexLocker locker(&schedulerMutex);
+	this->sizeFactor = sizeFactor;
+}
+
+void IgraphAlgorithm::PauseAlg()
+{
+	QMutexLocker locker(&schedulerMutex);
+	state = PAUSED;
+	schedulerCondition.wakeAll();
+}
+
+void IgraphAlgorithm::WakeUpAlg()
+{
+	QMutexLocker locker(&schedulerMutex);
+	// pouzivatel zmenil pozicie alebo fixovanie uzlov, dochladime rozmiestnenie od aktualnych pozicii
+	editCount.ref();
+	if (stepIndex > STEP_COUNT - WAKE_UP_STEPS)
+	{
+		stepIndex = STEP_COUNT - WAKE_UP_STEPS;
+	}
+	if (graph != NULL && state == RUNNING && graph->isFrozen())
+	{
+		graph->setFrozen(false);
+		schedulerCondition.wakeAll();
+	}
+}
+
+void IgraphAlgorithm::RunAlg()
+{
+	QMutexLocker locker(&schedulerMutex);
+	if (graph != NULL)
+	{
+		editCount.ref();
+		if (stepIndex > STEP_COUNT - WAKE_UP_STEPS)
+		{
+			stepIndex = STEP_COUNT - WAKE_UP_STEPS;
+		}
+		graph->setFrozen(false);
+		state = RUNNING;
+		notEnd = true;
+		schedulerCondition.wakeAll();
+	}
+}
+
+bool IgraphAlgorithm::IsRunning()
+{
+	return isIterating;
+}
+
+void IgraphAlgorithm::StopAlg()
+{
+	QMutexLocker locker(&schedulerMutex);
+	notEnd = false;
+	schedulerCondition.wakeAll();
+}
+
+void IgraphAlgorithm::Run()
+{
+	if (this->graph != NULL)
+	{
+		isIterating = true;
+		QMutexLocker locker(&schedulerMutex);
+		while (notEnd)
+		{
+			// spime pocas pauzy alebo po dochladeni, kym nepride spustenie, prebudenie, zmena grafu alebo koniec
+			if (state != RUNNING || graph->isFrozen())
+			{
+				if (state == PAUSED)
+				{
+					isIterating = false;
+				}
+				schedulerCondition.wait(&schedulerMutex);
+				continue;
+			}
+			isIterating = true;
+
+			locker.unlock();
+			bool changed = Step();
+			locker.relock();
+
+			if (!changed && (int) editCount == pulledEdits)
+			{
+				graph->setFrozen(true);
+			}
+		}
+		isIterating = false;
+	}
+	else
+	{
+		cout << "Nenastaveny graf. Pouzi metodu SetGraph(Data::Graph graph).";
+	}
+}
+
+bool IgraphAlgorithm::Step()
+{
+	if (graph == NULL)
+	{
+		return false;
+	}
+	QTime timer;
+	timer.start();
+
+	int edits = (int) editCount;
+	if (!built || builtGraph != graph || builtTopology != graph->getTopologyVersion())
+	{
+		rebuild();
+		pulledEdits = edits;
+	}
+	else if (edits != pulledEdits)
+	{ // pouzivatel len presunul alebo fixoval uzly, struktura iGraph ostava
+		pullPositions();
+		pulledEdits = edits;
+	}
+	int step;
+	{
+		QMutexLocker locker(&schedulerMutex);
+		step = stepIndex;
+		if (step < STEP_COUNT)
+		{
+			stepIndex++;
+		}
+	}
+	int count = (int) nodes.size();
+	if (count == 0 || step >= STEP_COUNT)
+	{ // dochladene, zverejnime len upravy pouzivatela
+		if (count > 0)
+		{
+			publish();
+		}
+		return false;
+	}
+
+	// parametre ako v LayoutGenerator::LayoutFruchtermanReingold3D, K je idealna dlzka hrany
+	double k = sizeFactor;
+	double volume = count * k * k * k;
+	double maxDelta = k * pow((double) count, 1.0 / 3.0);
+	double repulseRadius = volume * maxDelta;
+	igraph_layout_fruchterman_reingold_3d(&igraphGraph, &layout, STEP_COUNT, maxDelta, volume, COOLING_EXPONENT,
+		repulseRadius, seeded, STEP_ITERATIONS, step, NULL);
+	seeded = true;
+
+	// iGraph nepozna fixovane uzly, vratime ich na miesto
+	for (int i = 0; i < count; i++)
+	{
+		if (nodes[i]->isFixed())
+		{
+			osg::Vec3f position = nodes[i]->getTargetPosition();
+			MATRIX(layout, i, 0) = position.x();
+			MATRIX(layout, i, 1) = position.y();
+			MATRIX(layout, i, 2) = position.z();
+		}
+	}
+	publish();
+	recordIteration(timer.elapsed(), true);
+	return true;
+}
+
+void IgraphAlgorithm::rebuild()
+{
+	release();
+	nodes.clear();
+
+	// identifikatory uzlov nie su suvisle, iGraph potrebuje indexy 0..n-1, tie ma index susedov grafu
+	const Data::Adjacency &adjacency = graph->getAdjacency();
+	int count = adjacency.getCount();
+	nodes.reserve(count);
+	for (int i = 0; i < count; i++)
+	{
+		nodes.push_back(adjacency.getNode(i));
+	}
+
+	igraph_vector_t edges;
+	igraph_vector_init(&edges, 2 * (long) adjacency.getEdgeCount());
+	for (int e = 0; e < adjacency.getEdgeCount(); e++)
+	{
+		VECTOR(edges)[2 * e] = adjacency.edgeSrc[e];
+		VECTOR(edges)[2 * e + 1] = adjacency.edgeDst[e];
+	}
+	igraph_empty(&igraphGraph, count, 0);
+	igraph_add_edges(&igraphGraph, &edges, 0);
+	igraph_vector_destroy(&edges);
+	built = true;
+	builtTopology = adjacency.getVersion();
+	builtGraph = graph;
+
+	igraph_matrix_resize(&layout, count, 3);
+	pullPositions();
+	version++;
+}
+
+void IgraphAlgorithm::pullPositions()
+{
+	if (!seeded)
+	{ // pri novom grafe zacne iGraph z nahodneho rozmiestnenia
+		return;
+	}
+	// pokracujeme z aktualnych pozicii
+	int count = (int) nodes.size();
+	for (int i = 0; i < count; i++)
+	{
+		osg::Vec3f position = nodes[i]->getTargetPosition();
+		MATRIX(layout, i, 0) = position.x();
+		MATRIX(layout, i, 1) = position.y();
+		MATRIX(layout, i, 2) = position.z();
+	}
+}
+
+void IgraphAlgorithm::release()
+{
+	if (built)
+	{
+		igraph_destroy(&igraphGraph);
+		built = false;
+	}
+}
+
+void IgraphAlgorithm::publish()
+{
+	Layout::PositionBuffer::Frame &frame = positionBuffer.getBackFrame();
+	if (frame.version != version)
+	{ // snimka obsahuje uzly starsej topologie
+		frame.nodes = nodes;
+		frame.version = version;
+	}
+	int count = (int) nodes.size();
+	frame.positions.resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		frame.positions[i].set(MATRIX(layout, i, 0), MATRIX(layout, i, 1), MATRIX(layout, i, 2));
+	}
+	frame.edits = pulledEdits;
+	positionBuffer.publish();
+}
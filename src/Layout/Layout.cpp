@@ -1,6 +1,7 @@
 #include "Layout/Layout.h"
 
 #include <osg/ref_ptr>
+#include <QHash>
 
 using namespace Layout;
 using namespace Vwr;
@@ -110,10 +111,23 @@ void LayoutGenerator::createIgraph(igraph_t* graph)
 	igraph_empty(graph, 0, true);
 
 	igraph_add_vertices(graph, qnodes->count(), 0);
+
+	// vrcholy iGraph su indexovane 0..n-1 v poradi qnodes, v tomto poradi sa zapisuju aj pozicie
+	QHash<qlonglong, int> index;
+	QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator n;
+	for (n = qnodes->begin(); n != qnodes->end(); ++n)
+	{
+		index.insert(n.key(), index.count());
+	}
         QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator i;
 	for (i = qedges->begin();i != qedges->end();++i)
 	{		
-		igraph_add_edge(graph, i.value()->getSrcNode()->getId(), i.value()->getDstNode()->getId());
+		int src = index.value(i.value()->getSrcNode()->getId(), -1);
+		int dst = index.value(i.value()->getDstNode()->getId(), -1);
+		if (src != -1 && dst != -1)
+		{
+			igraph_add_edge(graph, src, dst);
+		}
 	}
 }
 
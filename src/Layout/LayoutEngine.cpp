@@ -0,0 +1,173 @@
+#include "Layout/LayoutEngine.h"
+#include "Layout/FRAlgorithm.h"
+#include "Layout/ConeTreeAlgorithm.h"
+#include "Layout/IgraphAlgorithm.h"
+#include "Layout/PivotMdsAlgorithm.h"
+
+#include <QTime>
+
+using namespace Layout;
+
+LayoutEngine::LayoutEngine()
+{
+	appliedSequence = 0;
+	stats.iterations = 0;
+	stats.lastIterationMs = 0;
+	stats.totalMs = 0;
+	stats.converged = false;
+	stats.slices = 0;
+	stats.lastSliceUpdates = 0;
+}
+
+LayoutEngine::~LayoutEngine()
+{
+}
+
+LayoutEngine *LayoutEngine::create(const QString &name)
+{
+	if (name == "igraph")
+	{
+		return new Layout::IgraphAlgorithm();
+	}
+	if (name == "pivotmds")
+	{
+		return new Layout::PivotMdsAlgorithm();
+	}
+	if (name == "cone")
+	{
+		return new Layout::ConeTreeAlgorithm();
+	}
+	Layout::FRAlgorithm *alg = new Layout::FRAlgorithm();
+	// multilevel = FR s pociatocnym rozmiestnenim zhrubenim grafu a postupnym zjemnovanim (nie je rezim pre velke grafy),
+	// spectral = FR s pociatocnym rozmiestnenim podla vzdialenosti od pivotov, pivotmds-fr = FR zjemnujuce Pivot MDS
+	if (name == "multilevel")
+		alg->SetPlacement(Layout::FRAlgorithm::PLACEMENT_MULTILEVEL);
+	else if (name == "spectral")
+		alg->SetPlacement(Layout::FRAlgorithm::PLACEMENT_SPECTRAL);
+	else if (name == "pivotmds-fr")
+		alg->SetPlacement(Layout::FRAlgorithm::PLACEMENT_PIVOT_MDS);
+	else
+		alg->SetPlacement(Layout::FRAlgorithm::PLACEMENT_RANDOM);
+	return alg;
+}
+
+QStringList LayoutEngine::getNames()
+{
+	return QStringList() << "auto" << "fr" << "multilevel" << "spectral" << "pivotmds-fr" << "pivotmds" << "cone" << "igraph";
+}
+
+QString LayoutEngine::resolve(const QString &name, Data::Graph *graph)
+{
+	if (name != "auto")
+	{
+		return name;
+	}
+	// hierarchie (stromy, hierarchie tried) rozmiestni kuzelovy strom hned, ostatne grafy FR
+	return Layout::ConeTreeAlgorithm::isHierarchy(graph) ? "cone" : "fr";
+}
+
+int LayoutEngine::RunIterations(int maxIterations, int maxMilliseconds)
+{
+	QTime timer;
+	timer.start();
+	int iterations = 0;
+	while (maxIterations <= 0 || iterations < maxIterations)
+	{
+		iterations++;
+		if (!Step())
+		{ // ziaden uzol sa nepohol, rozmiestnenie je ustalene
+			break;
+		}
+		if (maxMilliseconds > 0 && timer.elapsed() >= maxMilliseconds)
+		{
+			break;
+		}
+	}
+	return iterations;
+}
+
+int LayoutEngine::ApplyPositions()
+{
+	if (positionBuffer.getSequence() == appliedSequence)
+	{ // ziadna nova snimka
+		return appliedSequence;
+	}
+	const Layout::PositionBuffer::Frame *frame = positionBuffer.acquire();
+	if (frame == NULL || frame->sequence == appliedSequence || frame->edits != (int) editCount)
+	{ // snimka nezahrna posledne upravy pouzivatela, pockame na dalsiu
+		return appliedSequence;
+	}
+	int count = (int) frame->nodes.size();
+	for (int i = 0; i < count; i++)
+	{
+		Data::Node *node = frame->nodes[i].get();
+		if (!node->isFixed())
+		{
+			node->setTargetPosition(frame->positions[i]);
+		}
+	}
+	appliedSequence = frame->sequence;
+	return appliedSequence;
+}
+
+void LayoutEngine::PostEdits(const QLinkedList<osg::ref_ptr<Data::Node> > &nodes)
+{
+	QMutexLocker locker(&editMutex);
+	QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator i;
+	for (i = nodes.constBegin(); i != nodes.constEnd(); ++i)
+	{
+		Layout::LayoutState::Edit edit;
+		edit.position = (*i)->getTargetPosition();
+		edit.fixed = (*i)->isFixed();
+		pendingEdits.insert((*i)->getId(), edit);
+	}
+}
+
+void LayoutEngine::takeEdits(QHash<qlonglong, Layout::LayoutState::Edit> &edits)
+{
+	QMutexLocker locker(&editMutex);
+	// kopia je lacna, QHash zdiela data
+	edits = pendingEdits;
+	pendingEdits.clear();
+}
+
+LayoutEngine::Stats LayoutEngine::GetStats()
+{
+	QMutexLocker locker(&statsMutex);
+	return stats;
+}
+
+void LayoutEngine::recordIteration(double milliseconds, bool changed)
+{
+	QMutexLocker locker(&statsMutex);
+	stats.iterations++;
+	stats.lastIterationMs = milliseconds;
+	stats.totalMs += milliseconds;
+	stats.converged = !changed;
+}
+
+void LayoutEngine::resetStats()
+{
+	QMutexLocker locker(&statsMutex);
+	stats.iterations = 0;
+	stats.lastIterationMs = 0;
+	stats.totalMs = 0;
+	stats.converged = false;
+	stats.slices = 0;
+	stats.lastSliceUpdates = 0;
+	telemetry.clear();
+}
+
+void LayoutEngine::restoreStats(int iterations, bool converged)
+{
+	QMutexLocker locker(&statsMutex);
+	stats.iterations = iterations;
+	stats.converged = converged;
+}
+
+void LayoutEngine::recordSlice(int updates)
+{
+	QMutexLocker locker(&statsMutex);
+	stats.slices++;
+	stats.lastSliceUpdates = updates;
+}
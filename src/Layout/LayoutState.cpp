@@ -0,0 +1,304 @@
+#include "Layout/LayoutState.h"
+
+#include <algorithm>
+
+using namespace Layout;
+
+namespace
+{
+	/* prvky 0 .. order.size() - 1 usporiada tak, ze na mieste k bude povodny prvok order[k], dalsie prvky ostanu */
+	template <typename T>
+	void reorder(std::vector<T> &values, const std::vector<int> &order)
+	{
+		std::vector<T> sorted(order.size());
+		for (size_t k = 0; k < order.size(); k++)
+		{
+			sorted[k] = values[order[k]];
+		}
+		std::copy(sorted.begin(), sorted.end(), values.begin());
+	}
+
+	/* koren mnoziny uzla, cestu skracuje */
+	int findRoot(std::vector<int> &parent, int i)
+	{
+		while (parent[i] != i)
+		{
+			parent[i] = parent[parent[i]];
+			i = parent[i];
+		}
+		return i;
+	}
+}
+
+LayoutState::LayoutState()
+{
+	nodeCount = 0;
+	version = 0;
+	graph = NULL;
+	topologyVersion = -1;
+	valid = false;
+}
+
+void LayoutState::clear()
+{
+	resize(0);
+	nodes.clear();
+	index.clear();
+	edgeSrc.clear();
+	edgeDst.clear();
+	metaEdgeSrc.clear();
+	metaEdgeDst.clear();
+	nodeCount = 0;
+	graph = NULL;
+	valid = false;
+}
+
+void LayoutState::resize(int count)
+{
+	x.resize(count, 0); y.resize(count, 0); z.resize(count, 0);
+	fx.resize(count, 0); fy.resize(count, 0); fz.resize(count, 0);
+	vx.resize(count, 0); vy.resize(count, 0); vz.resize(count, 0);
+	fixed.resize(count, 0);
+	ids.resize(count, -1);
+	if ((int) nodes.size() > count)
+	{
+		nodes.resize(count);
+	}
+	component.clear();
+	componentStart.clear();
+	nodeCount = count;
+}
+
+void LayoutState::addNode(Data::Node *node)
+{
+	index.insert(node->getId(), (int) ids.size());
+	ids.push_back(node->getId());
+	nodes.push_back(node);
+
+	osg::Vec3f position = node->getTargetPosition();
+	x.push_back(position.x()); y.push_back(position.y()); z.push_back(position.z());
+	vx.push_back(0); vy.push_back(0); vz.push_back(0);
+	fx.push_back(0); fy.push_back(0); fz.push_back(0);
+	fixed.push_back(node->isFixed() ? 1 : 0);
+}
+
+void LayoutState::capture(Data::Graph *graph)
+{
+	clear();
+	version++;
+	this->graph = graph;
+	if (graph == NULL)
+	{
+		return;
+	}
+
+	// poradie uzlov a hran preberame z indexu susedov grafu
+	const Data::Adjacency &adjacency = graph->getAdjacency();
+	int count = adjacency.getCount();
+	x.reserve(count); y.reserve(count); z.reserve(count);
+	vx.reserve(count); vy.reserve(count); vz.reserve(count);
+	fx.reserve(count); fy.reserve(count); fz.reserve(count);
+	fixed.reserve(count);
+	ids.reserve(count);
+	nodes.reserve(count);
+
+	for (int i = 0; i < count; i++)
+	{
+		addNode(adjacency.getNode(i));
+	}
+	nodeCount = adjacency.getNodeCount();
+
+	int plainEdgeCount = adjacency.getPlainEdgeCount();
+	edgeSrc.assign(adjacency.edgeSrc.begin(), adjacency.edgeSrc.begin() + plainEdgeCount);
+	edgeDst.assign(adjacency.edgeDst.begin(), adjacency.edgeDst.begin() + plainEdgeCount);
+	metaEdgeSrc.assign(adjacency.edgeSrc.begin() + plainEdgeCount, adjacency.edgeSrc.end());
+	metaEdgeDst.assign(adjacency.edgeDst.begin() + plainEdgeCount, adjacency.edgeDst.end());
+	for (size_t e = 0; e < metaEdgeSrc.size(); e++)
+	{
+		// uzly nikdy nebudu ignorovane
+		nodes[metaEdgeSrc[e]]->setIgnored(false);
+		nodes[metaEdgeDst[e]]->setIgnored(false);
+	}
+
+	topologyVersion = adjacency.getVersion();
+	valid = true;
+}
+
+void LayoutState::sortComponents()
+{
+	int count = getCount();
+	// komponenty spajame hranami aj meta hranami, metauzol drzi svoje uzly pokope
+	std::vector<int> parent(count);
+	for (int i = 0; i < count; i++)
+	{
+		parent[i] = i;
+	}
+	const std::vector<int> *src[2] = { &edgeSrc, &metaEdgeSrc };
+	const std::vector<int> *dst[2] = { &edgeDst, &metaEdgeDst };
+	for (int l = 0; l < 2; l++)
+	{
+		for (size_t e = 0; e < src[l]->size(); e++)
+		{
+			int u = findRoot(parent, (*src[l])[e]);
+			int v = findRoot(parent, (*dst[l])[e]);
+			if (u != v)
+			{
+				parent[std::max(u, v)] = std::min(u, v);
+			}
+		}
+	}
+
+	// komponenty cislujeme v poradi ich prveho uzla a spocitame ich velkosti
+	std::vector<int> label(count, -1);
+	component.resize(count);
+	componentStart.clear();
+	for (int i = 0; i < nodeCount; i++)
+	{
+		int root = findRoot(parent, i);
+		if (label[root] == -1)
+		{
+			label[root] = (int) componentStart.size();
+			componentStart.push_back(0);
+		}
+		component[i] = label[root];
+		componentStart[label[root]]++;
+	}
+	for (int i = nodeCount; i < count; i++)
+	{ // metauzol bez uzlov nepatri ziadnemu komponentu
+		component[i] = label[findRoot(parent, i)];
+	}
+	componentStart.push_back(0);
+	for (int c = 0, start = 0; c < (int) componentStart.size(); c++)
+	{
+		int size = componentStart[c];
+		componentStart[c] = start;
+		start += size;
+	}
+
+	// uzly komponentu ulozime za sebou, metauzly ostavaju na konci
+	std::vector<int> fill(componentStart.begin(), componentStart.end() - 1);
+	std::vector<int> order(nodeCount), position(count);
+	for (int i = 0; i < count; i++)
+	{
+		position[i] = i < nodeCount ? fill[component[i]]++ : i;
+		if (i < nodeCount)
+		{
+			order[position[i]] = i;
+		}
+	}
+	reorder(x, order); reorder(y, order); reorder(z, order);
+	reorder(fx, order); reorder(fy, order); reorder(fz, order);
+	reorder(vx, order); reorder(vy, order); reorder(vz, order);
+	reorder(fixed, order);
+	reorder(ids, order);
+	reorder(component, order);
+	if ((int) nodes.size() >= nodeCount)
+	{
+		reorder(nodes, order);
+	}
+	if (!index.isEmpty())
+	{
+		for (int i = 0; i < nodeCount; i++)
+		{
+			index.insert(ids[i], i);
+		}
+	}
+	std::vector<int> *edges[4] = { &edgeSrc, &edgeDst, &metaEdgeSrc, &metaEdgeDst };
+	for (int l = 0; l < 4; l++)
+	{
+		for (size_t e = 0; e < edges[l]->size(); e++)
+		{
+			(*edges[l])[e] = position[(*edges[l])[e]];
+		}
+	}
+}
+
+bool LayoutState::isStale(Data::Graph *graph) const
+{
+	// zmenu topologie rozpoznavame podla verzie grafu, ostatne zmeny hlasi invalidate
+	return !valid || graph != this->graph || graph == NULL
+		|| topologyVersion != graph->getTopologyVersion();
+}
+
+void LayoutState::pull(const QHash<qlonglong, Edit> &edits, std::vector<int> *changed)
+{
+	QHash<qlonglong, Edit>::const_iterator e;
+	for (e = edits.constBegin(); e != edits.constEnd(); ++e)
+	{
+		int i = indexOf(e.key());
+		if (i == -1)
+		{ // uzol pribudol po snimke, nacita sa pri dalsej
+			continue;
+		}
+		const osg::Vec3f &position = e.value().position;
+		unsigned char isFixed = e.value().fixed ? 1 : 0;
+		if (changed != NULL && (x[i] != position.x() || y[i] != position.y() || z[i] != position.z() || fixed[i] != isFixed))
+		{
+			changed->push_back(i);
+		}
+		x[i] = position.x();
+		y[i] = position.y();
+		z[i] = position.z();
+		fixed[i] = isFixed;
+	}
+}
+
+void LayoutState::publish(Layout::PositionBuffer &buffer, int edits) const
+{
+	Layout::PositionBuffer::Frame &frame = buffer.getBackFrame();
+	if (frame.version != version)
+	{ // snimka obsahuje uzly starsej topologie
+		frame.nodes = nodes;
+		frame.version = version;
+	}
+	int count = (int) nodes.size();
+	frame.positions.resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		frame.positions[i].set(x[i], y[i], z[i]);
+	}
+	frame.edits = edits;
+	buffer.publish();
+}
+
+void LayoutState::buildNeighbours(int count, int kinds, bool markIncoming, std::vector<int> &offsets, std::vector<int> &neighbours) const
+{
+	const std::vector<int> *src[2] = { &edgeSrc, &metaEdgeSrc };
+	const std::vector<int> *dst[2] = { &edgeDst, &metaEdgeDst };
+
+	offsets.assign(count + 1, 0);
+	for (int l = 0; l < 2; l++)
+	{
+		if (!(kinds & (1 << l)))
+			continue;
+		for (size_t e = 0; e < src[l]->size(); e++)
+		{
+			int u = (*src[l])[e], v = (*dst[l])[e];
+			if (u < count && v < count && u != v)
+			{
+				offsets[u + 1]++;
+				offsets[v + 1]++;
+			}
+		}
+	}
+	for (int i = 0; i < count; i++)
+	{
+		offsets[i + 1] += offsets[i];
+	}
+	neighbours.resize(offsets[count]);
+	std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+	for (int l = 0; l < 2; l++)
+	{
+		if (!(kinds & (1 << l)))
+			continue;
+		for (size_t e = 0; e < src[l]->size(); e++)
+		{
+			int u = (*src[l])[e], v = (*dst[l])[e];
+			if (u < count && v < count && u != v)
+			{
+				neighbours[fill[u]++] = v;
+				neighbours[fill[v]++] = markIncoming ? -1 - u : u;
+			}
+		}
+	}
+}
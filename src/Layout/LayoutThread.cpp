@@ -2,7 +2,7 @@
 
 using namespace Layout;
 
-LayoutThread::LayoutThread(Layout::FRAlgorithm* alg)
+LayoutThread::LayoutThread(Layout::LayoutEngine* alg)
 {
 	this->alg = alg;
 	appConf = Util::ApplicationConfig::get();
@@ -29,6 +29,20 @@ void LayoutThread::wakeUp()
 {
 	alg->WakeUpAlg();
 }
+void LayoutThread::stop()
+{
+	alg->StopAlg();
+}
+void LayoutThread::relayoutLocal(const QLinkedList<osg::ref_ptr<Data::Node> > &seeds)
+{
+	int hops = appConf->getValue("Layout.FR.LocalHops").isEmpty() ? 2 : appConf->getValue("Layout.FR.LocalHops").toInt();
+	int iterations = appConf->getValue("Layout.FR.LocalIterations").isEmpty() ? 100 : appConf->getValue("Layout.FR.LocalIterations").toInt();
+	alg->RelayoutLocal(seeds, hops, iterations);
+}
+void LayoutThread::postEdits(const QLinkedList<osg::ref_ptr<Data::Node> > &nodes)
+{
+	alg->PostEdits(nodes);
+}
 void LayoutThread::setAlphaValue(float val)
 {
 	alg->SetAlphaValue(val);
@@ -36,4 +50,12 @@ void LayoutThread::setAlphaValue(float val)
 bool LayoutThread::isRunning()
 {
 	return alg->IsRunning();
+}
+int LayoutThread::applyPositions()
+{
+	return alg->ApplyPositions();
+}
+int LayoutThread::getEditCount()
+{
+	return alg->GetEditCount();
 }
\ No newline at end of file
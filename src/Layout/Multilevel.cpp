@@ -0,0 +1,176 @@
+#include "Layout/Multilevel.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace Layout;
+
+Multilevel::Multilevel()
+{
+}
+
+void Multilevel::clear()
+{
+	levels.clear();
+	parents.clear();
+}
+
+void Multilevel::build(const Layout::LayoutState &finest, int minCount, unsigned int seed)
+{
+	clear();
+
+	const Layout::LayoutState *fine = &finest;
+	int count = finest.getNodeCount();
+	std::vector<int> weight(count, 1);
+
+	while (count > minCount)
+	{
+		Layout::LayoutState coarse;
+		std::vector<int> parent;
+		std::vector<int> coarseWeight;
+		coarsen(*fine, count, weight, coarse, parent, coarseWeight, LayoutState::hash(seed, (unsigned int) levels.size()));
+
+		// ak sa graf takmer nezmensil (napr. bez hran), dalsie urovne nemaju zmysel
+		if (coarse.getCount() > count * 0.8)
+			break;
+
+		levels.push_back(coarse);
+		parents.push_back(parent);
+		weight.swap(coarseWeight);
+		fine = &levels.back();
+		count = fine->getCount();
+	}
+}
+
+void Multilevel::coarsen(const Layout::LayoutState &fine, int count, const std::vector<int> &weight,
+	Layout::LayoutState &coarse, std::vector<int> &parent, std::vector<int> &coarseWeight, unsigned int seed)
+{
+	// susednost uzlov vo formate CSR, len hrany medzi zhrubovanymi uzlami
+	std::vector<int> offsets;
+	std::vector<int> neighbours;
+	fine.buildNeighbours(count, Layout::LayoutState::NEIGHBOURS_EDGES, false, offsets, neighbours);
+
+	// nahodne poradie uzlov
+	std::vector<int> order(count);
+	for (int i = 0; i < count; i++)
+	{
+		order[i] = i;
+	}
+	for (int i = count - 1; i > 0; i--)
+	{
+		std::swap(order[i], order[LayoutState::hash(seed, (unsigned int) i) % (unsigned int) (i + 1)]);
+	}
+
+	// parovanie so susedom s najmensou vahou
+	parent.assign(count, -1);
+	coarseWeight.clear();
+	for (int k = 0; k < count; k++)
+	{
+		int u = order[k];
+		if (parent[u] != -1)
+			continue;
+		int best = -1;
+		for (int j = offsets[u]; j < offsets[u + 1]; j++)
+		{
+			int v = neighbours[j];
+			if (parent[v] == -1 && (best == -1 || weight[v] < weight[best]))
+				best = v;
+		}
+		if (best == -1)
+			continue;
+		parent[u] = parent[best] = (int) coarseWeight.size();
+		coarseWeight.push_back(weight[u] + weight[best]);
+	}
+	// zvysne uzly pripojime k najlahsej susednej skupine, osamotene uzly tvoria vlastnu skupinu
+	for (int k = 0; k < count; k++)
+	{
+		int u = order[k];
+		if (parent[u] != -1)
+			continue;
+		int best = -1;
+		for (int j = offsets[u]; j < offsets[u + 1]; j++)
+		{
+			int group = parent[neighbours[j]];
+			if (group != -1 && (best == -1 || coarseWeight[group] < coarseWeight[best]))
+				best = group;
+		}
+		if (best == -1)
+		{
+			best = (int) coarseWeight.size();
+			coarseWeight.push_back(0);
+		}
+		parent[u] = best;
+		coarseWeight[best] += weight[u];
+	}
+
+	// skupina je v tazisku svojich uzlov, fixovana skupina v tazisku fixovanych uzlov
+	int groups = (int) coarseWeight.size();
+	coarse.clear();
+	coarse.resize(groups);
+	std::vector<int> members(groups, 0);
+	for (int i = 0; i < count; i++)
+	{
+		int g = parent[i];
+		if (fine.fixed[i] && !coarse.fixed[g])
+		{
+			coarse.fixed[g] = 1;
+			members[g] = 0;
+			coarse.x[g] = coarse.y[g] = coarse.z[g] = 0;
+		}
+		if (fine.fixed[i] || !coarse.fixed[g])
+		{
+			coarse.x[g] += fine.x[i];
+			coarse.y[g] += fine.y[i];
+			coarse.z[g] += fine.z[i];
+			members[g]++;
+		}
+	}
+	for (int g = 0; g < groups; g++)
+	{
+		coarse.x[g] /= members[g];
+		coarse.y[g] /= members[g];
+		coarse.z[g] /= members[g];
+	}
+
+	// hrany medzi skupinami bez duplicit
+	std::vector<std::pair<int, int> > edges;
+	edges.reserve(fine.edgeSrc.size());
+	for (size_t e = 0; e < fine.edgeSrc.size(); e++)
+	{
+		int u = fine.edgeSrc[e], v = fine.edgeDst[e];
+		if (u >= count || v >= count)
+			continue;
+		int gu = parent[u], gv = parent[v];
+		if (gu == gv)
+			continue;
+		edges.push_back(gu < gv ? std::make_pair(gu, gv) : std::make_pair(gv, gu));
+	}
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+	coarse.edgeSrc.resize(edges.size());
+	coarse.edgeDst.resize(edges.size());
+	for (size_t e = 0; e < edges.size(); e++)
+	{
+		coarse.edgeSrc[e] = edges[e].first;
+		coarse.edgeDst[e] = edges[e].second;
+	}
+}
+
+void Multilevel::prolong(int level, Layout::LayoutState &finer, float spread)
+{
+	const Layout::LayoutState &coarse = levels[level - 1];
+	const std::vector<int> &parent = parents[level - 1];
+	int count = (int) parent.size();
+	for (int i = 0; i < count; i++)
+	{
+		if (finer.fixed[i])
+			continue;
+		int g = parent[i];
+		// maly posun, aby sa uzly jednej skupiny nezlucili
+		unsigned int h = LayoutState::hash((unsigned int) level, (unsigned int) i);
+		finer.x[i] = coarse.x[g] + spread * ((float) (h & 0xff) / 127.5f - 1);
+		finer.y[i] = coarse.y[g] + spread * ((float) ((h >> 8) & 0xff) / 127.5f - 1);
+		finer.z[i] = coarse.z[g] + spread * ((float) ((h >> 16) & 0xff) / 127.5f - 1);
+		finer.vx[i] = finer.vy[i] = finer.vz[i] = 0;
+	}
+}
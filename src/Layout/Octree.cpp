@@ -0,0 +1,146 @@
+#include "Layout/Octree.h"
+
+using namespace Layout;
+
+Octree::Octree()
+{
+	x = y = z = NULL;
+}
+
+void Octree::build(const float *x, const float *y, const float *z, int count)
+{
+	cells.clear();
+
+	if (count <= 0)
+	{
+		return;
+	}
+	this->x = x;
+	this->y = y;
+	this->z = z;
+
+	// ohranicujuca kocka vsetkych bodov
+	osg::Vec3f min = point(0);
+	osg::Vec3f max = point(0);
+	for (int i = 1; i < count; i++)
+	{
+		osg::Vec3f position = point(i);
+		for (int k = 0; k < 3; k++)
+		{
+			if (position[k] < min[k]) min[k] = position[k];
+			if (position[k] > max[k]) max[k] = position[k];
+		}
+	}
+	osg::Vec3f size = max - min;
+	float halfSize = size.x();
+	if (size.y() > halfSize) halfSize = size.y();
+	if (size.z() > halfSize) halfSize = size.z();
+	// mala rezerva, aby krajne body nelezali na hranici kocky
+	halfSize = halfSize / 2 + 1;
+
+	cells.reserve(count * 2);
+	createCell((min + max) / 2, halfSize);
+
+	for (int i = 0; i < count; i++)
+	{
+		insert(0, i, 0);
+	}
+	computeMass(0);
+
+	this->x = this->y = this->z = NULL;
+}
+
+int Octree::createCell(const osg::Vec3f &center, float halfSize)
+{
+	Cell cell;
+	cell.center = center;
+	cell.halfSize = halfSize;
+	cell.massCenter = osg::Vec3f(0,0,0);
+	cell.mass = 0;
+	cell.point = -1;
+	cell.leaf = true;
+	for (int i = 0; i < 8; i++)
+	{
+		cell.children[i] = -1;
+	}
+	cells.push_back(cell);
+	return (int) cells.size() - 1;
+}
+
+void Octree::insert(int cell, int point, int depth)
+{
+	if (cells[cell].leaf)
+	{
+		if (cells[cell].mass == 0)
+		{ // prazdny list
+			cells[cell].point = point;
+			cells[cell].mass = 1;
+			cells[cell].massCenter = this->point(point);
+			return;
+		}
+		if (depth >= MAX_DEPTH)
+		{ // splyvajuce body ulozime do jedneho listu
+			cells[cell].mass += 1;
+			cells[cell].massCenter += this->point(point);
+			return;
+		}
+		// list rozdelime na vnutorny uzol
+		int old = cells[cell].point;
+		cells[cell].point = -1;
+		cells[cell].leaf = false;
+		cells[cell].mass = 0;
+		cells[cell].massCenter = osg::Vec3f(0,0,0);
+		insertIntoChild(cell, old, depth);
+	}
+	insertIntoChild(cell, point, depth);
+}
+
+void Octree::insertIntoChild(int cell, int point, int depth)
+{
+	osg::Vec3f position = this->point(point);
+	osg::Vec3f center = cells[cell].center;
+	int octant = (position.x() >= center.x() ? 1 : 0)
+		| (position.y() >= center.y() ? 2 : 0)
+		| (position.z() >= center.z() ? 4 : 0);
+
+	int child = cells[cell].children[octant];
+	if (child == -1)
+	{
+		float halfSize = cells[cell].halfSize / 2;
+		osg::Vec3f childCenter(
+			center.x() + ((octant & 1) ? halfSize : -halfSize),
+			center.y() + ((octant & 2) ? halfSize : -halfSize),
+			center.z() + ((octant & 4) ? halfSize : -halfSize));
+		// pozor, createCell moze realokovat pole buniek
+		child = createCell(childCenter, halfSize);
+		cells[cell].children[octant] = child;
+	}
+	insert(child, point, depth + 1);
+}
+
+void Octree::computeMass(int cell)
+{
+	if (cells[cell].leaf)
+	{
+		if (cells[cell].mass > 1)
+		{
+			cells[cell].massCenter /= cells[cell].mass;
+		}
+		return;
+	}
+
+	float mass = 0;
+	osg::Vec3f massCenter(0,0,0);
+	for (int i = 0; i < 8; i++)
+	{
+		int child = cells[cell].children[i];
+		if (child != -1)
+		{
+			computeMass(child);
+			mass += cells[child].mass;
+			massCenter += cells[child].massCenter * cells[child].mass;
+		}
+	}
+	cells[cell].mass = mass;
+	cells[cell].massCenter = mass > 0 ? massCenter / mass : cells[cell].center;
+}
@@ -0,0 +1,24 @@
+#include "Layout/PivotMdsAlgorithm.h"
+
+using namespace Layout;
+
+PivotMdsAlgorithm::PivotMdsAlgorithm()
+{
+	Util::ApplicationConfig *appConf = Util::ApplicationConfig::get();
+	/* vlakna zdiela s FR, 0 = pocet hardverovych vlakien */
+	pool = new Layout::WorkerPool(appConf->getValue("Layout.FR.ThreadCount").toInt());
+	seed = appConf->getValue("Layout.FR.Seed").isEmpty() ? 1 : appConf->getValue("Layout.FR.Seed").toUInt();
+}
+
+PivotMdsAlgorithm::~PivotMdsAlgorithm()
+{
+	delete pool;
+	pool = NULL;
+}
+
+void PivotMdsAlgorithm::place(Layout::LayoutState &state)
+{
+	Layout::Embedding embedding(pool);
+	embedding.build(state, PIVOT_COUNT, seed, Layout::Embedding::PIVOTS_RANDOM);
+	embedding.placeMds(state, sizeFactor);
+}
@@ -0,0 +1,152 @@
+#include "Layout/PlacementEngine.h"
+
+#include <iostream>
+
+using namespace Layout;
+using namespace std;
+
+PlacementEngine::PlacementEngine()
+{
+	graph = NULL;
+	sizeFactor = 10;
+	pulledEdits = 0;
+	state = RUNNING;
+	notEnd = true;
+	isIterating = false;
+}
+
+void PlacementEngine::SetGraph(Data::Graph *graph)
+{
+	QMutexLocker locker(&schedulerMutex);
+	notEnd = true;
+	this->graph = graph;
+	layoutState.invalidate();
+	if (graph != NULL)
+	{
+		graph->setFrozen(false);
+	}
+	resetStats();
+	editCount.ref();
+	schedulerCondition.wakeAll();
+}
+
+void PlacementEngine::SetParameters(float sizeFactor, float flexibility, int animationSpeed, bool useMaxDistance)
+{
+	QMutexLocker locker(&schedulerMutex);
+	this->sizeFactor = sizeFactor;
+}
+
+void PlacementEngine::PauseAlg()
+{
+	QMutexLocker locker(&schedulerMutex);
+	state = PAUSED;
+	schedulerCondition.wakeAll();
+}
+
+void PlacementEngine::WakeUpAlg()
+{
+	QMutexLocker locker(&schedulerMutex);
+	// pouzivatel zmenil pozicie, fixovanie alebo topologiu grafu
+	editCount.ref();
+	if (graph != NULL && graph->isFrozen())
+	{
+		graph->setFrozen(false);
+		schedulerCondition.wakeAll();
+	}
+}
+
+void PlacementEngine::RunAlg()
+{
+	QMutexLocker locker(&schedulerMutex);
+	if (graph != NULL)
+	{
+		editCount.ref();
+		graph->setFrozen(false);
+		state = RUNNING;
+		notEnd = true;
+		schedulerCondition.wakeAll();
+	}
+}
+
+bool PlacementEngine::IsRunning()
+{
+	return isIterating;
+}
+
+void PlacementEngine::StopAlg()
+{
+	QMutexLocker locker(&schedulerMutex);
+	notEnd = false;
+	schedulerCondition.wakeAll();
+}
+
+void PlacementEngine::Run()
+{
+	if (this->graph != NULL)
+	{
+		isIterating = true;
+		QMutexLocker locker(&schedulerMutex);
+		while (notEnd)
+		{
+			// rozmiestnenie sa nemeni, spime az do dalsej upravy grafu
+			if (state != RUNNING || graph->isFrozen())
+			{
+				if (state == PAUSED)
+				{
+					isIterating = false;
+				}
+				schedulerCondition.wait(&schedulerMutex);
+				continue;
+			}
+			isIterating = true;
+
+			locker.unlock();
+			Step();
+			locker.relock();
+
+			if ((int) editCount == pulledEdits)
+			{
+				graph->setFrozen(true);
+			}
+		}
+		isIterating = false;
+	}
+	else
+	{
+		cout << "Nenastaveny graf. Pouzi metodu SetGraph(Data::Graph graph).";
+	}
+}
+
+bool PlacementEngine::Step()
+{
+	if (graph == NULL)
+	{
+		return false;
+	}
+	QTime timer;
+	timer.start();
+
+	// pocet uprav citame pred frontom uprav, neskorsia uprava sa nacita v dalsom kroku
+	int edits = (int) editCount;
+	QHash<qlonglong, Layout::LayoutState::Edit> queued;
+	takeEdits(queued);
+	bool computed = false;
+	if (layoutState.isStale(graph))
+	{ // nova topologia, rozmiestnenie vypocitame cele znova
+		layoutState.capture(graph);
+		place(layoutState);
+		computed = true;
+	}
+	else if (edits != pulledEdits || !queued.isEmpty())
+	{ // presunute uzly ostanu, kde ich pouzivatel nechal
+		layoutState.pull(queued);
+	}
+	else
+	{
+		return false;
+	}
+	pulledEdits = edits;
+	layoutState.publish(positionBuffer, pulledEdits);
+	recordIteration(timer.elapsed(), computed);
+	return computed;
+}
@@ -0,0 +1,27 @@
+#include "Layout/PositionBuffer.h"
+
+using namespace Layout;
+
+PositionBuffer::PositionBuffer() : ready(1), published(0)
+{
+	back = 0;
+	front = 2;
+	sequence = 0;
+}
+
+void PositionBuffer::publish()
+{
+	frames[back].sequence = ++sequence;
+	// zapis snimky je viditelny skor ako jej index
+	back = ready.fetchAndStoreOrdered(back | FRESH) & ~FRESH;
+	published.fetchAndStoreRelease(sequence);
+}
+
+const PositionBuffer::Frame *PositionBuffer::acquire()
+{
+	if ((int) ready & FRESH)
+	{
+		front = ready.fetchAndStoreOrdered(front) & ~FRESH;
+	}
+	return frames[front].sequence > 0 ? &frames[front] : NULL;
+}
@@ -0,0 +1,233 @@
+#include "Layout/SpatialGrid.h"
+
+#include <math.h>
+
+using namespace Layout;
+
+namespace
+{
+	/* rozsah celociselnych suradnic bunky, 21 bitov na os vratane susednych buniek */
+	const int COORD_LIMIT = (1 << 20) - 2;
+
+	int cellCoord(float value, float cellSize)
+	{
+		float c = floorf(value / cellSize);
+		if (!(c > -COORD_LIMIT))
+			return -COORD_LIMIT;
+		if (c > COORD_LIMIT)
+			return COORD_LIMIT;
+		return (int) c;
+	}
+}
+
+SpatialGrid::SpatialGrid()
+{
+	cellSize = 1;
+	emptyCells = 0;
+	moved = 0;
+	cellOffsets.push_back(0);
+	neighbourOffsets.push_back(0);
+}
+
+void SpatialGrid::setCellSize(float size)
+{
+	if (size != cellSize)
+	{
+		cellSize = size;
+		clear();
+	}
+}
+
+void SpatialGrid::clear()
+{
+	cellIndex.clear();
+	cellKeys.clear();
+	members.clear();
+	cellOf.clear();
+	slotOf.clear();
+	emptyCells = 0;
+	moved = 0;
+	cellOffsets.assign(1, 0);
+	neighbourOffsets.assign(1, 0);
+	neighbours.clear();
+	sortedX.clear();
+	sortedY.clear();
+	sortedZ.clear();
+	sortedNodes.clear();
+}
+
+qlonglong SpatialGrid::makeKey(int i, int j, int k)
+{
+	return ((qlonglong) (i + COORD_LIMIT + 2) << 42) | ((qlonglong) (j + COORD_LIMIT + 2) << 21) | (qlonglong) (k + COORD_LIMIT + 2);
+}
+
+qlonglong SpatialGrid::keyOf(float x, float y, float z) const
+{
+	return makeKey(cellCoord(x, cellSize), cellCoord(y, cellSize), cellCoord(z, cellSize));
+}
+
+void SpatialGrid::insert(int node, qlonglong key)
+{
+	QHash<qlonglong, int>::const_iterator it = cellIndex.constFind(key);
+	int cell;
+	if (it == cellIndex.constEnd())
+	{
+		cell = (int) cellKeys.size();
+		cellIndex.insert(key, cell);
+		cellKeys.push_back(key);
+		members.push_back(std::vector<int>());
+	}
+	else
+	{
+		cell = it.value();
+		if (members[cell].empty())
+			emptyCells--;
+	}
+	cellOf[node] = cell;
+	slotOf[node] = (int) members[cell].size();
+	members[cell].push_back(node);
+}
+
+void SpatialGrid::remove(int node)
+{
+	std::vector<int> &list = members[cellOf[node]];
+	// na miesto uzla presunieme posledny uzol bunky
+	int last = list.back();
+	list[slotOf[node]] = last;
+	slotOf[last] = slotOf[node];
+	list.pop_back();
+	if (list.empty())
+		emptyCells++;
+	cellOf[node] = -1;
+}
+
+void SpatialGrid::rebuild(const float *x, const float *y, const float *z, int count)
+{
+	clear();
+	cellOf.assign(count, -1);
+	slotOf.assign(count, -1);
+	for (int i = 0; i < count; i++)
+	{
+		insert(i, keyOf(x[i], y[i], z[i]));
+	}
+	moved = count;
+}
+
+void SpatialGrid::update(const float *x, const float *y, const float *z, int count)
+{
+	if ((int) cellOf.size() != count)
+	{
+		rebuild(x, y, z, count);
+	}
+	else
+	{
+		moved = 0;
+		for (int i = 0; i < count; i++)
+		{
+			qlonglong key = keyOf(x[i], y[i], z[i]);
+			if (key != cellKeys[cellOf[i]])
+			{ // uzol presiel do inej bunky
+				remove(i);
+				insert(i, key);
+				moved++;
+			}
+		}
+		// prilis vela prazdnych buniek, mriezku postavime znova
+		if (emptyCells > 64 && emptyCells * 2 > (int) cellKeys.size())
+		{
+			rebuild(x, y, z, count);
+		}
+	}
+	pack(x, y, z);
+}
+
+void SpatialGrid::move(int node, float x, float y, float z)
+{
+	qlonglong key = keyOf(x, y, z);
+	if (key != cellKeys[cellOf[node]])
+	{
+		remove(node);
+		insert(node, key);
+		moved++;
+	}
+}
+
+void SpatialGrid::collectNear(float x, float y, float z, std::vector<int> &result) const
+{
+	int ci = cellCoord(x, cellSize), cj = cellCoord(y, cellSize), ck = cellCoord(z, cellSize);
+	for (int i = ci - 1; i <= ci + 1; i++)
+	{
+		for (int j = cj - 1; j <= cj + 1; j++)
+		{
+			for (int k = ck - 1; k <= ck + 1; k++)
+			{
+				QHash<qlonglong, int>::const_iterator it = cellIndex.constFind(makeKey(i, j, k));
+				if (it != cellIndex.constEnd())
+					result.insert(result.end(), members[it.value()].begin(), members[it.value()].end());
+			}
+		}
+	}
+}
+
+void SpatialGrid::pack(const float *x, const float *y, const float *z)
+{
+	int cells = (int) cellKeys.size();
+	int count = (int) cellOf.size();
+
+	if (moved > 0)
+	{
+		// rozlozenie uzlov do buniek sa zmenilo
+		cellOffsets.resize(cells + 1);
+		cellOffsets[0] = 0;
+		for (int c = 0; c < cells; c++)
+		{
+			cellOffsets[c + 1] = cellOffsets[c] + (int) members[c].size();
+		}
+		sortedNodes.resize(count);
+		for (int c = 0; c < cells; c++)
+		{
+			for (size_t m = 0; m < members[c].size(); m++)
+			{
+				sortedNodes[cellOffsets[c] + m] = members[c][m];
+			}
+		}
+
+		// obsadene susedne bunky vratane samotnej bunky
+		neighbourOffsets.resize(cells + 1);
+		neighbours.clear();
+		for (int c = 0; c < cells; c++)
+		{
+			neighbourOffsets[c] = (int) neighbours.size();
+			if (members[c].empty())
+				continue;
+			qlonglong key = cellKeys[c];
+			int ci = (int) (key >> 42) - COORD_LIMIT - 2;
+			int cj = (int) ((key >> 21) & 0x1fffff) - COORD_LIMIT - 2;
+			int ck = (int) (key & 0x1fffff) - COORD_LIMIT - 2;
+			for (int i = ci - 1; i <= ci + 1; i++)
+			{
+				for (int j = cj - 1; j <= cj + 1; j++)
+				{
+					for (int k = ck - 1; k <= ck + 1; k++)
+					{
+						QHash<qlonglong, int>::const_iterator it = cellIndex.constFind(makeKey(i, j, k));
+						if (it != cellIndex.constEnd() && !members[it.value()].empty())
+							neighbours.push_back(it.value());
+					}
+				}
+			}
+		}
+		neighbourOffsets[cells] = (int) neighbours.size();
+	}
+
+	sortedX.resize(count);
+	sortedY.resize(count);
+	sortedZ.resize(count);
+	for (int s = 0; s < count; s++)
+	{
+		int i = sortedNodes[s];
+		sortedX[s] = x[i];
+		sortedY[s] = y[i];
+		sortedZ[s] = z[i];
+	}
+}
@@ -0,0 +1,66 @@
+#include "Layout/Telemetry.h"
+
+#include <QFile>
+#include <QMutexLocker>
+#include <QTextStream>
+
+using namespace Layout;
+
+Telemetry::Telemetry()
+{
+	next = 0;
+	capacity = DEFAULT_CAPACITY;
+}
+
+void Telemetry::setCapacity(int capacity)
+{
+	QMutexLocker locker(&mutex);
+	this->capacity = capacity > 0 ? capacity : 1;
+	samples.clear();
+	next = 0;
+}
+
+void Telemetry::record(const Sample &sample)
+{
+	QMutexLocker locker(&mutex);
+	// pamat rastie az po kapacitu, potom prepisujeme najstarsiu vzorku
+	if ((int) samples.size() < capacity)
+	{
+		samples.push_back(sample);
+		return;
+	}
+	samples[next] = sample;
+	next = (next + 1) % capacity;
+}
+
+void Telemetry::getSamples(std::vector<Sample> &samples) const
+{
+	QMutexLocker locker(&mutex);
+	samples.assign(this->samples.begin() + next, this->samples.end());
+	samples.insert(samples.end(), this->samples.begin(), this->samples.begin() + next);
+}
+
+void Telemetry::clear()
+{
+	QMutexLocker locker(&mutex);
+	samples.clear();
+	next = 0;
+}
+
+bool Telemetry::writeCsv(const QString &path) const
+{
+	std::vector<Sample> copy;
+	getSamples(copy);
+	QFile file(path);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+	QTextStream out(&file);
+	out << "iteration,repulsion_ms,attraction_ms,apply_ms,energy,max_displacement,mean_displacement,moved\n";
+	for (size_t k = 0; k < copy.size(); k++)
+	{
+		const Sample &s = copy[k];
+		out << s.iteration << "," << s.repulsionMs << "," << s.attractionMs << "," << s.applyMs << ","
+			<< s.energy << "," << s.maxDisplacement << "," << s.meanDisplacement << "," << s.moved << "\n";
+	}
+	return true;
+}
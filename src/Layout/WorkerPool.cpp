@@ -0,0 +1,78 @@
+#include "Layout/WorkerPool.h"
+
+using namespace Layout;
+
+namespace
+{
+	/* Spracuje jeden rozsah ulohy vo vlakne poolu */
+	class RangeRunnable : public QRunnable
+	{
+	public:
+		RangeRunnable(ParallelTask *task, int worker, int begin, int end, QSemaphore *done)
+			: task(task), worker(worker), begin(begin), end(end), done(done)
+		{
+			setAutoDelete(true);
+		}
+
+		void run()
+		{
+			task->run(worker, begin, end);
+			done->release();
+		}
+
+	private:
+		ParallelTask *task;
+		int worker;
+		int begin;
+		int end;
+		QSemaphore *done;
+	};
+}
+
+WorkerPool::WorkerPool(int threadCount)
+{
+	if (threadCount <= 0)
+	{
+		threadCount = QThread::idealThreadCount();
+	}
+	if (threadCount <= 0)
+	{
+		threadCount = 1;
+	}
+	this->threadCount = threadCount;
+	// volajuce vlakno spracuje prvy rozsah samo
+	pool.setMaxThreadCount(threadCount > 1 ? threadCount - 1 : 1);
+}
+
+WorkerPool::~WorkerPool()
+{
+	pool.waitForDone();
+}
+
+void WorkerPool::getRange(int worker, int workers, int count, int &begin, int &end)
+{
+	int size = count / workers;
+	int rest = count % workers;
+	begin = worker * size + (worker < rest ? worker : rest);
+	end = begin + size + (worker < rest ? 1 : 0);
+}
+
+void WorkerPool::run(Layout::ParallelTask *task, int count)
+{
+	run(task, 0, count);
+}
+
+void WorkerPool::run(Layout::ParallelTask *task, int first, int last)
+{
+	int begin, end;
+	for (int worker = 1; worker < threadCount; worker++)
+	{
+		getRange(worker, threadCount, last - first, begin, end);
+		pool.start(new RangeRunnable(task, worker, first + begin, first + end, &done));
+	}
+
+	getRange(0, threadCount, last - first, begin, end);
+	task->run(0, first + begin, first + end);
+
+	done.acquire(threadCount - 1);
+}
@@ -0,0 +1,318 @@
+/*!
+ * GraphMLImporter.cpp
+ * Projekt 3DVisual
+ */
+
+#include "Manager/GraphMLImporter.h"
+#include "Util/ApplicationConfig.h"
+
+#include <QPair>
+#include <QStringList>
+
+Manager::GraphMLImporter::GraphMLImporter(QString filepath) : doc("graphMLDocument")
+{
+	skippedEdges = 0;
+
+	// ziskame graph element
+	QFile graphMLDocument(filepath);
+	if (graphMLDocument.open(QIODevice::ReadOnly))
+	{
+		if (doc.setContent(&graphMLDocument))
+		{
+			QDomElement docElem = doc.documentElement();
+			if (!docElem.isNull() && docElem.nodeName() == "graphml")
+			{
+				QDomNodeList graphNodes = docElem.elementsByTagName("graph");
+				if (graphNodes.length() > 0)
+				{
+					QDomNode graphElement = graphNodes.item(0);
+					if (!graphElement.isNull() && graphElement.parentNode() == docElem && graphElement.isElement())
+					{
+						rootElement = graphElement.toElement();
+					}
+				}
+			}
+		}
+	}
+}
+
+QString Manager::GraphMLImporter::getGraphName() const
+{
+	return "Graph " + rootElement.attribute("id");
+}
+
+bool Manager::GraphMLImporter::import(Data::Graph *graph, Progress *progress)
+{
+	if (rootElement.isNull())
+		return false;
+
+	skippedEdges = 0;
+	bool defaultDirection = rootElement.attribute("edgedefault") == "directed";
+	QDomNodeList nodes = rootElement.elementsByTagName("node");
+	QDomNodeList edges = rootElement.elementsByTagName("edge");
+
+	// ziskame pristup ku nastaveniam
+	Util::ApplicationConfig * appConf = Util::ApplicationConfig::get();
+	QString edgeTypeAttribute = appConf->getValue("GraphMLParser.edgeTypeAttribute");
+	QString nodeTypeAttribute = appConf->getValue("GraphMLParser.nodeTypeAttribute");
+
+	// deklarovane kluce budu stlpcami atributov uzlov a hran
+	Data::AttributeStore *nodeAttributes = graph->getNodeAttributes();
+	Data::AttributeStore *edgeAttributes = graph->getEdgeAttributes();
+	QDomNodeList keys = rootElement.parentNode().toElement().elementsByTagName("key");
+	for (unsigned int i = 0; i < keys.length(); i++)
+	{
+		QDomElement keyElement = keys.item(i).toElement();
+		if (keyElement.isNull())
+			continue;
+
+		QString keyFor = keyElement.attribute("for", "all");
+		QString keyName = keyElement.attribute("attr.name", keyElement.attribute("id"));
+		Data::AttributeStore::Type keyType = Data::AttributeStore::parseType(keyElement.attribute("attr.type"));
+		QString keyDefault = keyElement.firstChildElement("default").text();
+		if (keyFor == "node" || keyFor == "all")
+			nodeAttributes->addColumn(keyElement.attribute("id"), keyName, keyType, keyDefault);
+		if (keyFor == "edge" || keyFor == "all")
+			edgeAttributes->addColumn(keyElement.attribute("id"), keyName, keyType, keyDefault);
+	}
+	QList<QPair<int, QString> > values;
+	// uzly a hrany pridavame do grafu naraz, hodnoty atributov zapiseme po ich vytvoreni
+	QList<QList<QPair<int, QString> > > elementValues;
+
+	// pridavame default typy
+	Data::Type *edgeType = graph->addType("edge");
+	Data::Type *nodeType = graph->addType("node");
+
+	readNodes.clear();
+	// skusal som aj cez QList, ale vobec mi to neslo, tak som to spravil len takto jednoducho cez pole
+	int colors = 6;
+	// pole farieb FIXME prerobit cez nejaky QList alebo nieco take, oddelit farby hran od farieb uzlov
+	qint8 nodeTypeSettings[6][4] = {
+		{0, 1, 0, 1},
+		{0, 1, 1, 1},
+		{1, 0, 0, 1},
+		{1, 0, 1, 1},
+		{1, 1, 0, 1},
+		{1, 1, 1, 1},
+	};
+	qint8 iColor = 0;
+
+	// vypis % pri nacitavani grafu
+	int step = 0;
+	int stepLength = (int) (nodes.count()+edges.count())/100;
+	if(stepLength == 0) {
+		// zadame defaultnu hodnotu, aby to nezlyhavalo
+		stepLength = 50;
+	}
+
+	QList<Data::Graph::NodeSpec> nodeSpecs;
+	QStringList nameIds;
+	nodeSpecs.reserve(nodes.length());
+
+	// prechadzame uzlami
+	for (unsigned int i = 0; i < nodes.length(); i++)
+	{
+		if(progress != NULL && i % stepLength == 0){
+			progress->setValue(step++);
+		}
+
+		QDomNode nodeNode = nodes.item(i);
+		if (!nodeNode.isNull() && nodeNode.isElement())
+		{
+			QDomElement nodeElement = nodeNode.toElement();
+			if (nodeElement.parentNode() == rootElement)
+			{
+				QString nameId = nodeElement.attribute("id");
+				QString name = NULL;
+				values.clear();
+				// pozerame sa na data ktore nesie
+				Data::Type *newNodeType = NULL;
+				QDomNodeList nodeDataList = nodeElement.elementsByTagName("data");
+				for (unsigned int j = 0; j < nodeDataList.length(); j++){
+					QDomNode nodeData = nodeDataList.item(j);
+					if (!nodeData.isNull() && nodeData.isElement())
+					{
+						QDomElement nodeDataElement = nodeData.toElement();
+						QString dataName = nodeDataElement.attribute("key");
+						QString dataValue = nodeDataElement.text();
+						// nedeklarovany kluc citame ako retazec
+						int column = nodeAttributes->addColumn(dataName, dataName, Data::AttributeStore::STRING);
+						values.append(qMakePair(column, dataValue));
+						// rozpoznavame typy
+						if(dataName == nodeTypeAttribute){
+							// overime ci uz dany typ existuje v grafe
+							QList<Data::Type*> types = graph->getTypesByName(dataValue);
+							if(types.isEmpty()){
+								QMap<QString, QString> *settings = new QMap<QString, QString>;
+
+								settings->insert("color.R", QString::number(nodeTypeSettings[iColor][0]));
+								settings->insert("color.G", QString::number(nodeTypeSettings[iColor][1]));
+								settings->insert("color.B", QString::number(nodeTypeSettings[iColor][2]));
+								settings->insert("color.A", QString::number(nodeTypeSettings[iColor][3]));
+								settings->insert("scale",		appConf->getValue("Viewer.Textures.DefaultNodeScale"));
+								settings->insert("textureFile", appConf->getValue("Viewer.Textures.Node"));
+
+								newNodeType = graph->addType(dataValue, settings);
+
+								if(iColor == colors){
+									iColor = 0;
+								} else {
+									iColor++;
+								}
+							} else {
+								newNodeType = types.first();
+							}
+
+						} else {
+							// kazde dalsie data nacitame do nosica dat - Node.name
+							// FIXME potom prerobit cez Adamove Node.settings
+							if(name == NULL){
+								name = dataName+":"+dataValue;
+							} else {
+								name += " | "+dataName+":"+dataValue;
+							}
+						}
+					}
+				}
+
+				// ak sme nenasli name, tak ako name pouzijeme aspon ID
+				if(name == NULL){
+					name = nameId;
+				}
+
+				// ak nebol najdeny ziaden typ, tak pouzijeme defaultny typ
+				nodeSpecs.append(Data::Graph::NodeSpec(name, newNodeType == NULL ? nodeType : newNodeType));
+				nameIds.append(nameId);
+				elementValues.append(values);
+			}
+		}
+	}
+
+	QList<osg::ref_ptr<Data::Node> > addedNodes = graph->addNodes(nodeSpecs);
+	for (int i = 0; i < addedNodes.size(); i++)
+	{
+		readNodes.insert(nameIds.at(i), addedNodes.at(i));
+
+		int row = nodeAttributes->addRow(addedNodes.at(i)->getId());
+		for (int k = 0; k < elementValues.at(i).size(); k++)
+			nodeAttributes->setValue(elementValues.at(i).at(k).first, row, elementValues.at(i).at(k).second);
+	}
+	elementValues.clear();
+
+	iColor = 0;
+
+	QList<Data::Graph::EdgeSpec> edgeSpecs;
+	edgeSpecs.reserve(edges.length());
+
+	// prechadzame hranami
+	for (uint i = 0; i < edges.length(); i++)
+	{
+		if(progress != NULL && i % stepLength == 0){
+			progress->setValue(step++);
+		}
+
+		QDomNode edgeNode = edges.item(i);
+
+		if (!edgeNode.isNull() && edgeNode.isElement())
+		{
+			QDomElement edgeElement = edgeNode.toElement();
+			if (edgeElement.parentNode() == rootElement)
+			{
+				QString sourceId = edgeElement.attribute("source");
+				QString targetId = edgeElement.attribute("target");
+
+				QString direction = NULL;
+				bool directed = false;
+				direction = edgeElement.attribute("directed");
+				if(direction == NULL) {
+					directed = defaultDirection;
+					if(directed)
+						direction = "_directed";
+					else
+						direction = "";
+				} else {
+					if(direction == "true"){
+						direction = "_directed";
+						directed = true;
+					} else {
+						direction = "";
+						directed = false;
+					}
+				}
+
+				// pozerame sa na data ktore hrana nesie
+				Data::Type *newEdgeType = NULL;
+				values.clear();
+				QDomNodeList edgeDataList = edgeElement.elementsByTagName("data");
+				for (unsigned int j = 0; j < edgeDataList.length(); j++){
+					QDomNode edgeData = edgeDataList.item(j);
+					if (!edgeData.isNull() && edgeData.isElement())
+					{
+						QDomElement edgeDataElement = edgeData.toElement();
+						QString dataName = edgeDataElement.attribute("key");
+						QString dataValue = edgeDataElement.text();
+						int column = edgeAttributes->addColumn(dataName, dataName, Data::AttributeStore::STRING);
+						values.append(qMakePair(column, dataValue));
+						// rozpoznavame typy deklarovane atributom relation
+						if(dataName == edgeTypeAttribute){
+							// overime ci uz dany typ existuje v grafe
+							QList<Data::Type*> types = graph->getTypesByName(dataValue+direction);
+							if(types.isEmpty()){
+								QMap<QString, QString> *settings = new QMap<QString, QString>;
+
+								// FIXME spravit tak, aby to rotovalo po tom poli - palo az to budes prerabat tak pre hrany pouzi ine pole, take co ma alfu na 0.5.. a to sa tyka aj uzlov s defaultnym typom
+								settings->insert("color.R", QString::number(nodeTypeSettings[iColor][0]));
+								settings->insert("color.G", QString::number(nodeTypeSettings[iColor][1]));
+								settings->insert("color.B", QString::number(nodeTypeSettings[iColor][2]));
+								settings->insert("color.A", QString::number(nodeTypeSettings[iColor][3]));
+								settings->insert("scale",		appConf->getValue("Viewer.Textures.DefaultNodeScale"));
+
+								if (!directed)
+									settings->insert("textureFile", appConf->getValue("Viewer.Textures.Edge"));
+								else
+								{
+									settings->insert("textureFile", appConf->getValue("Viewer.Textures.OrientedEdgePrefix"));
+									settings->insert("textureFile", appConf->getValue("Viewer.Textures.OrientedEdgeSuffix"));
+								}
+
+								newEdgeType = graph->addType(dataValue+direction, settings);
+
+								if(iColor == colors){
+									iColor = 0;
+								} else {
+									iColor++;
+								}
+							} else {
+								newEdgeType = types.first();
+							}
+
+						}
+					}
+				}
+
+				// ak nebol najdeny typ, tak pouzijeme defaulty
+				if(newEdgeType == NULL)
+					newEdgeType = edgeType;
+
+				// hrany na neexistujuce uzly preskocime
+				if(!readNodes.contains(sourceId) || !readNodes.contains(targetId)){
+					skippedEdges++;
+					continue;
+				}
+
+				edgeSpecs.append(Data::Graph::EdgeSpec(sourceId+targetId, readNodes.value(sourceId), readNodes.value(targetId), newEdgeType, directed));
+				elementValues.append(values);
+			}
+		}
+	}
+
+	QList<osg::ref_ptr<Data::Edge> > addedEdges = graph->addEdges(edgeSpecs);
+	for (int i = 0; i < addedEdges.size(); i++)
+	{
+		int row = edgeAttributes->addRow(addedEdges.at(i)->getId());
+		for (int k = 0; k < elementValues.at(i).size(); k++)
+			edgeAttributes->setValue(elementValues.at(i).at(k).first, row, elementValues.at(i).at(k).second);
+	}
+
+	return true;
+}
@@ -4,9 +4,24 @@
  */
 
 #include "Manager/Manager.h"
+#include "Manager/GraphMLImporter.h"
 #include "Model/GraphDAO.h"
 #include "Util/ApplicationConfig.h"
 
+namespace
+{
+    /* priebeh nacitania grafu zobrazime v progress bare aplikacie */
+    class ImportProgressBar : public Manager::GraphMLImporter::Progress
+    {
+    public:
+        ImportProgressBar(QOSG::MessageWindows *messageWindows) : messageWindows(messageWindows) {}
+
+        void setValue(int value) { messageWindows->setProgressBarValue(value); }
+
+    private:
+        QOSG::MessageWindows *messageWindows;
+    };
+}
 
 Manager::GraphManager * Manager::GraphManager::manager;
 
@@ -33,262 +48,19 @@ Data::Graph* Manager::GraphManager::loadGraph(QString filepath)
 
     AppCore::Core::getInstance()->thr->pause();
 
-    // TODO presunut do samostatneho modulu pre spracovanie GraphML
-
     // ziskame graph element
-    QDomElement rootElement;
-    QDomNode graphElement;
-    QFile graphMLDocument(filepath);
-    if (graphMLDocument.open(QIODevice::ReadOnly))
-        {
-                QDomDocument doc("graphMLDocument");
-                if (doc.setContent(&graphMLDocument))
-                {
-                        QDomElement docElem = doc.documentElement();
-                        if (!docElem.isNull() && docElem.nodeName() == "graphml")
-                        {
-                                QDomNodeList graphNodes = docElem.elementsByTagName("graph");
-                                if (graphNodes.length() > 0)
-                                {
-                                        graphElement = graphNodes.item(0);
-                                        if (!graphElement.isNull() && graphElement.parentNode() == docElem && graphElement.isElement())
-                                        {
-                                                rootElement = graphElement.toElement();
-                                        }
-                                }
-                        }
-                }
-        }
+    Manager::GraphMLImporter importer(filepath);
 
     // ak mame rootElement tak
-    if(!rootElement.isNull())
+    if(importer.isValid())
 	{
-        QString graphname = "Graph "+rootElement.attribute("id");
-        bool defaultDirection;
-        if(rootElement.attribute("edgedefault") == "directed"){
-            defaultDirection = true;
-        } else {
-            defaultDirection = false;
-        }
-        QDomNodeList nodes = rootElement.elementsByTagName("node");
-        QDomNodeList edges = rootElement.elementsByTagName("edge");
-
         AppCore::Core::getInstance()->messageWindows->showProgressBar();
 
-        Data::Graph *newGraph = this->createGraph(graphname);
+        Data::Graph *newGraph = this->createGraph(importer.getGraphName());
         if(newGraph == NULL) return NULL;
 
-        // ziskame pristup ku nastaveniam
-        Util::ApplicationConfig * appConf = Util::ApplicationConfig::get();
-        QString edgeTypeAttribute = appConf->getValue("GraphMLParser.edgeTypeAttribute");
-        QString nodeTypeAttribute = appConf->getValue("GraphMLParser.nodeTypeAttribute");
-
-        // pridavame default typy
-        Data::Type *edgeType = newGraph->addType("edge");
-        Data::Type *nodeType = newGraph->addType("node");
-
-        QMap<QString, osg::ref_ptr<Data::Node> >* readNodes = new QMap<QString, osg::ref_ptr<Data::Node> >();
-        // skusal som aj cez QList, ale vobec mi to neslo, tak som to spravil len takto jednoducho cez pole
-        int colors = 6;
-        // pole farieb FIXME prerobit cez nejaky QList alebo nieco take, oddelit farby hran od farieb uzlov
-        qint8 nodeTypeSettings[6][4] = {
-            {0, 1, 0, 1},
-            {0, 1, 1, 1},
-            {1, 0, 0, 1},
-            {1, 0, 1, 1},
-            {1, 1, 0, 1},
-            {1, 1, 1, 1},
-        };
-        qint8 iColor = 0;
-
-        // vypis % pri nacitavani grafu
-        int step = 0;
-        int stepLength = (int) (nodes.count()+edges.count())/100;
-        if(stepLength == 0) {
-            // zadame defaultnu hodnotu, aby to nezlyhavalo
-            stepLength = 50;
-        }
-
-        // prechadzame uzlami
-        for (unsigned int i = 0; i < nodes.length(); i++)
-        {
-
-                if(i % stepLength == 0){
-                    AppCore::Core::getInstance()->messageWindows->setProgressBarValue(step++);
-                }
-
-                QDomNode nodeNode = nodes.item(i);
-                if (!nodeNode.isNull() && nodeNode.isElement())
-                {
-                    QDomElement nodeElement = nodeNode.toElement();
-                    if (nodeElement.parentNode() == graphElement)
-                    {
-                            QString nameId = nodeElement.attribute("id");
-                            QString name = NULL;
-                            // pozerame sa na data ktore nesie
-                            Data::Type *newNodeType;
-                            newNodeType = NULL;
-                            QDomNodeList nodeDataList = nodeElement.elementsByTagName("data");
-                            for (unsigned int j = 0; j < nodeDataList.length(); j++){
-                                QDomNode nodeData = nodeDataList.item(j);
-                                if (!nodeData.isNull() && nodeData.isElement())
-                                {
-                                        QDomElement nodeDataElement = nodeData.toElement();
-                                        QString dataName = nodeDataElement.attribute("key");
-                                        QString dataValue = nodeDataElement.text();
-                                        // rozpoznavame typy
-                                        if(dataName == nodeTypeAttribute){
-                                            // overime ci uz dany typ existuje v grafe
-                                            QList<Data::Type*> types = newGraph->getTypesByName(dataValue);
-                                            if(types.isEmpty()){
-                                                QMap<QString, QString> *settings = new QMap<QString, QString>;
-
-                                                settings->insert("color.R", QString::number(nodeTypeSettings[iColor][0]));
-                                                settings->insert("color.G", QString::number(nodeTypeSettings[iColor][1]));
-                                                settings->insert("color.B", QString::number(nodeTypeSettings[iColor][2]));
-                                                settings->insert("color.A", QString::number(nodeTypeSettings[iColor][3]));
-                                                settings->insert("scale",		Util::ApplicationConfig::get()->getValue("Viewer.Textures.DefaultNodeScale"));
-                                                settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.Node"));
-
-                                                newNodeType = newGraph->addType(dataValue, settings);
-
-                                                if(iColor == colors){
-                                                    iColor = 0;
-                                                } else {
-                                                    iColor++;
-                                                }
-                                            } else {
-                                                newNodeType = types.first();
-                                            }
-
-                                        } else {
-                                            // kazde dalsie data nacitame do nosica dat - Node.name
-                                            // FIXME potom prerobit cez Adamove Node.settings
-                                            if(name == NULL){
-                                                name = dataName+":"+dataValue;
-                                            } else {
-                                                name += " | "+dataName+":"+dataValue;
-                                            }
-                                        }
-                                }
-                            }
-
-                            // ak sme nenasli name, tak ako name pouzijeme aspon ID
-                            if(name == NULL){
-                                name = nameId;
-                            }
-
-                            // ak nebol najdeny ziaden typ, tak pouzijeme defaultny typ
-                            osg::ref_ptr<Data::Node> node;
-                            if(newNodeType == NULL)
-                                node = newGraph->addNode(name, nodeType);
-                            else
-                                node = newGraph->addNode(name, newNodeType);
-                            readNodes->insert(nameId, node);
-                    }
-            }
-        }
-
-        iColor = 0;
-
-        // prechadzame hranami
-        for (uint i = 0; i < edges.length(); i++)
-        {
-
-            if(i % stepLength == 0){
-                AppCore::Core::getInstance()->messageWindows->setProgressBarValue(step++);
-            }
-
-                QDomNode edgeNode = edges.item(i);
-
-                if (!edgeNode.isNull() && edgeNode.isElement())
-                {
-                        QDomElement edgeElement = edgeNode.toElement();
-                        if (edgeElement.parentNode() == rootElement)
-                        {
-                                QString sourceId = edgeElement.attribute("source");
-                                QString targetId = edgeElement.attribute("target");
-
-                                QString direction = NULL;
-                                bool directed = false;
-                                direction = edgeElement.attribute("directed");
-                                if(direction == NULL) {
-                                    directed = defaultDirection;
-                                    if(directed)
-                                        direction = "_directed";
-                                    else
-                                        direction = "";
-                                } else {
-                                    if(direction == "true"){
-                                        direction = "_directed";
-                                        directed = true;
-                                    } else {
-                                        direction = "";
-                                        directed = false;
-                                    }
-                                }
-
-
-
-                                // pozerame sa na data ktore hrana nesie
-                                Data::Type *newEdgeType;
-                                newEdgeType = NULL;
-                                QDomNodeList edgeDataList = edgeElement.elementsByTagName("data");
-                                for (unsigned int j = 0; j < edgeDataList.length(); j++){
-                                    QDomNode edgeData = edgeDataList.item(j);
-                                    if (!edgeData.isNull() && edgeData.isElement())
-                                    {
-                                            QDomElement edgeDataElement = edgeData.toElement();
-                                            QString dataName = edgeDataElement.attribute("key");
-                                            QString dataValue = edgeDataElement.text();
-                                            // rozpoznavame typy deklarovane atributom relation
-                                            if(dataName == edgeTypeAttribute){
-                                                // overime ci uz dany typ existuje v grafe
-                                                QList<Data::Type*> types = newGraph->getTypesByName(dataValue+direction);
-                                                if(types.isEmpty()){
-                                                    QMap<QString, QString> *settings = new QMap<QString, QString>;
-
-                                                    // FIXME spravit tak, aby to rotovalo po tom poli - palo az to budes prerabat tak pre hrany pouzi ine pole, take co ma alfu na 0.5.. a to sa tyka aj uzlov s defaultnym typom
-                                                   settings->insert("color.R", QString::number(nodeTypeSettings[iColor][0]));
-                                                   settings->insert("color.G", QString::number(nodeTypeSettings[iColor][1]));
-                                                   settings->insert("color.B", QString::number(nodeTypeSettings[iColor][2]));
-                                                   settings->insert("color.A", QString::number(nodeTypeSettings[iColor][3]));
-                                                   settings->insert("scale",		Util::ApplicationConfig::get()->getValue("Viewer.Textures.DefaultNodeScale"));
-
-                                                   if (!directed)
-                                                        settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.Edge"));
-                                                   else
-                                                   {
-                                                       settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.OrientedEdgePrefix"));
-                                                       settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.OrientedEdgeSuffix"));
-                                                   }
-
-                                                    newEdgeType = newGraph->addType(dataValue+direction, settings);
-
-                                                    if(iColor == colors){
-                                                        iColor = 0;
-                                                    } else {
-                                                        iColor++;
-                                                    }
-                                                } else {
-                                                    newEdgeType = types.first();
-                                                }
-
-                                            } else {
-                                                // kazde dalsie data nacitame do nosica dat - Edge.name
-                                                // FIXME potom prerobit cez Adamove Node.settings
-                                            }
-                                    }
-                                }
-
-                                // ak nebol najdeny typ, tak pouzijeme defaulty
-                                if(newEdgeType == NULL)
-                                    newEdgeType = edgeType;
-
-                                newGraph->addEdge(sourceId+targetId, readNodes->value(sourceId), readNodes->value(targetId), newEdgeType, directed);
-                        }
-                }
-        }
+        ImportProgressBar progress(AppCore::Core::getInstance()->messageWindows);
+        importer.import(newGraph, &progress);
 
         // ak uz nejaky graf mame, tak ho najprv sejvneme a zavrieme
         if(this->activeGraph != NULL){
@@ -302,6 +74,10 @@ Data::Graph* Manager::GraphManager::loadGraph(QString filepath)
         newGraph->selectLayout(gLay);
         AppCore::Core::getInstance()->messageWindows->closeProgressBar();
 
+        if(importer.getSkippedEdgeCount() > 0){
+            AppCore::Core::getInstance()->messageWindows->showMessageBox("Upozornenie", QString("Pocet preskocenych hran na neexistujuce uzly: %1").arg(importer.getSkippedEdgeCount()), false);
+        }
+
         // robime zakladnu proceduru pre restartovanie layoutu
         AppCore::Core::getInstance()->restartLayout();
 
@@ -427,15 +203,19 @@ void Manager::GraphManager::runTestCase( qint32 action )
 				}
 			}
 
-			QMap<qlonglong, osg::ref_ptr<Data::Node> >* gNodes = g->getNodes();
+			//addEdge meni store, uzly si preto najprv skopirujeme
+			QList<osg::ref_ptr<Data::Node> > gNodes;
+			for(int i=0;i<g->getNodeStore().size();i++) {
+				gNodes.append(g->getNodeStore().at(i));
+			}
 			osg::ref_ptr<Data::Node> n1;
 			osg::ref_ptr<Data::Node> n2;
 			qlonglong iteration = 0;
-			foreach(qlonglong i, gNodes->keys()) {
+			foreach(osg::ref_ptr<Data::Node> node, gNodes) {
 				if(iteration==0) {
-					n1 = gNodes->value(i);
+					n1 = node;
 				} else {
-					n2 = gNodes->value(i);
+					n2 = node;
 					if(iteration%3==1) {
 						g->addEdge("edge",n1,n2,t5,true);
 					} else if(iteration%3==2) {
@@ -443,16 +223,16 @@ void Manager::GraphManager::runTestCase( qint32 action )
 					} else {
 						g->addEdge("edge",n1,n2,t4,true);
 					}
-					n1 = gNodes->value(i);
+					n1 = node;
 				}
 				iteration++;
 			}
 			n1 = NULL;
 			n2 = NULL;
 
-			qDebug() << "Nodes count: " << g->getNodes()->size();
+			qDebug() << "Nodes count: " << g->getNodeStore().size();
 			qDebug() << "Types count: " << g->getTypes()->size();
-			qDebug() << "Edges count: " << g->getEdges()->size();
+			qDebug() << "Edges count: " << g->getEdgeStore().size();
 
 			switch(action) {
 				case 1: //testovanie remove metod
@@ -463,24 +243,24 @@ void Manager::GraphManager::runTestCase( qint32 action )
 					qDebug() << "type t1 removed";
 
 					qDebug() << "Counts after the type t1 was removed";
-					qDebug() << "Nodes count: " << g->getNodes()->size();
+					qDebug() << "Nodes count: " << g->getNodeStore().size();
 					qDebug() << "Types count: " << g->getTypes()->size();
-					qDebug() << "Edges count: " << g->getEdges()->size();
+					qDebug() << "Edges count: " << g->getEdgeStore().size();
 
 					qDebug() << "Ending testCase 1";
 					break;
 				case 2:
 					qDebug() << "Starting testCase 2";
 
-					osg::ref_ptr<Data::Node> selectedNode = g->getNodes()->values().at(10);
+					osg::ref_ptr<Data::Node> selectedNode = g->getNodeStore().at(10);
 
 					qDebug() << "Removing node: " << selectedNode->toString();
 					g->removeNode(selectedNode);
 
 					qDebug() << "Counts after the type t1 was removed";
-					qDebug() << "Nodes count: " << g->getNodes()->size();
+					qDebug() << "Nodes count: " << g->getNodeStore().size();
 					qDebug() << "Types count: " << g->getTypes()->size();
-					qDebug() << "Edges count: " << g->getEdges()->size();
+					qDebug() << "Edges count: " << g->getEdgeStore().size();
 
 					qDebug() << "Ending testCase 2";
 					break;
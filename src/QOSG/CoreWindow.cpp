@@ -305,13 +305,17 @@ void CoreWindow::addMetaNode()
 
 		while (i != selectedNodes->constEnd()) 
 		{
-			Data::Edge * e = currentGraph->addEdge("metaEdge", (*i), metaNode, currentGraph->getEdgeMetaType(), true);
-			e->setCamera(viewerWidget->getCamera());
+			//kameru nastavi hrane skupina metahran pri synchronizacii
+			currentGraph->addEdge("metaEdge", (*i), metaNode, currentGraph->getEdgeMetaType(), true);
 			++i;
 		}
 
 		if (isPlaying)
-			layout->play();
+		{ // rozmiestni sa len metauzol a okolie vybranych uzlov
+			QLinkedList<osg::ref_ptr<Data::Node> > seeds(*selectedNodes);
+			seeds.append(metaNode);
+			layout->relayoutLocal(seeds);
+		}
 	}
 }
 
@@ -334,16 +338,25 @@ void CoreWindow::removeMetaNodes()
 	Data::Graph * currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
 
 	QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator i = selectedNodes->constBegin();
+	QLinkedList<osg::ref_ptr<Data::Node> > seeds;
 
 	while (i != selectedNodes->constEnd()) 
 	{
 		if ((*i)->getType()->isMeta())
+		{
+			// susedia odstraneneho uzla sa rozmiestnia lokalne
+			QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator e;
+			for (e = (*i)->getEdges()->constBegin(); e != (*i)->getEdges()->constEnd(); ++e)
+			{
+				seeds.append(e.value()->getSrcNode() == (*i) ? e.value()->getDstNode() : e.value()->getSrcNode());
+			}
 			currentGraph->removeNode((*i));
+		}
 		++i;
 	}
 
 	if (isPlaying)
-		layout->play();
+		layout->relayoutLocal(seeds);
 }
 
 void CoreWindow::loadFile()
@@ -19,6 +19,10 @@ Vwr::CoreGraph::CoreGraph(Data::Graph * graph, osg::ref_ptr<osg::Camera> camera)
 	this->qmetaNodes = NULL;
 	this->qmetaEdges = NULL;
 	this->nodesFreezed = false;
+	this->frameSequence = 0;
+	this->editCount = 0;
+	this->settleFrames = -1;
+	this->layoutThread = NULL;
 
 	this->edgesGroup = NULL;
 	this->qmetaEdgesGroup = NULL;
@@ -45,35 +49,28 @@ void CoreGraph::reload(Data::Graph * graph)
 	}
 
 	this->graph = graph;
+	this->settleFrames = -1;
 
 	if (graph != NULL)
 	{
-		this->in_nodes = graph->getNodes();
-		this->in_edges = graph->getEdges();
-		this->qmetaNodes = graph->getMetaNodes();
-		this->qmetaEdges = graph->getMetaEdges();
+		this->in_nodes = &graph->getNodeStore();
+		this->in_edges = &graph->getEdgeStore();
+		this->qmetaNodes = &graph->getMetaNodeStore();
+		this->qmetaEdges = &graph->getMetaEdgeStore();
 	}
 	else
 	{
-		this->in_nodes = new QMap<qlonglong, osg::ref_ptr<Data::Node> >;
-		this->in_edges = new QMap<qlonglong, osg::ref_ptr<Data::Edge> >;
-		this->qmetaNodes = new QMap<qlonglong, osg::ref_ptr<Data::Node> >;
-		this->qmetaEdges = new QMap<qlonglong, osg::ref_ptr<Data::Edge> >;
-	}
-
-	QMapIterator<qlonglong, osg::ref_ptr<Data::Edge> > i(*in_edges);
-
-	while (i.hasNext()) 
-	{
-		i.next();
-		i.value()->setCamera(camera);
+		this->in_nodes = new Data::Graph::NodeStore;
+		this->in_edges = new Data::Graph::EdgeStore;
+		this->qmetaNodes = new Data::Graph::NodeStore;
+		this->qmetaEdges = new Data::Graph::EdgeStore;
 	}
 
 	this->nodesGroup = new Vwr::NodeGroup(in_nodes);
 	root->addChild(nodesGroup->getGroup());
 	nodesPosition = currentPos++;
 
-	this->edgesGroup = new Vwr::EdgeGroup(in_edges, appConf->getValue("Viewer.Textures.EdgeScale").toFloat());
+	this->edgesGroup = new Vwr::EdgeGroup(in_edges, appConf->getValue("Viewer.Textures.EdgeScale").toFloat(), camera);
 	root->addChild(edgesGroup->getGroup());
 	edgesPosition = currentPos++;
 
@@ -81,7 +78,7 @@ void CoreGraph::reload(Data::Graph * graph)
 	root->addChild(qmetaNodesGroup->getGroup());
 	qmetaNodesPosition = currentPos++;
 
-	this->qmetaEdgesGroup = new Vwr::EdgeGroup(qmetaEdges, appConf->getValue("Viewer.Textures.EdgeScale").toFloat());
+	this->qmetaEdgesGroup = new Vwr::EdgeGroup(qmetaEdges, appConf->getValue("Viewer.Textures.EdgeScale").toFloat(), camera);
 	root->addChild(qmetaEdgesGroup->getGroup());
 	qmetaEdgesPosition = currentPos++;
 
@@ -157,12 +154,9 @@ osg::ref_ptr<osg::Group> CoreGraph::initEdgeLabels()
 {
 	osg::ref_ptr<osg::Geode> geode = new osg::Geode;
 
-	QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator i = in_edges->begin();
-
-	while (i != in_edges->end()) 
+	for (int i = 0; i < in_edges->size(); i++) 
 	{
-		geode->addDrawable(i.value()->createLabel(i.value()->getName()));
-		i++;
+		geode->addDrawable(Vwr::EdgeProxy::create(in_edges->at(i).get())->createLabel(in_edges->at(i)->getName()));
 	}
 
 	osg::ref_ptr<osg::Group> labels = new osg::Group;	
@@ -199,21 +193,45 @@ void CoreGraph::update()
 	synchronize();
 
 	float graphScale = appConf->getValue("Viewer.Display.NodeDistanceScale").toFloat();
-	
-	if (!this->nodesFreezed)
+	float interpolationSpeed = appConf->getValue("Viewer.Display.InterpolationSpeed").toFloat();
+
+	if (!this->nodesFreezed && layoutThread != NULL)
 	{
-		float interpolationSpeed = appConf->getValue("Viewer.Display.InterpolationSpeed").toFloat();
-		nodesGroup->updateNodeCoordinates(interpolationSpeed);
-		qmetaNodesGroup->updateNodeCoordinates(interpolationSpeed);
+		// pozicie z poslednej uplnej snimky layoutu, vlakno layoutu uzly nemeni
+		int sequence = layoutThread->applyPositions();
+		int edits = layoutThread->getEditCount();
+		if (sequence != frameSequence || edits != editCount)
+		{
+			frameSequence = sequence;
+			editCount = edits;
+			settleFrames = -1;
+		}
 	}
-	else
+	if (settleFrames < 0)
 	{
-		nodesGroup->updateNodeCoordinates(1);
-		qmetaNodesGroup->updateNodeCoordinates(1);
+		// pocet aktualizacii, po ktorych zostane z posunu interpolaciou menej ako tisicina
+		settleFrames = (interpolationSpeed >= 1 || interpolationSpeed <= 0)
+			? 1 : (int) ceil(log(0.001) / log(1 - interpolationSpeed));
 	}
 
-	edgesGroup->updateEdgeCoords();	
-	qmetaEdgesGroup->updateEdgeCoords();
+	if (this->nodesFreezed || settleFrames > 0)
+	{ // pocas pauzy moze pouzivatel presuvat uzly, inak sa uzly este nepresunuli do cielovych pozicii
+		if (!this->nodesFreezed)
+		{
+			nodesGroup->updateNodeCoordinates(interpolationSpeed);
+			qmetaNodesGroup->updateNodeCoordinates(interpolationSpeed);
+		}
+		else
+		{
+			nodesGroup->updateNodeCoordinates(1);
+			qmetaNodesGroup->updateNodeCoordinates(1);
+		}
+
+		edgesGroup->updateEdgeCoords();	
+		qmetaEdgesGroup->updateEdgeCoords();
+		if (settleFrames > 0)
+			settleFrames--;
+	}
 	root->addChild(initCustomNodes());
 }
 
@@ -230,12 +248,9 @@ void CoreGraph::setEdgeLabelsVisible(bool visible)
 
 void CoreGraph::setNodeLabelsVisible(bool visible)
 {
-	QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator i = in_nodes->constBegin();
-
-	while (i != in_nodes->constEnd()) 
+	for (int i = 0; i < in_nodes->size(); i++) 
 	{
-		(*i)->showLabel(visible);
-		++i;
+		in_nodes->at(i)->showLabel(visible);
 	}
 }
 
@@ -243,12 +258,9 @@ void CoreGraph::reloadConfig()
 {
 	root->setChild(backgroundPosition, createSkyBox());	
 
-	QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator i = in_nodes->constBegin();
-
-	while (i != in_nodes->constEnd()) 
+	for (int i = 0; i < in_nodes->size(); i++) 
 	{
-		(*i)->reloadConfig();
-		++i;
+		in_nodes->at(i)->reloadConfig();
 	}
 
 	root->setChild(labelsPosition, initEdgeLabels());
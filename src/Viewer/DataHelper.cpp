@@ -1,5 +1,8 @@
 #include "Viewer/DataHelper.h"
+#include "Layout/LayoutState.h"
 #include <QLinkedList>
+#include <QSet>
+#include <algorithm>
 
 using namespace Vwr;
 using namespace Data;
@@ -46,6 +49,13 @@ int DataHelper::getRandomNumber(int lowest, int highest)
 	return lowest + int(range * rand() / (RAND_MAX + 1.0));
 }
 
+int DataHelper::getRandomIndex(unsigned int seed, unsigned int position, int count)
+{
+	// 64 bitov z dvoch hodnot generatora, zvysok po deleni je rovnomerny aj pre milion uzlov
+	quint64 value = ((quint64) Layout::LayoutState::hash(seed, 2 * position) << 32) | Layout::LayoutState::hash(seed, 2 * position + 1);
+	return (int) (value % (quint64) count);
+}
+
 osg::ref_ptr<osg::Vec3Array> DataHelper::getEdgeVectors(osg::ref_ptr<Data::Node> inNode, osg::ref_ptr<Data::Node> outNode)
 {
 	osg::ref_ptr<osg::Vec3Array> edgeVectors = new osg::Vec3Array;
@@ -116,74 +126,158 @@ void DataHelper::generatePyramid(std::vector<Data::Node*> *nodes, std::vector<Da
 
 }
 */
-void DataHelper::generateCylinder(QMap<qlonglong, osg::ref_ptr<Data::Node> > *nodes, QMap<qlonglong, osg::ref_ptr<Data::Edge> > *edges,QMap<qlonglong, Data::Type*> *types, int pocetUzlovNaPodstave, int pocetUzlovNaVysku)
+void DataHelper::generateCylinder(Data::Graph *graph, int pocetUzlovNaPodstave, int pocetUzlovNaVysku)
 {
-        int startN = nodes->count();
-        int startE = edges->count();
-
         // budeme pridavat oba typy objektov - hrany aj vrcholy
-        QString tVStr ("vrchol");
-        QString tEStr ("hrana");
-        Data::Type* vType = new Data::Type(1,tVStr,0);
-        Data::Type* eType = new Data::Type(2,tEStr,0);
-        types->insert(1, vType);
-        types->insert(2, eType);
+        Data::Type* vType = graph->addType("vrchol");
+        Data::Type* eType = graph->addType("hrana");
 
         // pridame N uzlov
-        for(int i = startN; i < startN + pocetUzlovNaVysku*pocetUzlovNaPodstave; i++)
+        std::vector<osg::ref_ptr<Data::Node> > nodes(pocetUzlovNaVysku*pocetUzlovNaPodstave);
+        for(int i = 0; i < pocetUzlovNaVysku*pocetUzlovNaPodstave; i++)
         {
-                // ziskame meno uzla
-                std::stringstream out; out << i;
-                // kazdy uzol ma na zaciatku prazdnu mnozinu hran - toto je nejaka blbost FIXME!
-                //QMap<long, Data::Edge*> edges;
-                // vytvorime novy uzol a pridame ho medzi ostatne
-                osg::ref_ptr<Data::Node> node = new Data::Node(i, QString::fromStdString(out.str()), types->value(1), NULL, osg::Vec3f(0,0,0));
-                //std::cout << nodes->capacity();
-                //std::cout << "\n";
-                nodes->insert(i, node);
+                nodes[i] = graph->addNode(QString::number(i), vType);
         }
 
-        // ID hrany
-        int id = startE;
-
-        //std::cout << startN << "," << startE;
-        //std::cout << "\n";
-        //std::cout << pocetUzlovNaPodstave << "," << pocetUzlovNaVysku;
-        //std::cout << "\n";
-
         // pre kazdu podstavu
         for(int j = 0; j < pocetUzlovNaVysku; j++)
         {
             // pridame hrany pre podstavu
             for(int i = 0; i < pocetUzlovNaPodstave; i++)
             {   
-                // ziskame meno hrany
-                std::stringstream out; out << id;
-
+                int from = j*pocetUzlovNaPodstave + i;
                 int to;
                 if(i == (pocetUzlovNaPodstave - 1)){
-                    to = j*pocetUzlovNaPodstave + startN;
+                    to = j*pocetUzlovNaPodstave;
                 } else {
-                    to = j*pocetUzlovNaPodstave + i+1 + startN;
+                    to = j*pocetUzlovNaPodstave + i+1;
                 }
 
-                //std::cout << id << " : " << j << "," << i << " Edge: " << (j*pocetUzlovNaPodstave + i + startN) << " - " << to;
-                //std::cout << "\n";
-
                 // spravime hranu medzi dvoma uzlami podstavy
-				osg::ref_ptr<Data::Edge> edge = new Data::Edge(id, QString::fromStdString(out.str()), NULL, nodes->value(j*pocetUzlovNaPodstave + i + startN), nodes->value(to), types->value(2), getRandomNumber(0,1));
-                edge->linkNodes(edges);
-                id++;
+                graph->addEdge(QString::number(from) + "-" + QString::number(to), nodes[from], nodes[to], eType, getRandomNumber(0,1));
 
                 // ak nejde o spodnu podstavu, tak kazdy vrchol spojime s dalsim ktory je nizsie
                 if(j > 0){
-                    osg::ref_ptr<Data::Edge> edge0 = new Data::Edge(id, QString::fromStdString(out.str()), NULL, nodes->value(j*pocetUzlovNaPodstave + i + startN), nodes->value((j-1)*pocetUzlovNaPodstave + i + startN), types->value(2), true);
-                    edge0->linkNodes(edges);
-                    id++;
+                    int below = (j-1)*pocetUzlovNaPodstave + i;
+                    graph->addEdge(QString::number(from) + "-" + QString::number(below), nodes[from], nodes[below], eType, true);
                 }
             }
         }
 }
+
+void DataHelper::generateGrid(Data::Graph *graph, int width, int height)
+{
+	Data::Type *nodeType = graph->addType("vrchol");
+	Data::Type *edgeType = graph->addType("hrana");
+
+	std::vector<osg::ref_ptr<Data::Node> > grid(width * height);
+	for (int i = 0; i < width * height; i++)
+	{
+		grid[i] = graph->addNode(QString::number(i), nodeType);
+	}
+	// kazdy uzol spojime s pravym a dolnym susedom
+	for (int j = 0; j < height; j++)
+	{
+		for (int i = 0; i < width; i++)
+		{
+			int k = j * width + i;
+			if (i + 1 < width)
+				graph->addEdge(QString::number(k) + "-" + QString::number(k + 1), grid[k], grid[k + 1], edgeType, false);
+			if (j + 1 < height)
+				graph->addEdge(QString::number(k) + "-" + QString::number(k + width), grid[k], grid[k + width], edgeType, false);
+		}
+	}
+}
+
+void DataHelper::generateTree(Data::Graph *graph, int count, int branching)
+{
+	Data::Type *nodeType = graph->addType("vrchol");
+	Data::Type *edgeType = graph->addType("hrana");
+
+	std::vector<osg::ref_ptr<Data::Node> > tree(count);
+	for (int i = 0; i < count; i++)
+	{
+		tree[i] = graph->addNode(QString::number(i), nodeType);
+		if (i > 0)
+		{ // rodic uzla v predchadzajucej urovni
+			int parent = (i - 1) / branching;
+			graph->addEdge(QString::number(parent) + "-" + QString::number(i), tree[parent], tree[i], edgeType, false);
+		}
+	}
+}
+
+void DataHelper::generateErdosRenyi(Data::Graph *graph, int count, float averageDegree, unsigned int seed)
+{
+	Data::Type *nodeType = graph->addType("vrchol");
+	Data::Type *edgeType = graph->addType("hrana");
+
+	std::vector<osg::ref_ptr<Data::Node> > random(count);
+	for (int i = 0; i < count; i++)
+	{
+		random[i] = graph->addNode(QString::number(i), nodeType);
+	}
+	if (count < 2)
+		return;
+
+	qlonglong maxEdges = (qlonglong) count * (count - 1) / 2;
+	qlonglong edgeCount = std::min((qlonglong) (count * (double) averageDegree / 2), maxEdges);
+	QSet<qlonglong> used;
+	unsigned int position = 0;
+	while (used.count() < edgeCount)
+	{
+		int u = getRandomIndex(seed, position++, count);
+		int v = getRandomIndex(seed, position++, count);
+		if (u == v)
+			continue;
+		if (u > v)
+			std::swap(u, v);
+		// hrany sa neopakuju
+		qlonglong key = (qlonglong) u * count + v;
+		if (used.contains(key))
+			continue;
+		used.insert(key);
+		graph->addEdge(QString::number(u) + "-" + QString::number(v), random[u], random[v], edgeType, false);
+	}
+}
+
+void DataHelper::generateBarabasiAlbert(Data::Graph *graph, int count, int edgesPerNode, unsigned int seed)
+{
+	Data::Type *nodeType = graph->addType("vrchol");
+	Data::Type *edgeType = graph->addType("hrana");
+
+	std::vector<osg::ref_ptr<Data::Node> > scaleFree(count);
+	unsigned int position = 0;
+	// koncove uzly vsetkych hran, uzol je v zozname tolkokrat, aky ma stupen
+	std::vector<int> endpoints;
+	int initial = std::min(count, edgesPerNode + 1);
+	for (int i = 0; i < count; i++)
+	{
+		scaleFree[i] = graph->addNode(QString::number(i), nodeType);
+		std::vector<int> targets;
+		if (i < initial)
+		{ // pociatocne uzly tvoria uplny graf
+			for (int j = 0; j < i; j++)
+				targets.push_back(j);
+		}
+		else
+		{ // novy uzol sa pripaja k uzlom umerne ich stupnu
+			while ((int) targets.size() < edgesPerNode)
+			{
+				int j = endpoints[getRandomIndex(seed, position++, (int) endpoints.size())];
+				if (std::find(targets.begin(), targets.end(), j) == targets.end())
+					targets.push_back(j);
+			}
+		}
+		for (size_t k = 0; k < targets.size(); k++)
+		{
+			int j = targets[k];
+			graph->addEdge(QString::number(j) + "-" + QString::number(i), scaleFree[j], scaleFree[i], edgeType, false);
+			endpoints.push_back(i);
+			endpoints.push_back(j);
+		}
+	}
+}
+
 /*
 void DataHelper::generateCube2(std::vector<Data::Node*> *nodes, std::vector<Data::Edge*> *edges,std::vector<Data::Type*> *types)
 {
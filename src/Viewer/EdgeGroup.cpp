@@ -2,10 +2,11 @@
 
 using namespace Vwr;
 
-EdgeGroup::EdgeGroup(QMap<qlonglong, osg::ref_ptr<Data::Edge> > *edges, float scale)
+EdgeGroup::EdgeGroup(const Data::Graph::EdgeStore *edges, float scale, osg::ref_ptr<osg::Camera> camera)
 {
 	this->edges = edges;
 	this->scale = scale;
+	this->camera = camera;
 
 	createEdgeStateSets();
 	initEdges();
@@ -39,21 +40,19 @@ void EdgeGroup::initEdges()
 	geometry = new osg::Geometry;
 	orientedGeometry = new osg::Geometry;
 
-    QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator i = edges->begin();
-
 	int edgePos = 0;
 
-	while (i != edges->end()) 
+	for (int i = 0; i < edges->size(); i++) 
 	{
-		getEdgeCoordinatesAndColors(i.value(), edgePos, coordinates, edgeTexCoords, colors, orientedEdgeColors);
+		Data::Edge * edge = edges->at(i).get();
+
+		getEdgeCoordinatesAndColors(edge, edgePos, coordinates, edgeTexCoords, colors, orientedEdgeColors);
 		edgePos += 4;
 
-		if (i.value()->isOriented())
-			orientedGeometry->addPrimitiveSet(i.value());
+		if (edge->isOriented())
+			orientedGeometry->addPrimitiveSet(Vwr::EdgeProxy::get(edge));
 		else
-			geometry->addPrimitiveSet(i.value());
-
-		i++;
+			geometry->addPrimitiveSet(Vwr::EdgeProxy::get(edge));
 	}
 
 	geometry->setTexCoordArray(0, edgeTexCoords);
@@ -87,15 +86,12 @@ void EdgeGroup::updateEdgeCoords()
 	osg::ref_ptr<osg::Vec4Array> colors = new osg::Vec4Array;
 	osg::ref_ptr<osg::Vec4Array> orientedEdgeColors = new osg::Vec4Array;
 
-	QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator i = edges->begin();
-
 	int edgePos = 0;
 
-	while (i != edges->end()) 
+	for (int i = 0; i < edges->size(); i++) 
 	{
-		getEdgeCoordinatesAndColors(i.value(), edgePos, coordinates, edgeTexCoords, colors, orientedEdgeColors);
+		getEdgeCoordinatesAndColors(edges->at(i).get(), edgePos, coordinates, edgeTexCoords, colors, orientedEdgeColors);
 		edgePos += 4;
-		i++;
 	}
 
 	geometry->setVertexArray(coordinates);
@@ -107,7 +103,7 @@ void EdgeGroup::updateEdgeCoords()
 	orientedGeometry->setColorArray(orientedEdgeColors);
 }
 
-void EdgeGroup::getEdgeCoordinatesAndColors(osg::ref_ptr<Data::Edge> edge, int first, 
+void EdgeGroup::getEdgeCoordinatesAndColors(Data::Edge * edge, int first, 
 											osg::ref_ptr<osg::Vec3Array> coordinates, 
 											osg::ref_ptr<osg::Vec2Array> edgeTexCoords,
 											osg::ref_ptr<osg::Vec4Array> colors,
@@ -116,18 +112,20 @@ void EdgeGroup::getEdgeCoordinatesAndColors(osg::ref_ptr<Data::Edge> edge, int f
 	osg::Vec3 srcNodePosition = edge->getSrcNode()->getCurrentPosition();
 	osg::Vec3 dstNodePosition = edge->getDstNode()->getCurrentPosition();
 
-	edge->updateCoordinates(srcNodePosition, dstNodePosition);
-	edge->setFirst(first);
+	Vwr::EdgeProxy * proxy = wrapEdge(edge);
+
+	proxy->updateCoordinates(srcNodePosition, dstNodePosition);
+	proxy->setFirst(first);
 
-	coordinates->push_back(edge->getCooridnates()->at(0));
-	coordinates->push_back(edge->getCooridnates()->at(1));
-	coordinates->push_back(edge->getCooridnates()->at(2));
-	coordinates->push_back(edge->getCooridnates()->at(3));
+	coordinates->push_back(proxy->getCoordinates()->at(0));
+	coordinates->push_back(proxy->getCoordinates()->at(1));
+	coordinates->push_back(proxy->getCoordinates()->at(2));
+	coordinates->push_back(proxy->getCoordinates()->at(3));
 
-	edgeTexCoords->push_back(edge->getEdgeTexCoords()->at(0));
-	edgeTexCoords->push_back(edge->getEdgeTexCoords()->at(1));
-	edgeTexCoords->push_back(edge->getEdgeTexCoords()->at(2));
-	edgeTexCoords->push_back(edge->getEdgeTexCoords()->at(3));
+	edgeTexCoords->push_back(proxy->getEdgeTexCoords()->at(0));
+	edgeTexCoords->push_back(proxy->getEdgeTexCoords()->at(1));
+	edgeTexCoords->push_back(proxy->getEdgeTexCoords()->at(2));
+	edgeTexCoords->push_back(proxy->getEdgeTexCoords()->at(3));
 
 	if (edge->isOriented())
 		orientedEdgeColors->push_back(edge->getEdgeColor());
@@ -137,7 +135,10 @@ void EdgeGroup::getEdgeCoordinatesAndColors(osg::ref_ptr<Data::Edge> edge, int f
 
 void EdgeGroup::synchronizeEdges()
 {
-	QList<qlonglong> edgeKeys = edges->keys();
+	QSet<qlonglong> edgeKeys;
+
+	for (int i = 0; i < edges->size(); i++)
+		edgeKeys.insert(edges->at(i)->getId());
 
 	for (int i = 0; i < 2; i++)
 	{
@@ -146,28 +147,51 @@ void EdgeGroup::synchronizeEdges()
 
 		for (unsigned int x = 0; x < primitives.size() ; x++)
 		{
-			Data::Edge * e = dynamic_cast<Data::Edge * >(primitives.at(x).get());
+			Vwr::EdgeProxy * e = dynamic_cast<Vwr::EdgeProxy * >(primitives.at(x).get());
 
-			if (!edgeKeys.contains(e->getId()))
+			if (e->getEdge() == NULL || !edgeKeys.contains(e->getEdge()->getId()))
 			{
 				geometry->removePrimitiveSet(geometry->getPrimitiveSetIndex((e)));
 			}
 		}
 	}
 
-	QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator ie = edges->begin();
+	for (int i = 0; i < edges->size(); i++) 
+	{
+		const osg::ref_ptr<Data::Edge> &edge = edges->at(i);
+		Vwr::EdgeProxy * proxy = wrapEdge(edge.get());
 
-	while (ie != edges->end()) 
+		if (!edge->isOriented() && geometry->getPrimitiveSetIndex(proxy) == geometry->getNumPrimitiveSets())
+			geometry->addPrimitiveSet(proxy);
+		else if (edge->isOriented() && orientedGeometry->getPrimitiveSetIndex(proxy) == orientedGeometry->getNumPrimitiveSets())
+			orientedGeometry->addPrimitiveSet(proxy);
+	}
+}
+
+void EdgeGroup::setCamera(osg::ref_ptr<osg::Camera> camera)
+{
+	this->camera = camera;
+
+	for (int i = 0; i < edges->size(); i++)
 	{
-		if (!(*ie)->isOriented() && geometry->getPrimitiveSetIndex((*ie)) == geometry->getNumPrimitiveSets())
-			geometry->addPrimitiveSet(*ie);
-		else if ((*ie)->isOriented() && orientedGeometry->getPrimitiveSetIndex((*ie)) == orientedGeometry->getNumPrimitiveSets())
-			orientedGeometry->addPrimitiveSet(*ie);
+		Vwr::EdgeProxy * proxy = Vwr::EdgeProxy::get(edges->at(i).get());
 
-		ie++;
+		if (proxy != NULL)
+			proxy->setCamera(camera);
 	}
 }
 
+Vwr::EdgeProxy * EdgeGroup::wrapEdge(Data::Edge * edge)
+{
+	Vwr::EdgeProxy * proxy = Vwr::EdgeProxy::create(edge);
+
+	//proxy mohla vytvorit skupina predchadzajuceho nacitania grafu
+	if (proxy->getCamera() != camera)
+		proxy->setCamera(camera);
+
+	return proxy;
+}
+
 void EdgeGroup::createEdgeStateSets()
 {
 	edgeStateSet = new osg::StateSet;
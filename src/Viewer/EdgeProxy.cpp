@@ -0,0 +1,101 @@
+/*!
+ * EdgeProxy.cpp
+ * Projekt 3DVisual
+ */
+#include "Viewer/EdgeProxy.h"
+#include "Data/Edge.h"
+
+Vwr::EdgeProxy::EdgeProxy(Data::Edge * edge) : osg::DrawArrays(osg::PrimitiveSet::QUADS, 0, 4)
+{
+	this->edge = edge;
+	this->appConf = Util::ApplicationConfig::get();
+
+	coordinates = new osg::Vec3Array();
+	edgeTexCoords = new osg::Vec2Array();
+}
+
+Vwr::EdgeProxy * Vwr::EdgeProxy::create(Data::Edge * edge)
+{
+	EdgeProxy * proxy = get(edge);
+
+	if (proxy == NULL)
+	{
+		proxy = new EdgeProxy(edge);
+		edge->setProxy(proxy);
+	}
+
+	return proxy;
+}
+
+void Vwr::EdgeProxy::updateCoordinates(osg::Vec3 srcPos, osg::Vec3 dstPos)
+{
+	coordinates->clear();
+	edgeTexCoords->clear();
+
+	osg::Vec3d viewVec(0, 0, 1);
+	osg::Vec3d up;
+
+	if (camera != 0)
+	{
+		osg::Vec3d eye;
+		osg::Vec3d center;
+
+		camera->getViewMatrixAsLookAt(eye,center,up);
+
+		viewVec = eye - center;
+	}
+
+	viewVec.normalize();
+
+	osg::Vec3 x, y;
+	x.set(srcPos);
+	y.set(dstPos);
+
+	osg::Vec3d edgeDir = x - y;
+	float length = edgeDir.length();
+
+	up = edgeDir ^ viewVec;
+	up.normalize();
+
+	up *= appConf->getValue("Viewer.Textures.EdgeScale").toFloat();
+
+	coordinates->push_back(osg::Vec3(x.x() + up.x(), x.y() + up.y(), x.z() + up.z()));
+	coordinates->push_back(osg::Vec3(x.x() - up.x(), x.y() - up.y(), x.z() - up.z()));
+	coordinates->push_back(osg::Vec3(y.x() - up.x(), y.y() - up.y(), y.z() - up.z()));
+	coordinates->push_back(osg::Vec3(y.x() + up.x(), y.y() + up.y(), y.z() + up.z()));
+
+	int repeatCnt = length / (2 * appConf->getValue("Viewer.Textures.EdgeScale").toFloat());
+
+	edgeTexCoords->push_back(osg::Vec2(0,1.0f));
+	edgeTexCoords->push_back(osg::Vec2(0,0.0f));
+	edgeTexCoords->push_back(osg::Vec2(repeatCnt,0.0f));
+	edgeTexCoords->push_back(osg::Vec2(repeatCnt,1.0f));
+
+	if (label != NULL)
+		label->setPosition((srcPos + dstPos) / 2 );
+}
+
+osg::ref_ptr<osg::Drawable> Vwr::EdgeProxy::createLabel(QString name)
+{
+	label = new osgText::FadeText;
+	label->setFadeSpeed(0.03);
+
+	QString fontPath = Util::ApplicationConfig::get()->getValue("Viewer.Labels.Font");
+
+	// experimental value
+	float scale = 1.375f * edge->getType()->getScale();
+
+	if(fontPath != NULL && !fontPath.isEmpty())
+		label->setFont(fontPath.toStdString());
+
+	label->setText(name.toStdString());
+	label->setLineSpacing(0);
+	label->setAxisAlignment(osgText::Text::SCREEN);
+	label->setCharacterSize(scale);
+	label->setDrawMode(osgText::Text::TEXT);
+	label->setAlignment(osgText::Text::CENTER_BOTTOM_BASE_LINE);
+	label->setPosition((edge->getDstNode()->getTargetPosition() + edge->getSrcNode()->getTargetPosition()) / 2 );
+	label->setColor( osg::Vec4(1.0f, 1.0f, 1.0f, 1.0f) );
+
+	return label;
+}
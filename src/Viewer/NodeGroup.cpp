@@ -2,7 +2,7 @@
 
 using namespace Vwr;
 
-NodeGroup::NodeGroup(QMap<qlonglong, osg::ref_ptr<Data::Node> > *nodes)
+NodeGroup::NodeGroup(const Data::Graph::NodeStore *nodes)
 {
 	this->nodes = nodes;
 	this->appConf = Util::ApplicationConfig::get();
@@ -36,13 +36,9 @@ void NodeGroup::initNodes()
 
 	float graphScale = appConf->getValue("Viewer.Display.NodeDistanceScale").toFloat(); 
 	
-	QMapIterator<qlonglong, osg::ref_ptr<Data::Node> > i(*nodes);
-	
-	while (i.hasNext()) 
+	for (int i = 0; i < nodes->size(); i++) 
 	{
-		i.next();
-			
-		osg::ref_ptr<osg::Group> g = getNodeGroup(i.value(), NULL, graphScale);
+		osg::ref_ptr<osg::Group> g = getNodeGroup(nodes->at(i), NULL, graphScale);
 
 		if (g != NULL)
 			nodeGroup->addChild(g);
@@ -92,7 +88,7 @@ osg::ref_ptr<osg::AutoTransform> NodeGroup::wrapChild(osg::ref_ptr<Data::Node> n
 	osg::ref_ptr<osg::AutoTransform> at = new osg::AutoTransform;
 	at->setPosition(node->getTargetPosition() * graphScale);
 	at->setAutoRotateMode(osg::AutoTransform::ROTATE_TO_SCREEN);
-	at->addChild(node);
+	at->addChild(Vwr::NodeProxy::create(node.get()));
 
 	nodeTransforms->insert(node->getId(), at);
 
@@ -101,10 +97,12 @@ osg::ref_ptr<osg::AutoTransform> NodeGroup::wrapChild(osg::ref_ptr<Data::Node> n
 
 void NodeGroup::synchronizeNodes()
 {
-	QList<qlonglong> nodeKeys = nodes->keys();
+	QSet<qlonglong> nodeKeys;
+
+	for (int j = 0; j < nodes->size(); j++)
+		nodeKeys.insert(nodes->at(j)->getId());
 
-	QList<qlonglong> nodeTransformsKeys = nodeTransforms->keys();
-	QSet<qlonglong> result = nodeTransformsKeys.toSet().subtract(nodeKeys.toSet());
+	QSet<qlonglong> result = nodeTransforms->keys().toSet().subtract(nodeKeys);
 
 	QSet<qlonglong>::const_iterator i = result.constBegin();
 
@@ -116,26 +114,21 @@ void NodeGroup::synchronizeNodes()
 		++i;
 	}
 
-	result = nodeKeys.toSet().subtract(nodeTransformsKeys.toSet());
-	i = result.constBegin();
-
 	float graphScale = appConf->getValue("Viewer.Display.NodeDistanceScale").toFloat(); 
 
-	while (i != result.constEnd()) 
+	for (int j = 0; j < nodes->size(); j++) 
 	{
-		group->addChild(wrapChild(nodes->value(*i), graphScale));
-		++i;
+		if (!nodeTransforms->contains(nodes->at(j)->getId()))
+			group->addChild(wrapChild(nodes->at(j), graphScale));
 	}
 }
 
 void NodeGroup::updateNodeCoordinates(float interpolationSpeed)
 {
-	QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator i = nodes->constBegin();
-
-	while (i != nodes->constEnd()) 
+	for (int i = 0; i < nodes->size(); i++) 
 	{
-		nodeTransforms->value(i.key())->setPosition((*i)->getCurrentPosition(true, interpolationSpeed));
-		++i;
+		const osg::ref_ptr<Data::Node> &node = nodes->at(i);
+		nodeTransforms->value(node->getId())->setPosition(node->getCurrentPosition(true, interpolationSpeed));
 	}
 }
 
@@ -143,11 +136,8 @@ void NodeGroup::freezeNodePositions()
 { 
 	float graphScale = appConf->getValue("Viewer.Display.NodeDistanceScale").toFloat();
 
-	QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator i = nodes->constBegin();
-
-	while (i != nodes->constEnd()) 
+	for (int i = 0; i < nodes->size(); i++) 
 	{
-		(*i)->setTargetPosition((*i)->getCurrentPosition() / graphScale);
-		++i;
+		nodes->at(i)->setTargetPosition(nodes->at(i)->getCurrentPosition() / graphScale);
 	}
 }
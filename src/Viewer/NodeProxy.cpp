@@ -0,0 +1,259 @@
+/*!
+ * NodeProxy.cpp
+ * Projekt 3DVisual
+ */
+#include "Viewer/NodeProxy.h"
+#include "Data/Node.h"
+#include "Util/ApplicationConfig.h"
+#include "Viewer/TextureWrapper.h"
+
+#include <osgText/FadeText>
+
+typedef osg::TemplateIndexArray<unsigned int, osg::Array::UIntArrayType,4,1> ColorIndexArray;
+
+Vwr::NodeProxy::NodeProxy(Data::Node * node)
+{
+	this->node = node;
+
+	int pos = 0;
+	int cnt = 0;
+
+	labelText = node->getName();
+
+	while ((pos = labelText.indexOf(QString(" "), pos + 1)) != -1)
+	{
+		if (++cnt % 3 == 0)
+			labelText = labelText.replace(pos, 1, "\n");
+	}
+
+	this->addDrawable(createNode(node->getType()->getScale(), NodeProxy::createStateSet(node->getType())));
+
+	this->square = createSquare(node->getType()->getScale(), NodeProxy::createStateSet());
+	this->label = createLabel(node->getType()->getScale(), labelText);
+
+	//stav uzla nastaveny pred vytvorenim proxy
+	setColor(node->isSelected() ? osg::Vec4(0.0f, 0.0f, 0.0f, 1.0f) : node->getColor());
+	setFixed(node->isFixed());
+	showLabel(node->isLabelVisible());
+}
+
+Vwr::NodeProxy * Vwr::NodeProxy::create(Data::Node * node)
+{
+	NodeProxy * proxy = get(node);
+
+	if (proxy == NULL)
+	{
+		proxy = new NodeProxy(node);
+		node->setProxy(proxy);
+	}
+
+	return proxy;
+}
+
+void Vwr::NodeProxy::setColor(osg::Vec4 color)
+{
+	setDrawableColor(0, color);
+}
+
+void Vwr::NodeProxy::setFixed(bool fixed)
+{
+	if (fixed && !this->containsDrawable(square))
+		this->addDrawable(square);
+	else if (!fixed)
+		this->removeDrawable(square);
+}
+
+/*!
+ *
+ * \param scale
+ * Koeficient velkosti uzlov.
+ *
+ * \param bbState
+ * Zoznam stavov pre dany uzol.
+ *
+ * \returns
+ * Uzol.
+ *
+ *
+ * Vytvori konkretny uzol a priradi mu stav.
+ *
+ */
+osg::ref_ptr<osg::Drawable> Vwr::NodeProxy::createNode(const float & scale, osg::StateSet* bbState)
+{
+	float width = 2.0f;
+	float height = 2.0f;
+
+	width *= scale;
+	height *= scale;
+
+	osg::ref_ptr<osg::Geometry> nodeQuad = new osg::Geometry;
+	osg::ref_ptr<osg::Vec3Array> nodeVerts = new osg::Vec3Array(4);
+
+	(*nodeVerts)[0] = osg::Vec3(-width / 2.0f, -height / 2.0f, 0);
+	(*nodeVerts)[1] = osg::Vec3( width / 2.0f, -height / 2.0f, 0);
+	(*nodeVerts)[2] = osg::Vec3( width / 2.0f,	height / 2.0f, 0);
+	(*nodeVerts)[3] = osg::Vec3(-width / 2.0f,  height / 2.0f, 0);
+
+	nodeQuad->setUseDisplayList(false);
+
+	nodeQuad->setVertexArray(nodeVerts);
+	nodeQuad->addPrimitiveSet(new osg::DrawArrays(osg::PrimitiveSet::QUADS,0,4));
+
+	osg::ref_ptr<osg::Vec2Array> nodeTexCoords = new osg::Vec2Array(4);
+	(*nodeTexCoords)[0].set(0.0f,0.0f);
+	(*nodeTexCoords)[1].set(1.0f,0.0f);
+	(*nodeTexCoords)[2].set(1.0f,1.0f);
+	(*nodeTexCoords)[3].set(0.0f,1.0f);
+
+	nodeQuad->setTexCoordArray(0, nodeTexCoords);
+
+	osg::ref_ptr<osg::Vec4Array> colorArray = new osg::Vec4Array;
+	colorArray->push_back(osg::Vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+	osg::ref_ptr<ColorIndexArray> colorIndexArray = new osg::TemplateIndexArray<unsigned int, osg::Array::UIntArrayType, 4, 1>;
+	colorIndexArray->push_back(0);
+
+	nodeQuad->setColorArray( colorArray);
+	nodeQuad->setColorIndices(colorIndexArray);
+	nodeQuad->setColorBinding(osg::Geometry::BIND_OVERALL);
+	nodeQuad->setStateSet(bbState);
+
+	return nodeQuad;
+}
+
+osg::ref_ptr<osg::Drawable> Vwr::NodeProxy::createSquare(const float & scale, osg::StateSet* bbState)
+{
+	float width = 2.0f;
+	float height = 2.0f;
+
+	width *= scale;
+	height *= scale;
+
+	osg::ref_ptr<osg::Geometry> nodeRect = new osg::Geometry;
+	osg::ref_ptr<osg::Vec3Array> nodeVerts = new osg::Vec3Array(5);
+
+	(*nodeVerts)[0] = osg::Vec3(-width / 2.0f, -height / 2.0f, 0);
+	(*nodeVerts)[1] = osg::Vec3( width / 2.0f, -height / 2.0f, 0);
+	(*nodeVerts)[2] = osg::Vec3( width / 2.0f,	height / 2.0f, 0);
+	(*nodeVerts)[3] = osg::Vec3(-width / 2.0f,  height / 2.0f, 0);
+	(*nodeVerts)[4] = osg::Vec3(-width / 2.0f, -height / 2.0f, 0);
+
+	nodeRect->setVertexArray(nodeVerts);
+	nodeRect->addPrimitiveSet(new osg::DrawArrays(osg::PrimitiveSet::LINE_STRIP,0,5));
+
+	osg::ref_ptr<ColorIndexArray> colorIndexArray = new osg::TemplateIndexArray<unsigned int, osg::Array::UIntArrayType, 4, 1>;
+	colorIndexArray->push_back(0);
+
+	osg::ref_ptr<osg::Vec4Array> colorArray = new osg::Vec4Array;
+	colorArray->push_back(osg::Vec4(1.0f, 0.0f, 0.0f, 0.5f));
+
+	nodeRect->setColorArray(colorArray);
+	nodeRect->setColorIndices(colorIndexArray);
+
+	nodeRect->setColorArray( colorArray);
+	nodeRect->setColorBinding(osg::Geometry::BIND_OVERALL);
+
+	nodeRect->setStateSet(bbState);
+
+	return nodeRect;
+}
+
+osg::ref_ptr<osg::Drawable> Vwr::NodeProxy::createLabel(const float & scale, QString name)
+{
+	osg::ref_ptr<osgText::FadeText> label = new osgText::FadeText;
+	label->setFadeSpeed(0.03);
+
+	QString fontPath = Util::ApplicationConfig::get()->getValue("Viewer.Labels.Font");
+
+	// experimental value
+	float newScale = 1.375f * scale;
+
+	if(fontPath != NULL && !fontPath.isEmpty())
+		label->setFont(fontPath.toStdString());
+
+	label->setText(name.toStdString());
+	label->setLineSpacing(0);
+	label->setAxisAlignment(osgText::Text::SCREEN);
+	label->setCharacterSize(newScale);
+	label->setDrawMode(osgText::Text::TEXT);
+	label->setAlignment(osgText::Text::CENTER_BOTTOM_BASE_LINE);
+	label->setPosition( osg::Vec3(0, newScale, 0) );
+	label->setColor( osg::Vec4(1.0f, 1.0f, 1.0f, 1.0f) );
+
+	return label;
+}
+
+osg::ref_ptr<osg::StateSet> Vwr::NodeProxy::createStateSet(Data::Type * type)
+{
+	osg::ref_ptr<osg::StateSet> stateSet = new osg::StateSet;
+
+	stateSet->setDataVariance(osg::Object::DYNAMIC);
+	stateSet->setMode(GL_LIGHTING, osg::StateAttribute::OFF);
+
+	if(type != 0)
+		stateSet->setTextureAttributeAndModes(0, type->getTypeTexture(), osg::StateAttribute::ON);
+
+	stateSet->setMode(GL_BLEND, osg::StateAttribute::ON);
+	stateSet->setMode(GL_DEPTH_TEST, osg::StateAttribute::OFF);
+
+	stateSet->setRenderingHint(osg::StateSet::TRANSPARENT_BIN);
+
+ 	osg::ref_ptr<osg::Depth> depth = new osg::Depth;
+ 	depth->setWriteMask(false);
+ 	stateSet->setAttributeAndModes(depth, osg::StateAttribute::ON);
+
+	osg::ref_ptr<osg::CullFace> cull = new osg::CullFace();
+	cull->setMode(osg::CullFace::BACK);
+	stateSet->setAttributeAndModes(cull, osg::StateAttribute::ON);
+
+	return stateSet;
+}
+
+void Vwr::NodeProxy::setDrawableColor(int pos, osg::Vec4 color)
+{
+	if (pos >= (int) this->getNumDrawables())
+		return;
+
+	osg::Geometry * geometry  = dynamic_cast<osg::Geometry *>(this->getDrawable(pos));
+
+	if (geometry != NULL)
+	{
+		osg::Vec4Array * colorArray =  dynamic_cast<osg::Vec4Array *>(geometry->getColorArray());
+
+		colorArray->pop_back();
+		colorArray->push_back(color);
+	}
+}
+
+void Vwr::NodeProxy::showLabel(bool visible)
+{
+	if (visible && !this->containsDrawable(label))
+		this->addDrawable(label);
+	else if (!visible)
+		this->removeDrawable(label);
+}
+
+void Vwr::NodeProxy::reloadConfig()
+{
+	if (node == NULL)
+		return;
+
+	this->setDrawable(0, createNode(node->getType()->getScale(), NodeProxy::createStateSet(node->getType())));
+	setColor(node->isSelected() ? osg::Vec4(0.0f, 0.0f, 0.0f, 1.0f) : node->getColor());
+
+	osg::ref_ptr<osg::Drawable> newRect = createSquare(node->getType()->getScale(), NodeProxy::createStateSet());
+	osg::ref_ptr<osg::Drawable> newLabel = createLabel(node->getType()->getScale(), labelText);
+
+	if (this->containsDrawable(label))
+	{
+		this->setDrawable(this->getDrawableIndex(label), newLabel);
+	}
+
+	if (this->containsDrawable(square))
+	{
+		this->setDrawable(this->getDrawableIndex(square), newRect);
+	}
+
+	label = newLabel;
+	square = newRect;
+}
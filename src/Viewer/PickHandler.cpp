@@ -365,7 +365,8 @@ bool PickHandler::doSinglePick(osg::NodePath nodePath, unsigned int primitiveInd
 
 bool PickHandler::doNodePick(osg::NodePath nodePath)
 {
-	Data::Node * n = dynamic_cast<Data::Node *>(nodePath[nodePath.size() - 1]);
+	Vwr::NodeProxy * proxy = dynamic_cast<Vwr::NodeProxy *>(nodePath[nodePath.size() - 1]);
+	Data::Node * n = (proxy != NULL ? proxy->getNode() : NULL);
 
 	if (n != NULL)
 	{
@@ -404,13 +405,14 @@ bool PickHandler::doEdgePick(osg::NodePath nodePath, unsigned int primitiveIndex
 
 		if (geometry != NULL)
 		{
-			Data::Edge * e = dynamic_cast<Data::Edge *>(geometry->getPrimitiveSet(primitiveIndex));
+			Vwr::EdgeProxy * proxy = dynamic_cast<Vwr::EdgeProxy *>(geometry->getPrimitiveSet(primitiveIndex));
+			Data::Edge * e = (proxy != NULL ? proxy->getEdge() : NULL);
 
 			if (e != NULL)
 			{
 				if (isAltPressed && pickMode == PickMode::NONE)
 				{
-					osg::ref_ptr<osg::Vec3Array> coords = e->getCooridnates();
+					osg::ref_ptr<osg::Vec3Array> coords = proxy->getCoordinates();
 
 					cameraManipulator->setCenter(DataHelper::getMassCenter(coords));
 					cameraManipulator->setDistance(Util::ApplicationConfig::get()->getValue("Viewer.PickHandler.PickedEdgeDistance").toFloat());
@@ -462,7 +464,9 @@ bool PickHandler::dragNode(osgViewer::Viewer * viewer)
 	origin_mX = _mX;
 	origin_mY = _mY;
 
-        AppCore::Core::getInstance()->getLayoutThread()->wakeUp();
+	// posunute uzly a ich okolie sa rozmiestnia lokalne, zvysok grafu ostava
+	AppCore::Core::getInstance()->getLayoutThread()->postEdits(pickedNodes);
+	AppCore::Core::getInstance()->getLayoutThread()->relayoutLocal(pickedNodes);
 
 	return (pickedNodes.size() > 0);
 }
@@ -529,6 +533,9 @@ void PickHandler::toggleSelectedNodesFixedState(bool isFixed)
 		(*i)->setFixed(isFixed);
 		++i;
 	}
+
+	AppCore::Core::getInstance()->getLayoutThread()->postEdits(pickedNodes);
+	AppCore::Core::getInstance()->getLayoutThread()->wakeUp();
 }
 
 void PickHandler::unselectPickedNodes(osg::ref_ptr<Data::Node> node)
@@ -584,7 +591,10 @@ osg::Vec3 PickHandler::getSelectionCenter(bool nodesOnly)
 
 		while (ei != pickedEdges.constEnd()) 
 		{
-			coordinates->push_back(DataHelper::getMassCenter((*ei)->getCooridnates()));
+			Vwr::EdgeProxy * proxy = Vwr::EdgeProxy::get((*ei).get());
+
+			if (proxy != NULL)
+				coordinates->push_back(DataHelper::getMassCenter(proxy->getCoordinates()));
 			++ei;
 		}
 	}
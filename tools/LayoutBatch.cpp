@@ -0,0 +1,162 @@
+/**
+*  LayoutBatch.cpp
+*  Projekt 3DVisual
+*
+*  Headless batch layout: reads GraphML files, runs layout without window, GL context and database
+*  and writes positions of nodes as CSV (GraphML id, x, y, z), optionally measurements of iterations as second CSV.
+*
+*  Pouzitie: 3DVisualBatch [--engine auto|fr|multilevel|spectral|pivotmds|pivotmds-fr|cone|igraph] [--iterations N] [--time MS] [--unbounded] [--output-dir DIR] [--telemetry] subor.graphml ...
+*
+*  Layout jedneho grafu je predvolene obmedzeny DEFAULT_ITERATIONS iteraciami a DEFAULT_MILLISECONDS ms, graf, ktory sa neustali,
+*  tak davku nezastavi. Beh do ustalenia treba zapnut explicitne (--unbounded alebo 0 v --iterations a --time).
+*
+*  Nastavenia sa citaju z config/config v aktualnom adresari, sily sa pocitaju na vsetkych jadrach (Layout.FR.ThreadCount=0).
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QTextStream>
+#include <QTime>
+
+#include "Data/Graph.h"
+#include "Layout/LayoutEngine.h"
+#include "Manager/GraphMLImporter.h"
+#include "Util/ApplicationConfig.h"
+
+namespace
+{
+	/* predvolene parametre layoutu, rovnake ako v AppCore::Core::restartLayout */
+	const float SIZE_FACTOR = 10;
+	const float FLEXIBILITY = 0.7f;
+	/* pocet iteracii v CSV telemetrie, ak pocet iteracii nie je obmedzeny */
+	const int TELEMETRY_CAPACITY = 100000;
+	/* predvoleny rozpocet layoutu jedneho grafu */
+	const int DEFAULT_ITERATIONS = 2000;
+	const int DEFAULT_MILLISECONDS = 600000;
+
+	void usage()
+	{
+		fprintf(stderr, "Pouzitie: 3DVisualBatch [--engine auto|fr|multilevel|spectral|pivotmds|pivotmds-fr|cone|igraph] [--iterations N] [--time MS] [--unbounded] [--output-dir DIR] [--telemetry] subor.graphml ...\n");
+		fprintf(stderr, "  --engine      engine rozmiestnenia, predvolene Layout.Engine z konfiguracie\n");
+		fprintf(stderr, "  --iterations  maximalny pocet iteracii, predvolene %d, 0 = bez obmedzenia\n", DEFAULT_ITERATIONS);
+		fprintf(stderr, "  --time        maximalny cas layoutu jedneho grafu v ms, predvolene %d, 0 = bez obmedzenia\n", DEFAULT_MILLISECONDS);
+		fprintf(stderr, "  --unbounded   layout bezi az do ustalenia, rovnake ako --iterations 0 --time 0\n");
+		fprintf(stderr, "  --output-dir  adresar pre vystupne CSV, predvolene adresar vstupneho suboru\n");
+		fprintf(stderr, "  --telemetry   zapise aj casy faz, energiu a posuny kazdej iteracie do subor.telemetry.csv\n");
+	}
+
+	/* zapise pozicie uzlov, id je povodne id z GraphML */
+	bool writePositions(const QString &path, const QMap<QString, osg::ref_ptr<Data::Node> > &nodes)
+	{
+		QFile file(path);
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+			return false;
+		QTextStream out(&file);
+		out << "id,x,y,z\n";
+		QMap<QString, osg::ref_ptr<Data::Node> >::const_iterator i;
+		for (i = nodes.constBegin(); i != nodes.constEnd(); ++i)
+		{
+			osg::Vec3f p = i.value()->getTargetPosition();
+			out << i.key() << "," << p.x() << "," << p.y() << "," << p.z() << "\n";
+		}
+		return true;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	QString engine = Util::ApplicationConfig::get()->getValue("Layout.Engine");
+	int maxIterations = DEFAULT_ITERATIONS;
+	int maxMilliseconds = DEFAULT_MILLISECONDS;
+	QString outputDir;
+	bool writeTelemetry = false;
+	QStringList inputs;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc)
+			engine = argv[++i];
+		else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+			maxIterations = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--time") == 0 && i + 1 < argc)
+			maxMilliseconds = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--unbounded") == 0)
+			maxIterations = maxMilliseconds = 0;
+		else if (strcmp(argv[i], "--output-dir") == 0 && i + 1 < argc)
+			outputDir = argv[++i];
+		else if (strcmp(argv[i], "--telemetry") == 0)
+			writeTelemetry = true;
+		else if (argv[i][0] == '-')
+		{
+			usage();
+			return 2;
+		}
+		else
+			inputs.append(QString::fromLocal8Bit(argv[i]));
+	}
+	if (inputs.isEmpty() || (!Layout::LayoutEngine::getNames().contains(engine) && !engine.isEmpty()))
+	{
+		usage();
+		return 2;
+	}
+
+	int failed = 0;
+	for (int k = 0; k < inputs.count(); k++)
+	{
+		QFileInfo info(inputs[k]);
+		Manager::GraphMLImporter importer(inputs[k]);
+		if (!importer.isValid())
+		{
+			fprintf(stderr, "%s: subor nie je validny GraphML subor\n", qPrintable(inputs[k]));
+			failed++;
+			continue;
+		}
+
+		QTime timer;
+		timer.start();
+		// graf bez databazy, rovnako ako Manager::GraphManager::createGraph bez spojenia
+		Data::Graph *graph = new Data::Graph(1, importer.getGraphName(), 0, 0, NULL);
+		importer.import(graph);
+		int loadTime = timer.restart();
+		if (importer.getSkippedEdgeCount() > 0)
+			fprintf(stderr, "%s: preskocenych %d hran na neexistujuce uzly\n", qPrintable(inputs[k]), importer.getSkippedEdgeCount());
+
+		{
+			Layout::LayoutEngine *alg = Layout::LayoutEngine::create(Layout::LayoutEngine::resolve(engine, graph));
+			// buffer udrzi vsetky iteracie behu, bez limitu iteracii TELEMETRY_CAPACITY poslednych
+			alg->GetTelemetry().setCapacity(maxIterations > 0 ? maxIterations : TELEMETRY_CAPACITY);
+			alg->SetGraph(graph);
+			alg->SetParameters(SIZE_FACTOR, FLEXIBILITY, 1, true);
+			int iterations = alg->RunIterations(maxIterations, maxMilliseconds);
+			alg->ApplyPositions();
+
+			QString dir = outputDir.isEmpty() ? info.absolutePath() : outputDir;
+			QString output = QDir(dir).filePath(info.completeBaseName() + ".csv");
+			QString telemetryOutput = QDir(dir).filePath(info.completeBaseName() + ".telemetry.csv");
+			if (writeTelemetry && !alg->GetTelemetry().writeCsv(telemetryOutput))
+			{
+				fprintf(stderr, "%s: nepodarilo sa zapisat %s\n", qPrintable(inputs[k]), qPrintable(telemetryOutput));
+				failed++;
+			}
+			delete alg;
+			if (!writePositions(output, importer.getNodes()))
+			{
+				fprintf(stderr, "%s: nepodarilo sa zapisat %s\n", qPrintable(inputs[k]), qPrintable(output));
+				failed++;
+			}
+			else
+			{
+				printf("%s: %d uzlov, %d hran, nacitanie %d ms, %d iteracii za %d ms -> %s\n", qPrintable(inputs[k]),
+					graph->getNodeStore().size(), graph->getEdgeStore().size(), loadTime, iterations, timer.elapsed(), qPrintable(output));
+			}
+		}
+		delete graph;
+	}
+	return failed > 0 ? 1 : 0;
+}